@@ -0,0 +1,71 @@
+/**
+ * @File EpochBench.cpp
+ */
+
+#include <benchmark/benchmark.h>
+#include <Core/Threading/Epoch.hpp>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+using namespace xihe;
+
+namespace {
+std::atomic<int*> gShared{new int(0)};
+std::shared_mutex gSharedMutex;
+std::shared_ptr<int> gSharedPtr = std::make_shared<int>(0);
+} // namespace
+
+// 读者进入/离开临界区的开销
+static void BM_Read_EpochGuard(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        EpochGuard guard;
+        benchmark::DoNotOptimize(*gShared.load(std::memory_order_acquire));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_Read_EpochGuard)->ThreadRange(1, 8)->UseRealTime();
+
+// 对比：读写锁的读锁
+static void BM_Read_SharedMutex(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        std::shared_lock lock(gSharedMutex);
+        benchmark::DoNotOptimize(*gShared.load(std::memory_order_relaxed));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_Read_SharedMutex)->ThreadRange(1, 8)->UseRealTime();
+
+// 对比：原子加载 shared_ptr（引用计数在读者之间争用）
+static void BM_Read_AtomicSharedPtr(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        const auto ptr = std::atomic_load_explicit(&gSharedPtr, std::memory_order_acquire);
+        benchmark::DoNotOptimize(*ptr);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_Read_AtomicSharedPtr)->ThreadRange(1, 8)->UseRealTime();
+
+// 写者替换并退休旧对象，包含批量回收的摊销开销
+static void BM_Epoch_Retire(benchmark::State& state)
+{
+    for (auto _ : state)
+        Epoch::Retire(gShared.exchange(new int(1), std::memory_order_acq_rel));
+
+    Epoch::Drain();
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_Epoch_Retire);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,428 @@
+/**
+ * @File EventBusBench.cpp
+ */
+
+#include <benchmark/benchmark.h>
+#include <Core/Events/Event.hpp>
+#include <Core/Events/EventBus.hpp>
+#include <Core/Events/EventMetrics.hpp>
+#include <vector>
+#include <memory>
+#include <random>
+#include <thread>
+#include <atomic>
+
+using namespace xihe;
+
+// 用于混合批次的一组事件类型
+template <int N>
+class BenchEvent : public EventBase<BenchEvent<N>>
+{
+public:
+    explicit BenchEvent(int v = 0) :
+        value(v)
+    {
+    }
+
+    int value;
+};
+
+namespace {
+constexpr int kBenchEventTypes = 8;
+constexpr int kListenersPerType = 2;
+
+template <int N>
+void SubscribeBench(EventBus& bus, u64& sink)
+{
+    for (int i = 0; i < kListenersPerType; ++i)
+    {
+        bus.subscribe<BenchEvent<N>>([&sink](const BenchEvent<N>& event)
+        {
+            sink += As<u64>(event.value);
+        });
+    }
+}
+
+template <int N>
+EventPtr MakeBenchEvent(int index, int value)
+{
+    if constexpr (N + 1 < kBenchEventTypes)
+    {
+        if (index != N)
+            return MakeBenchEvent<N + 1>(index, value);
+    }
+    return std::make_shared<BenchEvent<N>>(value);
+}
+
+// 按运行时下标订阅一个空监听器
+template <int N = 0>
+Handle SubscribeOne(EventBus& bus, int index)
+{
+    if constexpr (N + 1 < kBenchEventTypes)
+    {
+        if (index != N)
+            return SubscribeOne<N + 1>(bus, index);
+    }
+    return bus.subscribe<BenchEvent<N>>([](const BenchEvent<N>&) {});
+}
+
+void SubscribeAll(EventBus& bus, u64& sink)
+{
+    [&]<int... Ns>(std::integer_sequence<int, Ns...>)
+    {
+        (SubscribeBench<Ns>(bus, sink), ...);
+    }(std::make_integer_sequence<int, kBenchEventTypes>{});
+}
+
+template <int N>
+void SubscribeBenchAsync(EventBus& bus, std::atomic<u64>& processed)
+{
+    for (int i = 0; i < kListenersPerType; ++i)
+    {
+        bus.subscribeAsync<BenchEvent<N>>([&processed](const BenchEvent<N>&)
+        {
+            processed.fetch_add(1, std::memory_order_relaxed);
+        });
+    }
+}
+
+void SubscribeAllAsync(EventBus& bus, std::atomic<u64>& processed)
+{
+    [&]<int... Ns>(std::integer_sequence<int, Ns...>)
+    {
+        (SubscribeBenchAsync<Ns>(bus, processed), ...);
+    }(std::make_integer_sequence<int, kBenchEventTypes>{});
+}
+
+// 类型随机交错的混合批次
+std::vector<EventPtr> MakeMixedBatch(Size count)
+{
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> typeDist(0, kBenchEventTypes - 1);
+
+    std::vector<EventPtr> events;
+    events.reserve(count);
+    for (Size i = 0; i < count; ++i)
+        events.push_back(MakeBenchEvent<0>(typeDist(rng), As<int>(i)));
+    return events;
+}
+} // namespace
+
+// 基准测试：逐个同步分发混合批次
+static void BM_MixedBatch_DispatchLoop(benchmark::State& state)
+{
+    EventBus bus(EventBus::Config{.queueWorkers = 0});
+    u64 sink = 0;
+    SubscribeAll(bus, sink);
+
+    const auto events = MakeMixedBatch(As<Size>(state.range(0)));
+    for (auto _ : state)
+    {
+        for (const auto& event : events)
+            bus.dispatch(event);
+        benchmark::DoNotOptimize(sink);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_MixedBatch_DispatchLoop)->Arg(10000);
+
+// 基准测试：按类型分组的批量分发
+static void BM_MixedBatch_ProcessBatch(benchmark::State& state)
+{
+    EventBus bus(EventBus::Config{.queueWorkers = 0});
+    u64 sink = 0;
+    SubscribeAll(bus, sink);
+
+    const auto events = MakeMixedBatch(As<Size>(state.range(0)));
+    for (auto _ : state)
+    {
+        bus.processBatch(events);
+        benchmark::DoNotOptimize(sink);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_MixedBatch_ProcessBatch)->Arg(10000);
+
+// 基准测试：事件时间戳的两种来源
+static void BM_Timestamp_SteadyClock(benchmark::State& state)
+{
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Clock::now());
+}
+
+BENCHMARK(BM_Timestamp_SteadyClock);
+
+static void BM_Timestamp_FastClock(benchmark::State& state)
+{
+    for (auto _ : state)
+        benchmark::DoNotOptimize(FastClock::now());
+    state.counters["tsc"] = FastClock::IsTscBased() ? 1 : 0;
+}
+
+BENCHMARK(BM_Timestamp_FastClock);
+
+// 基准测试：同步分发，单个事件类型上挂载 N 个监听器
+static void BM_Dispatch_Listeners(benchmark::State& state)
+{
+    EventBus bus(EventBus::Config{.queueWorkers = 0});
+    u64 sink = 0;
+    for (i64 i = 0; i < state.range(0); ++i)
+        bus.subscribe<BenchEvent<0>>([&sink](const BenchEvent<0>& event) { sink += As<u64>(event.value); });
+
+    const EventPtr event = std::make_shared<BenchEvent<0>>(1);
+    for (auto _ : state)
+    {
+        bus.dispatch(event);
+        benchmark::DoNotOptimize(sink);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["listeners"] = As<f64>(state.range(0));
+}
+
+BENCHMARK(BM_Dispatch_Listeners)->RangeMultiplier(10)->Range(1, 1000);
+
+// 基准测试：带谓词过滤器的订阅，一半监听器被过滤
+static void BM_Dispatch_PredicateFilter(benchmark::State& state)
+{
+    EventBus bus(EventBus::Config{.queueWorkers = 0});
+    u64 sink = 0;
+    for (i64 i = 0; i < state.range(0); ++i)
+    {
+        const auto required = i % 2 == 0 ? EventPriority::Normal : EventPriority::Critical;
+        bus.subscribe<BenchEvent<0>>([&sink](const BenchEvent<0>& event) { sink += As<u64>(event.value); },
+                                     filters::byPriority<BenchEvent<0>>(required));
+    }
+
+    const EventPtr event = std::make_shared<BenchEvent<0>>(1);
+    for (auto _ : state)
+    {
+        bus.dispatch(event);
+        benchmark::DoNotOptimize(sink);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_Dispatch_PredicateFilter)->Arg(16)->Arg(256);
+
+// 基准测试：相同过滤条件以声明式掩码表达，由总线预先过滤
+static void BM_Dispatch_MaskFilter(benchmark::State& state)
+{
+    EventBus bus(EventBus::Config{.queueWorkers = 0});
+    u64 sink = 0;
+    for (i64 i = 0; i < state.range(0); ++i)
+    {
+        const auto required = i % 2 == 0 ? EventPriority::Normal : EventPriority::Critical;
+        bus.subscribe<BenchEvent<0>>([&sink](const BenchEvent<0>& event) { sink += As<u64>(event.value); },
+                                     filters::minPriority(required));
+    }
+
+    auto event = std::make_shared<BenchEvent<0>>(1);
+    event->setPriority(EventPriority::Normal);
+    const EventPtr base = event;
+    for (auto _ : state)
+    {
+        bus.dispatch(base);
+        benchmark::DoNotOptimize(sink);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_Dispatch_MaskFilter)->Arg(16)->Arg(256);
+
+// 基准测试：N 个生产者线程并发入队，工作线程处理
+static void BM_Queued_Producers(benchmark::State& state)
+{
+    constexpr i64 kEventsPerProducer = 10000;
+    const auto producers             = state.range(0);
+
+    EventBus bus(EventBus::Config{.queueWorkers = 2});
+    std::atomic<u64> processed{0};
+    SubscribeAllAsync(bus, processed);
+
+    for (auto _ : state)
+    {
+        processed.store(0);
+        std::vector<std::thread> threads;
+        for (i64 p = 0; p < producers; ++p)
+        {
+            threads.emplace_back([&bus, p]
+            {
+                for (i64 i = 0; i < kEventsPerProducer; ++i)
+                    bus.enqueue(MakeBenchEvent<0>(As<int>((p + i) % kBenchEventTypes), As<int>(i)));
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+
+        const auto expected = As<u64>(producers * kEventsPerProducer * kListenersPerType);
+        while (processed.load(std::memory_order_relaxed) < expected)
+            std::this_thread::yield();
+    }
+    state.SetItemsProcessed(state.iterations() * producers * kEventsPerProducer);
+}
+
+BENCHMARK(BM_Queued_Producers)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// 基准测试：不同优先级混合入队后统一处理，参数为使用的优先级数量
+static void BM_Queued_PriorityMix(benchmark::State& state)
+{
+    constexpr Size kEvents = 10000;
+
+    EventBus bus(EventBus::Config{.queueWorkers = 0});
+    std::atomic<u64> processed{0};
+    SubscribeAllAsync(bus, processed);
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<u32> priorityDist(0, As<u32>(state.range(0) - 1));
+    std::vector<EventPriority> priorities(kEvents);
+    for (auto& priority : priorities)
+        priority = static_cast<EventPriority>(priorityDist(rng));
+
+    const auto events = MakeMixedBatch(kEvents);
+    for (auto _ : state)
+    {
+        for (Size i = 0; i < kEvents; ++i)
+            bus.enqueue(events[i], priorities[i]);
+        bus.processQueue();
+    }
+    benchmark::DoNotOptimize(processed.load());
+    state.SetItemsProcessed(state.iterations() * As<i64>(kEvents));
+}
+
+BENCHMARK(BM_Queued_PriorityMix)->Arg(1)->Arg(4);
+
+// 基准测试：后台线程不断订阅与取消订阅时的同步分发，参数为 0 时不做干扰作为对照
+static void BM_Dispatch_WithChurn(benchmark::State& state)
+{
+    EventBus bus(EventBus::Config{.queueWorkers = 0});
+    u64 sink = 0;
+    SubscribeAll(bus, sink);
+
+    std::atomic<bool> stop{false};
+    std::thread churn;
+    if (state.range(0) != 0)
+    {
+        churn = std::thread([&]
+        {
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                const auto handle = bus.subscribe<BenchEvent<1>>([](const BenchEvent<1>&) {});
+                bus.unsubscribe(handle);
+            }
+        });
+    }
+
+    const auto events = MakeMixedBatch(1000);
+    for (auto _ : state)
+    {
+        for (const auto& event : events)
+            bus.dispatch(event);
+        benchmark::DoNotOptimize(sink);
+    }
+
+    stop.store(true);
+    if (churn.joinable())
+        churn.join();
+    state.SetItemsProcessed(state.iterations() * As<i64>(events.size()));
+}
+
+BENCHMARK(BM_Dispatch_WithChurn)->Arg(0)->Arg(1)->UseRealTime();
+
+// 基准测试：入队到监听器执行的端到端延迟，以计数器输出百分位
+static void BM_Queued_Latency(benchmark::State& state)
+{
+    EventBus bus(EventBus::Config{.queueWorkers = 1});
+
+    LatencyHistogram histogram;
+    std::atomic<u64> handled{0};
+    bus.subscribeAsync<BenchEvent<0>>([&](const BenchEvent<0>& event)
+    {
+        const auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(FastClock::now() - event.getTimestamp());
+        histogram.record(As<u64>(latency.count()));
+        handled.fetch_add(1, std::memory_order_release);
+    });
+
+    u64 sent = 0;
+    for (auto _ : state)
+    {
+        bus.enqueue(std::make_shared<BenchEvent<0>>(0));
+        ++sent;
+
+        // 限制在途事件数，测量的是排队与唤醒延迟而不是积压
+        while (sent - handled.load(std::memory_order_acquire) > 16)
+            std::this_thread::yield();
+    }
+    while (handled.load(std::memory_order_acquire) < sent)
+        std::this_thread::yield();
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["p50_ns"] = As<f64>(histogram.percentileNs(0.50));
+    state.counters["p99_ns"] = As<f64>(histogram.percentileNs(0.99));
+    state.counters["max_ns"] = As<f64>(histogram.maxNs);
+}
+
+BENCHMARK(BM_Queued_Latency)->UseRealTime();
+
+// 基准测试：同步分发的端到端延迟
+static void BM_Dispatch_Latency(benchmark::State& state)
+{
+    EventBus bus(EventBus::Config{.queueWorkers = 0});
+
+    LatencyHistogram histogram;
+    bus.subscribe<BenchEvent<0>>([&](const BenchEvent<0>& event)
+    {
+        const auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(FastClock::now() - event.getTimestamp());
+        histogram.record(As<u64>(latency.count()));
+    });
+
+    for (auto _ : state)
+        bus.dispatch(std::make_shared<BenchEvent<0>>(0));
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["p50_ns"] = As<f64>(histogram.percentileNs(0.50));
+    state.counters["p99_ns"] = As<f64>(histogram.percentileNs(0.99));
+}
+
+BENCHMARK(BM_Dispatch_Latency);
+
+// 基准测试：16 个线程各自订阅、分发、入队不同的事件类型，参数为分片数
+static void BM_Sharded_Contention(benchmark::State& state)
+{
+    constexpr int kThreads = 16;
+    constexpr int kRounds  = 200;
+
+    EventBus bus(EventBus::Config{.queueWorkers = 0, .shardCount = As<Size>(state.range(0))});
+    std::atomic<u64> processed{0};
+    SubscribeAllAsync(bus, processed);
+
+    for (auto _ : state)
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; ++t)
+        {
+            threads.emplace_back([&bus, t]
+            {
+                const int type = t % kBenchEventTypes;
+                const auto event = MakeBenchEvent<0>(type, t);
+                for (int i = 0; i < kRounds; ++i)
+                {
+                    const auto handle = SubscribeOne(bus, type);
+                    bus.dispatch(event);
+                    bus.unsubscribe(handle);
+                    bus.enqueue(MakeBenchEvent<0>(type, i));
+                }
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+        bus.processQueue();
+    }
+    benchmark::DoNotOptimize(processed.load());
+    state.SetItemsProcessed(state.iterations() * kThreads * kRounds);
+}
+
+BENCHMARK(BM_Sharded_Contention)->Arg(1)->Arg(4)->Arg(16)->UseRealTime();
+
+BENCHMARK_MAIN();
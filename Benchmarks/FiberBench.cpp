@@ -0,0 +1,132 @@
+/**
+ * @File FiberBench.cpp
+ */
+
+#include <benchmark/benchmark.h>
+#include <Core/Threading/Fiber.hpp>
+#include <Core/Threading/JobSystem.hpp>
+#include <atomic>
+
+#ifdef XIHE_ON_LINUX
+#  include <ucontext.h>
+#endif
+
+using namespace xihe;
+
+namespace {
+struct PingPong
+{
+    Fiber* main  = nullptr;
+    Fiber* child = nullptr;
+};
+
+void PingPongEntry(void* arg)
+{
+    auto& state = *static_cast<PingPong*>(arg);
+    for (;;)
+        state.child->switchTo(*state.main);
+}
+} // namespace
+
+// 一次往返包含两次上下文切换
+static void BM_Fiber_SwitchRoundTrip(benchmark::State& state)
+{
+    if (!Fiber::IsSupported())
+    {
+        state.SkipWithError("当前平台不支持纤程");
+        return;
+    }
+
+    FiberStackPool pool;
+    PingPong pingPong;
+    Fiber main;
+    Fiber child(pool.acquire(), &PingPongEntry, &pingPong);
+    pingPong.main  = &main;
+    pingPong.child = &child;
+
+    for (auto _ : state)
+        main.switchTo(child);
+    state.SetItemsProcessed(state.iterations() * 2);
+
+    pool.release(child.getStack());
+}
+
+BENCHMARK(BM_Fiber_SwitchRoundTrip);
+
+#ifdef XIHE_ON_LINUX
+// 对比：swapcontext 每次切换都要系统调用保存信号掩码
+namespace {
+ucontext_t gMainContext;
+ucontext_t gChildContext;
+
+void UContextEntry()
+{
+    for (;;)
+        swapcontext(&gChildContext, &gMainContext);
+}
+} // namespace
+
+static void BM_UContext_SwitchRoundTrip(benchmark::State& state)
+{
+    FiberStackPool pool;
+    auto stack = pool.acquire();
+    getcontext(&gChildContext);
+    gChildContext.uc_stack.ss_sp   = stack.base;
+    gChildContext.uc_stack.ss_size = stack.size;
+    gChildContext.uc_link          = nullptr;
+    makecontext(&gChildContext, &UContextEntry, 0);
+
+    for (auto _ : state)
+        swapcontext(&gMainContext, &gChildContext);
+    state.SetItemsProcessed(state.iterations() * 2);
+
+    pool.release(stack);
+}
+
+BENCHMARK(BM_UContext_SwitchRoundTrip);
+#endif
+
+// 栈池命中时的借还开销
+static void BM_FiberStack_AcquireRelease(benchmark::State& state)
+{
+    FiberStackPool pool;
+    pool.release(pool.acquire());
+    for (auto _ : state)
+    {
+        auto stack = pool.acquire();
+        benchmark::DoNotOptimize(stack.base);
+        pool.release(stack);
+    }
+}
+
+BENCHMARK(BM_FiberStack_AcquireRelease);
+
+// 任务内提交子任务并等待：纤程挂起对比在等待中嵌套执行
+static void BM_Jobs_WaitInsideJob(benchmark::State& state)
+{
+    const bool useFibers = state.range(0) != 0;
+    JobSystem jobs(JobSystem::Config{.workerCount = 2, .useFibers = useFibers});
+    std::atomic<u64> sink{0};
+
+    for (auto _ : state)
+    {
+        JobCounter root;
+        for (int i = 0; i < 16; ++i)
+        {
+            jobs.run([&]
+            {
+                JobCounter children;
+                for (int j = 0; j < 16; ++j)
+                    jobs.run([&] { sink.fetch_add(1, std::memory_order_relaxed); }, &children);
+                jobs.wait(children);
+            }, &root);
+        }
+        jobs.wait(root);
+    }
+    state.SetItemsProcessed(state.iterations() * 16 * 17);
+    state.SetLabel(jobs.isUsingFibers() ? "fibers" : "nested");
+}
+
+BENCHMARK(BM_Jobs_WaitInsideJob)->Arg(0)->Arg(1)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,112 @@
+/**
+ * @File JobSystemBench.cpp
+ */
+
+#include <benchmark/benchmark.h>
+#include <Core/Threading/JobSystem.hpp>
+#include <Core/Threading/TaskGraph.hpp>
+#include <Core/Threading/WorkStealingDeque.hpp>
+#include <atomic>
+#include <vector>
+
+using namespace xihe;
+
+// 所有者线程 push/pop 的开销
+static void BM_Deque_PushPop(benchmark::State& state)
+{
+    WorkStealingDeque<int*> deque(1024);
+    int value = 0;
+    for (auto _ : state)
+    {
+        deque.push(&value);
+        benchmark::DoNotOptimize(deque.pop());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_Deque_PushPop);
+
+// 提交一批空任务并等待完成
+static void BM_Jobs_EmptyBatch(benchmark::State& state)
+{
+    JobSystem jobs(JobSystem::Config{.workerCount = static_cast<Size>(state.range(1))});
+    const auto batch = state.range(0);
+
+    for (auto _ : state)
+    {
+        JobCounter counter;
+        for (i64 i = 0; i < batch; ++i)
+            jobs.run([] {}, &counter);
+        jobs.wait(counter);
+    }
+    state.SetItemsProcessed(state.iterations() * batch);
+}
+
+BENCHMARK(BM_Jobs_EmptyBatch)->ArgsProduct({{64, 4096}, {0, 1, 3}})->UseRealTime();
+
+// 任务内递归拆分，子任务进入当前线程队列并被其他线程窃取
+static void SplitSum(JobSystem& jobs, const std::vector<u32>& data, Size begin, Size end, std::atomic<u64>& sum)
+{
+    if (end - begin <= 1024)
+    {
+        u64 local = 0;
+        for (Size i = begin; i < end; ++i)
+            local += data[i];
+        sum.fetch_add(local, std::memory_order_relaxed);
+        return;
+    }
+
+    const Size mid = begin + (end - begin) / 2;
+    JobCounter counter;
+    jobs.run([&, mid, end] { SplitSum(jobs, data, mid, end, sum); }, &counter);
+    SplitSum(jobs, data, begin, mid, sum);
+    jobs.wait(counter);
+}
+
+static void BM_Jobs_RecursiveSplit(benchmark::State& state)
+{
+    JobSystem jobs;
+    std::vector<u32> data(1 << 20, 1);
+
+    for (auto _ : state)
+    {
+        std::atomic<u64> sum{0};
+        SplitSum(jobs, data, 0, data.size(), sum);
+        benchmark::DoNotOptimize(sum.load());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<i64>(data.size()));
+}
+
+BENCHMARK(BM_Jobs_RecursiveSplit)->UseRealTime();
+
+// 编译后的任务图重复执行：分层图，每层节点依赖上一层的全部节点
+static void BM_TaskGraph_Layered(benchmark::State& state)
+{
+    JobSystem jobs;
+    TaskGraph graph;
+    const auto width = static_cast<int>(state.range(0));
+    std::atomic<u64> sink{0};
+
+    std::vector<TaskGraph::NodeId> previous;
+    for (int layer = 0; layer < 4; ++layer)
+    {
+        std::vector<TaskGraph::NodeId> current;
+        for (int i = 0; i < width; ++i)
+        {
+            const auto node = graph.addNode("Node", [&sink] { sink.fetch_add(1, std::memory_order_relaxed); });
+            for (const auto before : previous)
+                graph.addEdge(before, node);
+            current.push_back(node);
+        }
+        previous = std::move(current);
+    }
+    graph.compile();
+
+    for (auto _ : state)
+        graph.run(jobs);
+    state.SetItemsProcessed(state.iterations() * static_cast<i64>(graph.getNodeCount()));
+}
+
+BENCHMARK(BM_TaskGraph_Layered)->Arg(1)->Arg(8)->Arg(32)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,226 @@
+/**
+ * @File ParallelBench.cpp
+ */
+
+#include <benchmark/benchmark.h>
+#include <Core/Threading/Parallel.hpp>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#if __has_include(<execution>)
+#  include <execution>
+#endif
+
+// libstdc++ 的并行执行策略需要链接 TBB，见 CMakeLists.txt
+#if XIHE_COMPILER_MSVC || defined(XIHE_BENCH_HAS_TBB)
+#  define XIHE_BENCH_STD_PAR 1
+#else
+#  define XIHE_BENCH_STD_PAR 0
+#endif
+
+using namespace xihe;
+
+namespace {
+constexpr Size kElements = 1 << 22;
+
+JobSystem& BenchJobs()
+{
+    static JobSystem jobs;
+    return jobs;
+}
+
+std::vector<f32> RandomFloats(Size count)
+{
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<f32> dist(0.0f, 1.0f);
+    std::vector<f32> values(count);
+    for (auto& value : values)
+        value = dist(rng);
+    return values;
+}
+
+// 每个元素的计算量接近一次简单的变换更新
+f32 Transform(f32 value)
+{
+    return std::sqrt(value * value + 1.0f) * 0.5f;
+}
+} // namespace
+
+// ---------------- For ----------------
+
+static void BM_For_Serial(benchmark::State& state)
+{
+    auto values = RandomFloats(kElements);
+    for (auto _ : state)
+    {
+        for (auto& value : values)
+            value = Transform(value);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * kElements);
+}
+
+static void BM_For_Parallel(benchmark::State& state)
+{
+    auto values = RandomFloats(kElements);
+    for (auto _ : state)
+    {
+        ParallelFor(BenchJobs(), 0, values.size(), [&](Size i) { values[i] = Transform(values[i]); });
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * kElements);
+}
+
+BENCHMARK(BM_For_Serial)->UseRealTime();
+BENCHMARK(BM_For_Parallel)->UseRealTime();
+
+// ---------------- Reduce ----------------
+
+static void BM_Reduce_Serial(benchmark::State& state)
+{
+    const auto values = RandomFloats(kElements);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(std::accumulate(values.begin(), values.end(), 0.0f));
+    state.SetItemsProcessed(state.iterations() * kElements);
+}
+
+static void BM_Reduce_Parallel(benchmark::State& state)
+{
+    const auto values = RandomFloats(kElements);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ParallelReduce(BenchJobs(), 0, values.size(), 0.0f,
+                                                [&](Size first, Size last, f32 sum)
+                                                {
+                                                    for (Size i = first; i < last; ++i)
+                                                        sum += values[i];
+                                                    return sum;
+                                                },
+                                                std::plus<>{}));
+    }
+    state.SetItemsProcessed(state.iterations() * kElements);
+}
+
+BENCHMARK(BM_Reduce_Serial)->UseRealTime();
+BENCHMARK(BM_Reduce_Parallel)->UseRealTime();
+
+// ---------------- Scan ----------------
+
+static void BM_Scan_Serial(benchmark::State& state)
+{
+    const auto values = RandomFloats(kElements);
+    std::vector<f32> output(values.size());
+    for (auto _ : state)
+    {
+        std::inclusive_scan(values.begin(), values.end(), output.begin());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * kElements);
+}
+
+static void BM_Scan_Parallel(benchmark::State& state)
+{
+    const auto values = RandomFloats(kElements);
+    std::vector<f32> output(values.size());
+    for (auto _ : state)
+    {
+        ParallelScan<f32>(BenchJobs(), values, output);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * kElements);
+}
+
+BENCHMARK(BM_Scan_Serial)->UseRealTime();
+BENCHMARK(BM_Scan_Parallel)->UseRealTime();
+
+// ---------------- Sort ----------------
+
+static void BM_Sort_Serial(benchmark::State& state)
+{
+    const auto source = RandomFloats(kElements);
+    std::vector<f32> values;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        values = source;
+        state.ResumeTiming();
+        std::sort(values.begin(), values.end());
+    }
+    state.SetItemsProcessed(state.iterations() * kElements);
+}
+
+static void BM_Sort_Parallel(benchmark::State& state)
+{
+    const auto source = RandomFloats(kElements);
+    std::vector<f32> values;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        values = source;
+        state.ResumeTiming();
+        ParallelSort(BenchJobs(), values.begin(), values.end());
+    }
+    state.SetItemsProcessed(state.iterations() * kElements);
+}
+
+BENCHMARK(BM_Sort_Serial)->UseRealTime();
+BENCHMARK(BM_Sort_Parallel)->UseRealTime();
+
+// ---------------- std::execution::par ----------------
+
+#if XIHE_BENCH_STD_PAR
+static void BM_For_StdPar(benchmark::State& state)
+{
+    auto values = RandomFloats(kElements);
+    for (auto _ : state)
+    {
+        std::for_each(std::execution::par, values.begin(), values.end(), [](f32& value) { value = Transform(value); });
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * kElements);
+}
+
+static void BM_Reduce_StdPar(benchmark::State& state)
+{
+    const auto values = RandomFloats(kElements);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(std::reduce(std::execution::par, values.begin(), values.end(), 0.0f));
+    state.SetItemsProcessed(state.iterations() * kElements);
+}
+
+static void BM_Scan_StdPar(benchmark::State& state)
+{
+    const auto values = RandomFloats(kElements);
+    std::vector<f32> output(values.size());
+    for (auto _ : state)
+    {
+        std::inclusive_scan(std::execution::par, values.begin(), values.end(), output.begin());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * kElements);
+}
+
+static void BM_Sort_StdPar(benchmark::State& state)
+{
+    const auto source = RandomFloats(kElements);
+    std::vector<f32> values;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        values = source;
+        state.ResumeTiming();
+        std::sort(std::execution::par, values.begin(), values.end());
+    }
+    state.SetItemsProcessed(state.iterations() * kElements);
+}
+
+BENCHMARK(BM_For_StdPar)->UseRealTime();
+BENCHMARK(BM_Reduce_StdPar)->UseRealTime();
+BENCHMARK(BM_Scan_StdPar)->UseRealTime();
+BENCHMARK(BM_Sort_StdPar)->UseRealTime();
+#endif
+
+BENCHMARK_MAIN();
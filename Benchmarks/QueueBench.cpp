@@ -0,0 +1,165 @@
+/**
+ * @File QueueBench.cpp
+ */
+
+#include <benchmark/benchmark.h>
+#include <Core/Threading/MpmcQueue.hpp>
+#include <Core/Threading/SpscQueue.hpp>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <span>
+#include <thread>
+
+using namespace xihe;
+
+namespace {
+// 对比：有锁的标准容器
+template <typename T>
+class LockedQueue
+{
+public:
+    explicit LockedQueue(Size) {}
+
+    bool tryPush(T item)
+    {
+        std::lock_guard lock(_mutex);
+        _items.push_back(item);
+        return true;
+    }
+
+    bool tryPop(T& out)
+    {
+        std::lock_guard lock(_mutex);
+        if (_items.empty())
+            return false;
+        out = _items.front();
+        _items.pop_front();
+        return true;
+    }
+
+private:
+    std::mutex _mutex;
+    std::deque<T> _items;
+};
+
+constexpr Size kCapacity = 1024;
+
+template <typename Queue>
+void Push(Queue& queue, u64 value)
+{
+    while (!queue.tryPush(value))
+        std::this_thread::yield();
+}
+
+template <typename Queue>
+u64 Pop(Queue& queue)
+{
+    u64 value = 0;
+    while (!queue.tryPop(value))
+        std::this_thread::yield();
+    return value;
+}
+} // namespace
+
+// 吞吐：一半线程生产、一半线程消费，每次迭代一个元素
+template <typename Queue>
+static void BM_Queue_Throughput(benchmark::State& state)
+{
+    static Queue* queue = nullptr;
+    if (state.thread_index() == 0)
+        queue = new Queue(kCapacity);
+
+    const bool producer = state.thread_index() % 2 == 0;
+    for (auto _ : state)
+    {
+        if (producer)
+            Push(*queue, 1);
+        else
+            benchmark::DoNotOptimize(Pop(*queue));
+    }
+
+    if (state.thread_index() == 0)
+    {
+        delete queue;
+        queue = nullptr;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_Queue_Throughput, LockedQueue<u64>)->ThreadRange(2, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Queue_Throughput, MpmcQueue<u64>)->ThreadRange(2, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Queue_Throughput, SpscQueue<u64>)->Threads(2)->UseRealTime();
+
+// 批量吞吐：每次迭代批量传递 range(0) 个元素
+template <typename Queue>
+static void BM_Queue_BatchThroughput(benchmark::State& state)
+{
+    static Queue* queue = nullptr;
+    if (state.thread_index() == 0)
+        queue = new Queue(kCapacity);
+
+    const bool producer = state.thread_index() % 2 == 0;
+    const Size batch    = static_cast<Size>(state.range(0));
+    std::array<u64, 64> items{};
+    for (auto _ : state)
+    {
+        for (Size done = 0; done < batch;)
+        {
+            const std::span span(items.data() + done, batch - done);
+            const Size count = producer ? queue->tryPushBatch(span) : queue->tryPopBatch(span);
+            if (count == 0)
+                std::this_thread::yield();
+            done += count;
+        }
+    }
+
+    if (state.thread_index() == 0)
+    {
+        delete queue;
+        queue = nullptr;
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_Queue_BatchThroughput, MpmcQueue<u64>)->Arg(16)->Arg(64)->ThreadRange(2, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Queue_BatchThroughput, SpscQueue<u64>)->Arg(16)->Arg(64)->Threads(2)->UseRealTime();
+
+// 延迟：两个线程通过一对队列来回传递，单次往返
+template <typename Queue>
+static void BM_Queue_PingPong(benchmark::State& state)
+{
+    Queue ping(kCapacity);
+    Queue pong(kCapacity);
+    std::atomic<bool> stop{false};
+
+    std::thread echo([&]
+    {
+        u64 value = 0;
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            if (ping.tryPop(value))
+                Push(pong, value);
+            else
+                std::this_thread::yield();
+        }
+    });
+
+    u64 value = 0;
+    for (auto _ : state)
+    {
+        Push(ping, ++value);
+        benchmark::DoNotOptimize(Pop(pong));
+    }
+
+    stop = true;
+    echo.join();
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_Queue_PingPong, LockedQueue<u64>)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Queue_PingPong, MpmcQueue<u64>)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Queue_PingPong, SpscQueue<u64>)->UseRealTime();
+
+BENCHMARK_MAIN();
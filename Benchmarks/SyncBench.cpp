@@ -0,0 +1,138 @@
+/**
+ * @File SyncBench.cpp
+ */
+
+#include <benchmark/benchmark.h>
+#include <Core/Threading/Sync.hpp>
+#include <barrier>
+#include <mutex>
+#include <shared_mutex>
+
+using namespace xihe;
+
+namespace {
+// 临界区内的工作量：对共享缓存行做若干次读改写
+template <typename Lock>
+struct Shared
+{
+    Lock lock;
+    alignas(64) u64 value = 0;
+};
+
+template <typename Lock>
+Shared<Lock>& SharedState()
+{
+    static Shared<Lock> shared;
+    return shared;
+}
+
+struct Camera
+{
+    f64 position[3];
+    f64 forward[3];
+    f64 fov;
+};
+} // namespace
+
+// 不同线程数（竞争程度）与临界区长度下的加锁开销
+template <typename Lock>
+static void BM_Lock(benchmark::State& state)
+{
+    auto& shared     = SharedState<Lock>();
+    const auto works = state.range(0);
+    for (auto _ : state)
+    {
+        std::lock_guard guard(shared.lock);
+        for (i64 i = 0; i < works; ++i)
+            benchmark::DoNotOptimize(++shared.value);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+#define XIHE_LOCK_BENCHMARK(Lock) \
+    BENCHMARK_TEMPLATE(BM_Lock, Lock)->Arg(1)->Arg(64)->ThreadRange(1, 8)->UseRealTime()
+
+XIHE_LOCK_BENCHMARK(std::mutex);
+XIHE_LOCK_BENCHMARK(SpinLock);
+XIHE_LOCK_BENCHMARK(TicketLock);
+XIHE_LOCK_BENCHMARK(AdaptiveMutex);
+
+// 读多写少：线程 0 写入，其余线程读取
+static void BM_ReadMostly_SharedMutex(benchmark::State& state)
+{
+    static std::shared_mutex mutex;
+    static Camera camera{};
+    for (auto _ : state)
+    {
+        if (state.thread_index() == 0)
+        {
+            std::unique_lock lock(mutex);
+            camera.fov += 1.0;
+        }
+        else
+        {
+            std::shared_lock lock(mutex);
+            Camera copy = camera;
+            benchmark::DoNotOptimize(copy);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_ReadMostly_SharedMutex)->ThreadRange(2, 8)->UseRealTime();
+
+static void BM_ReadMostly_SeqLock(benchmark::State& state)
+{
+    static SeqLock<Camera> camera;
+    for (auto _ : state)
+    {
+        if (state.thread_index() == 0)
+        {
+            auto value = camera.load();
+            value.fov += 1.0;
+            camera.store(value);
+        }
+        else
+        {
+            benchmark::DoNotOptimize(camera.load());
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_ReadMostly_SeqLock)->ThreadRange(2, 8)->UseRealTime();
+
+// 每次迭代所有线程在屏障处同步一次
+static void BM_Barrier_Std(benchmark::State& state)
+{
+    static std::barrier<>* barrier = nullptr;
+    if (state.thread_index() == 0)
+        barrier = new std::barrier<>(state.threads());
+
+    for (auto _ : state)
+        barrier->arrive_and_wait();
+
+    if (state.thread_index() == 0)
+        delete barrier;
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_Barrier_Std)->ThreadRange(2, 8)->UseRealTime();
+
+static void BM_Barrier_Xihe(benchmark::State& state)
+{
+    static Barrier* barrier = nullptr;
+    if (state.thread_index() == 0)
+        barrier = new Barrier(static_cast<u32>(state.threads()));
+
+    for (auto _ : state)
+        barrier->arriveAndWait();
+
+    if (state.thread_index() == 0)
+        delete barrier;
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_Barrier_Xihe)->ThreadRange(2, 8)->UseRealTime();
+
+BENCHMARK_MAIN();
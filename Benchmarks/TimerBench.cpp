@@ -0,0 +1,117 @@
+/**
+ * @File TimerBench.cpp
+ */
+
+#include <benchmark/benchmark.h>
+#include <Core/Utils/Time/TimingWheel.hpp>
+#include <functional>
+#include <queue>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+using namespace xihe;
+
+namespace {
+// 对比：原 TimerQueue 的做法，小顶堆 + 惰性取消集合
+class HeapTimers
+{
+public:
+    u64 schedule(u64 tick)
+    {
+        const u64 id = ++_nextId;
+        _heap.push({tick, id});
+        return id;
+    }
+
+    bool cancel(u64 id) { return _cancelled.insert(id).second; }
+
+    template <typename Fn>
+    void advance(u64 tick, Fn&& fn)
+    {
+        while (!_heap.empty() && _heap.top().tick <= tick)
+        {
+            const auto item = _heap.top();
+            _heap.pop();
+            if (_cancelled.erase(item.id) == 0)
+                fn(item.id);
+        }
+    }
+
+private:
+    struct Item
+    {
+        u64 tick;
+        u64 id;
+
+        bool operator>(const Item& other) const { return tick > other.tick; }
+    };
+
+    std::priority_queue<Item, std::vector<Item>, std::greater<>> _heap;
+    std::unordered_set<u64> _cancelled;
+    u64 _nextId = 0;
+};
+
+std::vector<u64> MakeTicks(Size count)
+{
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<u64> dist(1, 30'000);
+    std::vector<u64> ticks(count);
+    for (auto& tick : ticks)
+        tick = dist(rng);
+    return ticks;
+}
+} // namespace
+
+// 典型超时场景：注册 range(0) 个定时器，取消其中 90%，再推进到全部到期
+static void BM_Timers_Wheel(benchmark::State& state)
+{
+    const auto ticks = MakeTicks(static_cast<Size>(state.range(0)));
+    std::vector<u64> ids(ticks.size());
+    for (auto _ : state)
+    {
+        TimingWheel<u64> wheel;
+        for (Size i = 0; i < ticks.size(); ++i)
+            ids[i] = wheel.schedule(ticks[i], i);
+        for (Size i = 0; i < ids.size(); ++i)
+            if (i % 10 != 0)
+                wheel.cancel(ids[i]);
+
+        Size fired = 0;
+        for (u64 tick = 0; tick <= 30'000; tick += 16)
+            wheel.advance(tick, [&](u64, u64&) -> std::optional<u64>
+            {
+                ++fired;
+                return std::nullopt;
+            });
+        benchmark::DoNotOptimize(fired);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_Timers_Wheel)->Arg(1'000)->Arg(50'000);
+
+static void BM_Timers_Heap(benchmark::State& state)
+{
+    const auto ticks = MakeTicks(static_cast<Size>(state.range(0)));
+    std::vector<u64> ids(ticks.size());
+    for (auto _ : state)
+    {
+        HeapTimers heap;
+        for (Size i = 0; i < ticks.size(); ++i)
+            ids[i] = heap.schedule(ticks[i]);
+        for (Size i = 0; i < ids.size(); ++i)
+            if (i % 10 != 0)
+                heap.cancel(ids[i]);
+
+        Size fired = 0;
+        for (u64 tick = 0; tick <= 30'000; tick += 16)
+            heap.advance(tick, [&](u64) { ++fired; });
+        benchmark::DoNotOptimize(fired);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_Timers_Heap)->Arg(1'000)->Arg(50'000);
+
+BENCHMARK_MAIN();
@@ -7,6 +7,8 @@
 #include "Application.hpp"
 
 #include "Core/Context.hpp"
+#include "Core/Events/EventBus.hpp"
+#include "Core/Threading/JobSystem.hpp"
 #include "Core/Utils/Logger.hpp"
 #include "Platform/Platform.hpp"
 #include "Renderer/Renderer.hpp"
@@ -47,6 +49,8 @@ bool Application::run()
         return false;
     }
 
+    auto& events    = Context::Get().events();
+    auto& jobs      = Context::Get().jobs();
     _running        = onInit();
     double lastTime = _platform->timeSeconds();
     while (_running.load(std::memory_order_relaxed))
@@ -54,8 +58,14 @@ bool Application::run()
         const double now = _platform->timeSeconds();
         const double dt  = now - lastTime;
         lastTime         = now;
+
+        // 上一帧投递的帧阶段事件在本帧统一处理
+        events.swapFrameBuffers();
+
         _renderer->beginFrame(dt);
         onTick();
+        if (!_tickGraph.empty())
+            _tickGraph.run(jobs);
         _renderer->render();
         _renderer->endFrame();
     }
@@ -12,6 +12,7 @@
 
 #include "Core/Base/Defines.hpp"
 #include "Core/Context.hpp"
+#include "Core/Threading/TaskGraph.hpp"
 #include "Core/Utils/Logger.hpp"
 #include "Core/Platform/Platform.hpp"
 #include "Renderer/Renderer.hpp"
@@ -49,6 +50,9 @@ protected:
     }
 
     std::atomic<bool> _running{false};
+
+    // 每帧在 onTick 之后由任务系统并行执行，子类可在 onInit 中添加节点
+    TaskGraph _tickGraph;
     std::unique_ptr<Platform> _platform;
     std::unique_ptr<Renderer> _renderer;
 };
@@ -10,11 +10,19 @@
 #include "Base/Error.hpp"
 #include "Utils/Logger.hpp"
 #include "Events/EventBus.hpp"
+#include "Platform/Events/PlatformEvents.hpp"
 #include "Memory/Memory.hpp"
 #include "Utils/ConfigManager.hpp"
+#include "Threading/JobSystem.hpp"
+#include "Threading/Threads.hpp"
 
 using namespace xihe;
 
+namespace {
+// 引擎总线的分片数，队列的优先级顺序只在同一分片内保证
+constexpr Size kEngineEventShards = 8;
+} // namespace
+
 Context::Context()
 {
 }
@@ -33,6 +41,11 @@ ConfigManager& Context::configManager()
     return *_configManager;
 }
 
+JobSystem& Context::jobs()
+{
+    return *_jobs;
+}
+
 bool Context::Create()
 {
     // Context 应该在程序启动的一开始调用，且整个生命周期应该只调用一次 
@@ -44,9 +57,17 @@ bool Context::Create()
 
     XIHE_ASSERT(sInstance);
 
+    // 日志中以名称区分主线程与各工作线程
+    SetCurrentThreadName("XiheMain");
     Logger::GetInstance().startup();
 
-    sInstance->_events = std::make_unique<EventBus>();
+    // 引擎范围的任务系统，创建线程（主线程）在等待任务时参与执行
+    sInstance->_jobs = std::make_unique<JobSystem>();
+
+    // 录制器只录制注册了序列化方式的事件，平台事件在总线创建前注册
+    RegisterPlatformEventCodecs();
+    // 引擎总线按事件类型分片，不相关子系统的订阅、分发与入队互不竞争
+    sInstance->_events = std::make_unique<EventBus>(EventBus::Config{.shardCount = kEngineEventShards});
 
     sInstance->_configManager = std::make_unique<ConfigManager>();
     sInstance->_configManager->loadFromFile();
@@ -62,6 +83,7 @@ void Context::Destroy()
     }
 
     XIHE_SAFE_RESET_PTR(sInstance->_events);
+    XIHE_SAFE_RESET_PTR(sInstance->_jobs);
 
     // 保存当前配置
     if (sInstance->_configManager != nullptr)
@@ -89,7 +111,7 @@ Context* Context::TryGet()
 
 bool Context::isFinalized() const
 {
-    if (sInstance->_events == nullptr)
+    if (sInstance->_jobs == nullptr || sInstance->_events == nullptr)
     {
         return false;
     }
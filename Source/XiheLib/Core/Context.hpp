@@ -15,6 +15,7 @@ namespace xihe {
 class Logger;
 class EventBus;
 class ConfigManager;
+class JobSystem;
 
 // Context 会提供一些通用服务对象，这些对象应该负责自身的多线程安全
 class XIHE_API Context
@@ -25,6 +26,7 @@ public:
 
     EventBus& events();
     ConfigManager& configManager();
+    JobSystem& jobs();
 
     // -----------------------------
     static bool Create();
@@ -39,6 +41,7 @@ private:
 private:
     inline static Context* sInstance = nullptr;
 
+    std::unique_ptr<JobSystem> _jobs;
     std::unique_ptr<EventBus> _events;
     std::unique_ptr<ConfigManager> _configManager;
 };
@@ -0,0 +1,57 @@
+/**
+ * @File Event.cpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/9/20
+ * @Brief This file is part of Xihe.
+ */
+
+#include "Event.hpp"
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+using namespace xihe;
+
+namespace {
+// 注册表只存在于 XiheLib 中，各模块按 type_index 查询同一份映射，因此得到的索引一致
+struct EventTypeRegistry
+{
+    std::mutex mutex;
+    std::unordered_map<std::type_index, EventTypeIndex> indices;
+    std::vector<std::type_index> types;
+
+    static EventTypeRegistry& Get()
+    {
+        static EventTypeRegistry registry;
+        return registry;
+    }
+};
+} // namespace
+
+EventTypeIndex xihe::RegisterEventType(std::type_index type)
+{
+    auto& registry = EventTypeRegistry::Get();
+
+    std::lock_guard lock(registry.mutex);
+    auto [it, inserted] = registry.indices.try_emplace(type, As<EventTypeIndex>(registry.types.size()));
+    if (inserted)
+        registry.types.push_back(type);
+    return it->second;
+}
+
+Size xihe::RegisteredEventTypeCount()
+{
+    auto& registry = EventTypeRegistry::Get();
+
+    std::lock_guard lock(registry.mutex);
+    return registry.types.size();
+}
+
+std::string xihe::EventTypeName(EventTypeIndex index)
+{
+    auto& registry = EventTypeRegistry::Get();
+
+    std::lock_guard lock(registry.mutex);
+    return index < registry.types.size() ? registry.types[index].name() : "Unknown Event";
+}
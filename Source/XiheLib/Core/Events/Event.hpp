@@ -8,6 +8,7 @@
 #pragma once
 
 #include <memory>
+#include <atomic>
 #include <typeindex>
 #include <string>
 #include <chrono>
@@ -18,6 +19,7 @@
 #include "Core/Base/Concepts.hpp"
 #include "Core/Utils/Enum.hpp"
 #include "Core/Utils/Time/Clock.hpp"
+#include "Core/Utils/Time/FastClock.hpp"
 #include "Core/Memory/Memory.hpp"
 
 namespace xihe {
@@ -42,6 +44,32 @@ enum class EventPriority : u32
     Critical = 3
 };
 
+// 队列中同类型待处理事件的合并策略
+enum class EventCoalesce : u8
+{
+    None       = 0, // 不合并，每个事件都会被单独处理
+    LatestWins = 1, // 新事件替换队列中尚未处理的同类型事件
+    Accumulate = 2, // 新事件的增量累加到队列中尚未处理的同类型事件上
+};
+
+// ======================================
+// 事件类型索引
+//
+// 每个事件类型在进程内对应一个从 0 开始的稠密索引，用于直接索引监听器表。
+// 索引由 XiheLib 中的注册表统一分配，跨动态库边界保持一致。
+
+using EventTypeIndex                            = u32;
+constexpr EventTypeIndex kInvalidEventTypeIndex = numeric_limits<EventTypeIndex>::max();
+
+// 为类型分配索引，已注册的类型返回原有索引
+XIHE_API EventTypeIndex RegisterEventType(std::type_index type);
+
+// 已注册的事件类型数量
+XIHE_API Size RegisteredEventTypeCount();
+
+// 事件类型名称（编译器提供的类型名），用于调试与统计输出
+XIHE_API std::string EventTypeName(EventTypeIndex index);
+
 // clang-format off
 // 事件接口类型
 class IEvent
@@ -52,6 +80,9 @@ public:
     // 获取事件类型ID
     XIHE_NODISCARD virtual std::type_index typeId() const = 0;
 
+    // 获取事件类型索引（EventBase 会缓存该值，这里的默认实现每次都查询注册表）
+    XIHE_NODISCARD virtual EventTypeIndex typeIndex() const { return RegisterEventType(typeId()); }
+
     // 获取事件优先级
     XIHE_NODISCARD virtual EventPriority getPriority() const { return EventPriority::Normal; }
 
@@ -62,7 +93,7 @@ public:
     XIHE_NODISCARD virtual EventCategory getCategory() const { return EventCategory::None; }
 
     // 获取时间戳
-    XIHE_NODISCARD virtual TimePoint getTimestamp() const { return Clock::now(); }
+    XIHE_NODISCARD virtual TimePoint getTimestamp() const { return FastClock::now(); }
 
     // 调试信息
     XIHE_NODISCARD virtual std::string toString() const { return "Unknown Event"; }
@@ -70,11 +101,20 @@ public:
     // 事件是否可以被取消
     XIHE_NODISCARD virtual bool isCancellable() const { return false; }
 
-    // 取消事件
+    // 取消事件，可以在任意线程调用（例如取消仍在队列中的事件）
     virtual void cancel() { }
 
     // 检查事件是否被取消
     XIHE_NODISCARD virtual bool isCancelled() const { return false; }
+
+    // 获取队列合并策略
+    XIHE_NODISCARD virtual EventCoalesce getCoalescePolicy() const { return EventCoalesce::None; }
+
+    // 较新的同类型事件能否与当前事件合并
+    XIHE_NODISCARD virtual bool canCoalesce(const IEvent& newer) const { return false; }
+
+    // 将较新事件的增量合并到当前事件（Accumulate 策略）
+    virtual void coalesceFrom(const IEvent& newer) { }
 };
 // clang-format on
 
@@ -97,14 +137,49 @@ constexpr std::type_index EventTypeId()
     return std::type_index(typeid(E));
 }
 
+// 事件类型索引，每个模块只在首次调用时查询一次注册表
+template <typename E>
+EventTypeIndex EventTypeIndexOf()
+{
+    static const EventTypeIndex index = RegisterEventType(std::type_index(typeid(E)));
+    return index;
+}
+
+// 事件类型可通过以下成员声明合并策略（只作用于队列分发）：
+//   static constexpr EventCoalesce kCoalescePolicy = EventCoalesce::Accumulate;
+//   bool canCoalesceWith(const Derived& newer) const; // 可选，例如只合并同一窗口的事件
+//   void merge(const Derived& newer);                 // Accumulate 策略必需
+template <typename E>
+concept cCoalescableEvent = requires
+{
+    { E::kCoalescePolicy } -> std::convertible_to<EventCoalesce>;
+};
+
 // clang-format off
 // 事件基础实现模板
 template <typename Derived>
 class EventBase : public IEvent
 {
 public:
+    EventBase() = default;
+
+    // 取消标记是原子量，需要手动复制
+    EventBase(const EventBase& other) :
+        _priority(other._priority), _category(other._category), _timestamp(other._timestamp), _cancelled(other.isCancelled()) { }
+
+    EventBase& operator=(const EventBase& other)
+    {
+        _priority  = other._priority;
+        _category  = other._category;
+        _timestamp = other._timestamp;
+        _cancelled.store(other.isCancelled(), std::memory_order_relaxed);
+        return *this;
+    }
+
     XIHE_NODISCARD std::type_index typeId() const override { return std::type_index(typeid(Derived)); }
 
+    XIHE_NODISCARD EventTypeIndex typeIndex() const override { return EventTypeIndexOf<Derived>(); }
+
     XIHE_NODISCARD std::string toString() const override { return typeid(Derived).name(); }
     
     XIHE_NODISCARD TimePoint getTimestamp() const override { return _timestamp; }
@@ -116,14 +191,46 @@ public:
     XIHE_NODISCARD EventCategory getCategory() const override { return _category; }
     
     XIHE_NODISCARD bool isCancellable() const override { return true; }
-    XIHE_NODISCARD bool isCancelled() const override { return _cancelled; }
-    void cancel() override { _cancelled = true; }
+    XIHE_NODISCARD bool isCancelled() const override { return _cancelled.load(std::memory_order_acquire); }
+    void cancel() override { _cancelled.store(true, std::memory_order_release); }
+
+    XIHE_NODISCARD EventCoalesce getCoalescePolicy() const override
+    {
+        if constexpr (cCoalescableEvent<Derived>)
+            return Derived::kCoalescePolicy;
+        else
+            return EventCoalesce::None;
+    }
+
+    XIHE_NODISCARD bool canCoalesce(const IEvent& newer) const override
+    {
+        if constexpr (!cCoalescableEvent<Derived>)
+            return false;
+        else if constexpr (requires(const Derived& a, const Derived& b) { { a.canCoalesceWith(b) } -> std::convertible_to<bool>; })
+            return static_cast<const Derived&>(*this).canCoalesceWith(static_cast<const Derived&>(newer));
+        else
+            return true;
+    }
+
+    void coalesceFrom(const IEvent& newer) override
+    {
+        if constexpr (requires(Derived& a, const Derived& b) { a.merge(b); })
+        {
+            static_cast<Derived&>(*this).merge(static_cast<const Derived&>(newer));
+            _timestamp = newer.getTimestamp();
+        }
+        else if constexpr (cCoalescableEvent<Derived>)
+        {
+            static_assert(Derived::kCoalescePolicy != EventCoalesce::Accumulate,
+                          "Accumulate 策略的事件需要提供 merge(const Derived&)");
+        }
+    }
 
 protected:
     EventPriority _priority{EventPriority::Normal};
     EventCategory _category{EventCategory::None};
-    TimePoint _timestamp{Clock::now()};
-    bool _cancelled{false};
+    TimePoint _timestamp{FastClock::now()};
+    std::atomic<bool> _cancelled{false};
 };
 // clang-format on
 
@@ -146,7 +253,8 @@ GenericEventCallback WrapCallback(EventCallback<E> inCallback)
 {
     return [callback = std::move(inCallback)](const EventPtr& baseEvent)
     {
-        if (auto specificEvent = std::dynamic_pointer_cast<const E>(baseEvent))
+        // 直接转换裸指针，避免每次回调都复制 shared_ptr 带来的引用计数开销
+        if (auto* specificEvent = dynamic_cast<const E*>(baseEvent.get()))
         {
             callback(*specificEvent);
         }
@@ -158,7 +266,7 @@ std::function<bool(const EventPtr&)> WrapFilter(EventFilter<E> inFilter)
 {
     return [filter = std::move(inFilter)](const EventPtr& baseEvent) -> bool
     {
-        if (auto specificEvent = std::dynamic_pointer_cast<const E>(baseEvent))
+        if (auto* specificEvent = dynamic_cast<const E*>(baseEvent.get()))
         {
             return filter(*specificEvent);
         }
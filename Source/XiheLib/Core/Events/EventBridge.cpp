@@ -0,0 +1,78 @@
+/**
+ * @File EventBridge.cpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/9/25
+ * @Brief This file is part of Xihe.
+ */
+
+#include "EventBridge.hpp"
+#include "Core/Threading/Epoch.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+using namespace xihe;
+
+class EventSharedMemoryBridge::Impl
+{
+public:
+    Impl(std::string_view name, Size capacity) :
+        ring(name, capacity)
+    {
+    }
+
+    SharedEventRingWriter ring;
+    std::mutex writeMutex;
+    std::vector<Handle> handles;
+    std::atomic<u64> publishedCount{0};
+};
+
+EventSharedMemoryBridge::EventSharedMemoryBridge(EventBus& bus, std::string_view name, Size capacity) :
+    _pImpl(std::make_unique<Impl>(name, capacity)), _bus(bus)
+{
+}
+
+EventSharedMemoryBridge::~EventSharedMemoryBridge()
+{
+    for (const auto handle : _pImpl->handles)
+        _bus.unsubscribe(handle);
+
+    // 取消订阅只是不再调用，其他线程上已经开始的回调可能仍在 publish 中；
+    // 监听器都在纪元临界区内调用，等待它们全部离开后再释放环形缓冲区
+    Epoch::Synchronize();
+}
+
+u64 EventSharedMemoryBridge::getPublishedCount() const
+{
+    return _pImpl->publishedCount.load();
+}
+
+u64 EventSharedMemoryBridge::getDroppedCount() const
+{
+    return _pImpl->ring.getDroppedCount();
+}
+
+u16 EventSharedMemoryBridge::registerType(std::string_view typeName)
+{
+    return _pImpl->ring.registerType(typeName);
+}
+
+void EventSharedMemoryBridge::addHandle(Handle handle)
+{
+    _pImpl->handles.push_back(handle);
+}
+
+void EventSharedMemoryBridge::publish(u16 type, const IEvent& event, EventCodecRegistry::EncodeFunc encode, bool queued)
+{
+    // 负载在锁外编码，锁内只复制到环形缓冲区
+    thread_local EventWriter tPayload;
+    tPayload.clear();
+    encode(event, tPayload);
+
+    const auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(event.getTimestamp().time_since_epoch());
+
+    std::lock_guard lock(_pImpl->writeMutex);
+    if (_pImpl->ring.write(type, event.getPriority(), queued, As<u64>(timestamp.count()), tPayload.data()))
+        _pImpl->publishedCount.fetch_add(1, std::memory_order_relaxed);
+}
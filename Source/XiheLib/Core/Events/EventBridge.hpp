@@ -0,0 +1,61 @@
+/**
+ * @File EventBridge.hpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/9/25
+ * @Brief This file is part of Xihe.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string_view>
+
+#include "Core/Events/EventBus.hpp"
+#include "Core/Events/SharedEventRing.hpp"
+
+namespace xihe {
+/**
+ * @brief 将 EventBus 上选定的事件类型镜像到共享内存环形缓冲区，供外部工具进程读取
+ *
+ *   EventSharedMemoryBridge bridge(bus, "xihe-events");
+ *   bridge.mirror<KeyboardEvent>("KeyboardEvent");
+ *
+ * 同步分发与队列处理的事件都会被镜像。环形缓冲区只允许单个写者，
+ * 来自不同线程的事件在写入前由桥内部的锁串行；缓冲区满时丢弃新事件。
+ * 析构时等待其他线程上正在执行的镜像回调结束，因此不能在总线的监听器内析构。
+ */
+class XIHE_API EventSharedMemoryBridge
+{
+public:
+    EventSharedMemoryBridge(EventBus& bus, std::string_view name, Size capacity = 4_MiB);
+    ~EventSharedMemoryBridge();
+
+    EventSharedMemoryBridge(const EventSharedMemoryBridge&)            = delete;
+    EventSharedMemoryBridge& operator=(const EventSharedMemoryBridge&) = delete;
+
+    template <cSerializableEvent E>
+    void mirror(std::string_view typeName)
+    {
+        const auto type = registerType(typeName);
+        constexpr EventCodecRegistry::EncodeFunc encode = [](const IEvent& event, EventWriter& writer)
+        {
+            static_cast<const E&>(event).serialize(writer);
+        };
+
+        addHandle(_bus.subscribe<E>([this, type](const E& event) { publish(type, event, encode, false); }));
+        addHandle(_bus.subscribeAsync<E>([this, type](const E& event) { publish(type, event, encode, true); }));
+    }
+
+    XIHE_NODISCARD u64 getPublishedCount() const;
+    XIHE_NODISCARD u64 getDroppedCount() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> _pImpl;
+    EventBus& _bus;
+
+    u16 registerType(std::string_view typeName);
+    void addHandle(Handle handle);
+    void publish(u16 type, const IEvent& event, EventCodecRegistry::EncodeFunc encode, bool queued);
+};
+} // namespace xihe
@@ -6,28 +6,23 @@
  */
 
 #include "EventBus.hpp"
+#include "Core/Threading/Epoch.hpp"
+#include "Core/Utils/Logger.hpp"
 
 #include <algorithm>
+#include <array>
+#include <deque>
+#include <limits>
 #include <unordered_map>
-#include <shared_mutex>
 #include <mutex>
+#include <condition_variable>
 #include <thread>
 #include <stop_token>
 #include <atomic>
-#include <queue>
-
-XIHE_PUSH_WARNING
-XIHE_CLANG_DISABLE_WARNING("-Wextra-semi-stmt")
-XIHE_CLANG_DISABLE_WARNING("-Wunused-parameter")
-XIHE_CLANG_DISABLE_WARNING("-Wshadow-field-in-constructor")
-XIHE_CLANG_DISABLE_WARNING("-Wzero-as-null-pointer-constant")
-#include <eventpp/utilities/argumentadapter.h>
-#include <eventpp/utilities/conditionalfunctor.h>
-#include <eventpp/utilities/orderedqueuelist.h>
-#include <eventpp/utilities/anydata.h>
-#include <eventpp/eventdispatcher.h>
-#include <eventpp/eventqueue.h>
-XIHE_POP_WARNING
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <utility>
 
 using namespace xihe;
 
@@ -35,235 +30,1450 @@ namespace {
 struct EventWrap
 {
     EventPtr event;
-    std::type_index id;
+    EventTypeIndex id;
     EventPriority priority;
-    TimePoint timestamp;
+    u64 sequence = 0;       // 分片内的入队序号，驱逐时据此比较入队先后；合并不改变原事件的序号
+    TimePoint enqueuedAt{}; // 仅在开启统计时记录
 
     EventWrap(EventPtr evt) :
         event(std::move(evt))
-      , id(event->typeId())
+      , id(event->typeIndex())
       , priority(event->getPriority())
-      , timestamp(event->getTimestamp())
     {
     }
+
+    // 用新事件替换待处理事件，保留原事件在队列中的位置
+    void replaceWith(EventWrap&& wrap)
+    {
+        const u64 position = sequence;
+        *this              = std::move(wrap);
+        sequence           = position;
+    }
+};
+
+// ======================================
+// 声明式过滤位掩码
+//
+// 低 32 位为事件分类，32~35 位为优先级，第 36 位表示不按分类过滤。
+// 事件的键总是带有第 36 位，因此分类测试对未设置分类过滤的监听器总是通过。
+
+constexpr Size kPriorityLevels = 4;
+
+constexpr u64 kCategoryBits   = 0xFFFF'FFFFull;
+constexpr u64 kPriorityShift  = 32;
+constexpr u64 kPriorityBits   = 0xFull << kPriorityShift;
+constexpr u64 kAnyCategoryBit = 1ull << 36;
+constexpr u64 kAcceptAll      = kPriorityBits | kAnyCategoryBit;
+
+constexpr Size PriorityLevel(EventPriority priority)
+{
+    return std::min<Size>(EnumValue(priority), kPriorityLevels - 1);
+}
+
+constexpr u64 AcceptBits(const EventMask& mask)
+{
+    u64 bits = mask.categories == EventCategory::None ? kAnyCategoryBit : EnumValue(mask.categories);
+    for (Size level = PriorityLevel(mask.minPriority); level < kPriorityLevels; ++level)
+        bits |= 1ull << (kPriorityShift + level);
+    return bits;
+}
+
+constexpr u64 EventKeyBits(EventCategory category, EventPriority priority)
+{
+    return EnumValue(category) | kAnyCategoryBit | 1ull << (kPriorityShift + PriorityLevel(priority));
+}
+
+constexpr bool Accepts(u64 accept, u64 key)
+{
+    const u64 common = accept & key;
+    return (common & kPriorityBits) != 0 && (common & (kCategoryBits | kAnyCategoryBit)) != 0;
+}
+
+// ======================================
+// 监听器快照
+
+struct ListenerNode
+{
+    Handle handle;
+    GenericEventCallback callback;
+    u64 accept                = kAcceptAll;
+    std::atomic<bool> active{true}; // 取消订阅后立即失效，已取得旧快照的分发线程也不会再调用
+};
+
+struct ListenerList
+{
+    std::vector<ListenerNode*> nodes;
+    // 与 nodes 一一对应的过滤位掩码，连续存放，不匹配的监听器无需访问节点即可跳过
+    std::vector<u64> accepts;
+    bool filtered = false;
+
+    void rebuildMasks()
+    {
+        accepts.resize(nodes.size());
+        filtered = false;
+        for (Size i = 0; i < nodes.size(); ++i)
+        {
+            accepts[i] = nodes[i]->accept;
+            filtered   = filtered || accepts[i] != kAcceptAll;
+        }
+    }
+};
+
+// 不可变的监听器表，只能整体替换。以事件类型索引直接寻址，没有监听器的类型为空指针
+struct ListenerTable
+{
+    std::vector<const ListenerList*> lists;
+
+    const ListenerList* find(EventTypeIndex id) const
+    {
+        return id < lists.size() ? lists[id] : nullptr;
+    }
+};
+
+constexpr u32 kNoGroup = numeric_limits<u32>::max();
+
+struct ListenerSlot
+{
+    std::atomic<const ListenerTable*> table{new ListenerTable()};
+
+    ~ListenerSlot()
+    {
+        auto* current = table.load(std::memory_order_relaxed);
+        for (const auto* list : current->lists)
+        {
+            if (!list)
+                continue;
+            for (auto* node : list->nodes)
+                delete node;
+            delete list;
+        }
+        delete current;
+    }
+
+    // 对事件的每个有效监听器执行 invoke(node)
+    template <typename F>
+    void forEachListener(const EventWrap& wrap, F&& invoke) const
+    {
+        const auto* list = table.load(std::memory_order_acquire)->find(wrap.id);
+        if (!list)
+            return;
+
+        if (!list->filtered)
+        {
+            for (auto* node : list->nodes)
+            {
+                if (node->active.load(std::memory_order_acquire))
+                    invoke(node);
+            }
+            return;
+        }
+
+        const auto key = EventKeyBits(wrap.event->getCategory(), wrap.priority);
+        for (Size i = 0; i < list->nodes.size(); ++i)
+        {
+            if (!Accepts(list->accepts[i], key))
+                continue;
+
+            auto* node = list->nodes[i];
+            if (node->active.load(std::memory_order_acquire))
+                invoke(node);
+        }
+    }
+
+    void call(const EventWrap& wrap) const
+    {
+        forEachListener(wrap, [&wrap](ListenerNode* node) { node->callback(wrap.event); });
+    }
+};
+
+// 批量分发：按类型分组后，每个监听器在同类型的全部事件上连续执行，返回有效事件数。
+// findList(id) 返回类型对应的监听器列表，每种类型在批次中只查找一次，不同类型可以来自不同分片的快照
+template <typename F>
+Size CallBatch(const std::vector<EventPtr>& events, F&& findList)
+{
+    // 类型索引是稠密的，用平坦数组记录类型到分组的映射；kUnresolved 表示尚未查找
+    constexpr u32 kUnresolved = kNoGroup - 1;
+    std::vector<const ListenerList*> groups;
+    std::vector<u32> groupOfType;
+    std::vector<u32> groupOf(events.size(), kNoGroup);
+
+    Size count = 0;
+    for (Size i = 0; i < events.size(); ++i)
+    {
+        const auto& event = events[i];
+        if (!event || event->isCancelled())
+            continue;
+
+        ++count;
+        const auto id = event->typeIndex();
+        if (groupOfType.size() <= id)
+            groupOfType.resize(id + 1, kUnresolved);
+
+        auto& group = groupOfType[id];
+        if (group == kUnresolved)
+        {
+            group = kNoGroup;
+            if (const auto* list = findList(id))
+            {
+                group = As<u32>(groups.size());
+                groups.push_back(list);
+            }
+        }
+        groupOf[i] = group;
+    }
+
+    // 计数排序：同一分组内保持输入顺序
+    std::vector<u32> offsets(groups.size() + 1, 0);
+    for (auto group : groupOf)
+    {
+        if (group != kNoGroup)
+            ++offsets[group + 1];
+    }
+    for (Size g = 0; g < groups.size(); ++g)
+        offsets[g + 1] += offsets[g];
+
+    std::vector<const EventPtr*> ordered(offsets.back());
+    {
+        auto cursor = offsets;
+        for (Size i = 0; i < events.size(); ++i)
+        {
+            if (groupOf[i] != kNoGroup)
+                ordered[cursor[groupOf[i]]++] = &events[i];
+        }
+    }
+
+    std::vector<u64> keys;
+    for (Size g = 0; g < groups.size(); ++g)
+    {
+        const auto* list = groups[g];
+        const auto first = offsets[g];
+        const auto last  = offsets[g + 1];
+
+        // 存在过滤条件时，每个事件的键只计算一次
+        if (list->filtered)
+        {
+            keys.resize(ordered.size());
+            for (auto i = first; i < last; ++i)
+                keys[i] = EventKeyBits((*ordered[i])->getCategory(), (*ordered[i])->getPriority());
+        }
+
+        for (Size n = 0; n < list->nodes.size(); ++n)
+        {
+            auto* node        = list->nodes[n];
+            const auto accept = list->accepts[n];
+            for (auto i = first; i < last; ++i)
+            {
+                if (list->filtered && !Accepts(accept, keys[i]))
+                    continue;
+
+                if (node->active.load(std::memory_order_acquire))
+                    node->callback(*ordered[i]);
+            }
+        }
+    }
+    return count;
+}
+
+// ======================================
+// 统计
+//
+// 每个线程写入自己的缓冲区，锁只在读取快照时才会发生竞争。
+
+struct MetricsBuffer
+{
+    struct TypeData
+    {
+        u64 dispatchCount = 0;
+        u64 queuedCount   = 0;
+        LatencyHistogram queueWait;
+        LatencyHistogram handlerTime;
+    };
+
+    struct ListenerData
+    {
+        EventTypeIndex typeIndex = kInvalidEventTypeIndex;
+        LatencyHistogram executionTime;
+    };
+
+    std::mutex mutex;
+    std::vector<TypeData> types;
+    std::unordered_map<Handle, ListenerData> listeners;
+
+    TypeData& type(EventTypeIndex index)
+    {
+        if (types.size() <= index)
+            types.resize(index + 1);
+        return types[index];
+    }
+};
+
+// FastClock 校准时可能有极小的回退，负值按 0 计
+u64 ElapsedNs(TimePoint start, TimePoint end)
+{
+    return As<u64>(std::max<i64>(0, std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+}
+
+std::atomic<u64> gNextBusId{1};
+
+// 线程私有缓冲区的登记表，由总线持有。每个线程至多占用一个缓冲区，
+// 线程退出时归还到空闲列表，后来的线程复用其中的数据，缓冲区总数不超过同时使用总线的线程数
+template <typename T>
+struct LocalBufferPool
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<T>> buffers; // 包括空闲的缓冲区，遍历时需持有 mutex
+    std::unordered_map<std::thread::id, T*> owned;
+    std::vector<T*> idle;
+
+    // 返回当前线程的缓冲区，second 表示是否为本次新分配
+    std::pair<T*, bool> acquire()
+    {
+        std::lock_guard lock(mutex);
+        auto [it, inserted] = owned.try_emplace(std::this_thread::get_id(), nullptr);
+        if (inserted)
+        {
+            if (idle.empty())
+            {
+                it->second = buffers.emplace_back(std::make_unique<T>()).get();
+            }
+            else
+            {
+                it->second = idle.back();
+                idle.pop_back();
+            }
+        }
+        return {it->second, inserted};
+    }
+
+    void release(std::thread::id thread)
+    {
+        std::lock_guard lock(mutex);
+        if (auto it = owned.find(thread); it != owned.end())
+        {
+            idle.push_back(it->second);
+            owned.erase(it);
+        }
+    }
+};
+
+// 线程退出时把缓冲区归还给仍然存活的总线
+template <typename T>
+struct LocalBufferOwner
+{
+    std::vector<std::weak_ptr<LocalBufferPool<T>>> pools;
+
+    void add(const std::shared_ptr<LocalBufferPool<T>>& pool)
+    {
+        std::erase_if(pools, [](const auto& weak) { return weak.expired(); });
+        pools.push_back(pool);
+    }
+
+    ~LocalBufferOwner()
+    {
+        const auto thread = std::this_thread::get_id();
+        for (const auto& weak : pools)
+        {
+            if (auto pool = weak.lock())
+                pool->release(thread);
+        }
+    }
+};
+
+// 线程通过 busId 在本地缓存中找到自己的缓冲区，缓存未命中时按线程 id 在登记表中查找
+template <typename T>
+T& LocalBuffer(u64 busId, const std::shared_ptr<LocalBufferPool<T>>& pool)
+{
+    struct CacheEntry
+    {
+        u64 busId;
+        T* buffer;
+    };
+
+    constexpr Size kCacheSize = 8;
+    thread_local std::vector<CacheEntry> tCache;
+    thread_local LocalBufferOwner<T> tOwner;
+
+    for (const auto& entry : tCache)
+    {
+        if (entry.busId == busId)
+            return *entry.buffer;
+    }
+
+    const auto [buffer, acquired] = pool->acquire();
+    if (acquired)
+        tOwner.add(pool);
+
+    if (tCache.size() >= kCacheSize)
+        tCache.erase(tCache.begin());
+    tCache.push_back({busId, buffer});
+    return *buffer;
+}
+
+// 帧阶段通道中单个生产线程的后台缓冲区，锁只在交换时才会发生竞争
+struct FrameBuffer
+{
+    std::mutex mutex;
+    std::vector<EventPtr> events;
+};
+
+// ======================================
+// 队列
+
+// 单个 lane 每次最多连续处理的事件数，避免热点类型长期占用工作线程
+constexpr Size kLaneBatchSize = 64;
+
+// 线程池模式下 lane 数量为工作线程数的倍数，降低不同 orderKey 哈希到同一 lane 的概率
+constexpr Size kLanesPerWorker = 4;
+
+u64 MixKey(u64 key)
+{
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return key;
+}
+
+/**
+ * 队列分发的串行单元。
+ * - 同一 lane 内的事件按优先级、同优先级按入队顺序处理；
+ * - processMutex 保证同一时刻只有一个线程在执行该 lane 的事件，从而保证同类型事件的顺序。
+ */
+struct QueueLane
+{
+    std::mutex mutex;
+    std::mutex processMutex;
+    std::array<std::deque<EventWrap>, kPriorityLevels> pending;
+    // 可合并类型最近一个尚未处理的事件（deque 两端增删不会使其余元素的引用失效）
+    std::unordered_map<EventTypeIndex, EventWrap*> coalescing;
+    bool scheduled = false;
+
+    bool empty() const
+    {
+        return std::ranges::all_of(pending, [](const auto& q) { return q.empty(); });
+    }
+
+    EventWrap takeFront(Size level)
+    {
+        auto& q = pending[level];
+        if (!coalescing.empty())
+        {
+            auto it = coalescing.find(q.front().id);
+            if (it != coalescing.end() && it->second == &q.front())
+                coalescing.erase(it);
+        }
+
+        EventWrap wrap{std::move(q.front())};
+        q.pop_front();
+        return wrap;
+    }
+
+    std::optional<EventWrap> pop()
+    {
+        for (Size level = kPriorityLevels; level-- > 0;)
+        {
+            if (!pending[level].empty())
+                return takeFront(level);
+        }
+        return std::nullopt;
+    }
+
+    // 尝试将新事件合并到同类型的待处理事件中，成功时返回 true
+    bool tryCoalesce(EventWrap& wrap, EventCoalesce policy)
+    {
+        auto it = coalescing.find(wrap.id);
+        if (it == coalescing.end())
+            return false;
+
+        auto& target = *it->second;
+        if (target.priority != wrap.priority)
+            return false;
+
+        if (target.event->isCancelled())
+        {
+            target.replaceWith(std::move(wrap));
+            return true;
+        }
+
+        if (!target.event->canCoalesce(*wrap.event))
+            return false;
+
+        if (policy == EventCoalesce::LatestWins)
+            target.replaceWith(std::move(wrap));
+        else
+            target.event->coalesceFrom(*wrap.event);
+        return true;
+    }
+
+    // 队列已满时（Coalesce 策略）与同优先级中最近的可合并同类型事件合并。
+    // 未声明合并策略的类型不合并，返回 false 由调用者计为丢弃
+    bool mergeIntoPending(EventWrap& wrap, Size level)
+    {
+        const auto policy = wrap.event->getCoalescePolicy();
+        if (policy == EventCoalesce::None)
+            return false;
+
+        auto& queue = pending[level];
+        for (auto it = queue.rbegin(); it != queue.rend(); ++it)
+        {
+            auto& target = *it;
+            if (target.id != wrap.id)
+                continue;
+
+            if (target.event->isCancelled())
+            {
+                target.replaceWith(std::move(wrap));
+                return true;
+            }
+
+            if (!target.event->canCoalesce(*wrap.event))
+                continue;
+
+            if (policy == EventCoalesce::Accumulate)
+                target.event->coalesceFrom(*wrap.event);
+            else
+                target.replaceWith(std::move(wrap));
+            return true;
+        }
+        return false;
+    }
+
+    Size clear()
+    {
+        Size count = 0;
+        for (auto& q : pending)
+        {
+            count += q.size();
+            q.clear();
+        }
+        coalescing.clear();
+        return count;
+    }
+};
+// 当前线程是否正在处理队列事件（处理器内再次入队时不能阻塞）
+thread_local bool tDrainingQueue = false;
+
+struct DrainingScope
+{
+    bool previous = std::exchange(tDrainingQueue, true);
+
+    ~DrainingScope()
+    {
+        tDrainingQueue = previous;
+    }
+};
+
+// ======================================
+// 分片
+//
+// 事件类型按类型索引（队列中指定 orderKey 时按其哈希）分配到分片，每个分片拥有独立的监听器表、写锁、队列 lane 与计数，
+// 不相关的子系统在订阅、入队与处理时互不竞争。
+
+struct HandleRecord
+{
+    EventTypeIndex eventType;
+    ListenerNode* node;
+    bool queued;
+};
+
+struct alignas(64) EventShard
+{
+    // 监听器表：分发侧无锁读取，写者之间由 writeMutex 串行
+    ListenerSlot directListeners;
+    ListenerSlot queuedListeners;
+
+    std::mutex writeMutex;
+    std::unordered_map<Handle, HandleRecord> handleRecord;
+    RetireList retired;
+
+    // 队列：分片内再按键哈希到 lane，就绪的 lane 放入 readyQueue 对应的就绪队列，由该组的工作线程领取
+    Size workerCount = 0;
+    Size readyQueue  = 0;
+    std::vector<QueueLane> lanes;
+
+    // 本分片的容量份额：pendingCount 统计分片内待处理的事件数，capacity 为 0 时不限制
+    Size capacity = 0;
+    std::atomic<Size> pendingCount{0};
+    std::atomic<u32> blockedProducers{0};
+    std::atomic<u64> nextSequence{0};
+
+    std::atomic<u64> dispatchedCount{0};
+    std::atomic<u64> queuedCount{0};
+    std::atomic<u64> coalescedCount{0};
+    std::atomic<u64> droppedNewestCount{0};
+    std::atomic<u64> evictedCount{0};
+};
+
+// 一组工作线程共用的就绪队列。分片多于工作线程时一个组服务多个分片，反之多个工作线程服务一个分片
+struct alignas(64) ReadyQueue
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::pair<Size, Size>> lanes; // (分片下标, lane 下标)
 };
+} // namespace
+
+class EventBus::Impl
+{
+public:
+    explicit Impl(const Config& config) :
+        metricsEnabled(config.enableMetrics)
+      , dumpInterval(config.metricsDumpInterval)
+      , dumpCallback(config.metricsDumpCallback)
+      , workerCount(config.queueWorkers)
+      , shards(std::max<Size>(1, config.shardCount))
+      , readyQueues(std::min(shards.size(), workerCount))
+      , overflowPolicy(config.overflowPolicy)
+      , threadOptions(config.workerThreads)
+    {
+        // 分片 i 与工作线程 i 都属于就绪队列 i % readyQueues.size()；容量平均分配到各分片
+        const Size count  = shards.size();
+        const Size groups = readyQueues.size();
+        for (Size i = 0; i < count; ++i)
+        {
+            auto& shard = shards[i];
+            if (groups > 0)
+            {
+                shard.readyQueue  = i % groups;
+                shard.workerCount = workerCount / groups + (shard.readyQueue < workerCount % groups ? 1 : 0);
+            }
+            shard.lanes    = std::vector<QueueLane>(shard.workerCount <= 1 ? 1 : shard.workerCount * kLanesPerWorker);
+            shard.capacity = config.queueCapacity == 0 ? 0 : std::max<Size>(1, (config.queueCapacity + count - 1) / count);
+        }
+    }
+
+    Size workerCount;
+    std::vector<EventShard> shards;
+    std::vector<ReadyQueue> readyQueues;
+    OverflowPolicy overflowPolicy;
+
+    // 统计：各线程的缓冲区由总线持有，线程通过 busId 找到自己的缓冲区
+    const u64 busId = gNextBusId.fetch_add(1);
+    std::atomic<bool> metricsEnabled;
+    std::atomic<IEventObserver*> observer{nullptr};
+    std::mutex observerMutex;
+
+    // 协程等待表：按事件类型索引的链表，waiterCount 为 0 时分发不加锁
+    struct WaiterList
+    {
+        EventWaiter* head = nullptr;
+        EventWaiter* tail = nullptr;
+    };
+
+    std::mutex waiterMutex;
+    std::vector<WaiterList> waiters;
+    std::atomic<Size> waiterCount{0};
+
+    // 帧阶段通道：生产者写入各自线程的后台缓冲区，交换时整体移入前台
+    std::mutex frameMutex;
+    const std::shared_ptr<LocalBufferPool<FrameBuffer>> frameBuffers = std::make_shared<LocalBufferPool<FrameBuffer>>();
+    std::vector<std::vector<EventPtr>> frameStaging;
+    FrameEvents frameEvents;
+    const std::shared_ptr<LocalBufferPool<MetricsBuffer>> metricsBuffers = std::make_shared<LocalBufferPool<MetricsBuffer>>();
+
+    Duration dumpInterval;
+    std::function<void(const EventMetricsSnapshot&)> dumpCallback;
+    std::mutex dumpMutex;
+    std::condition_variable dumpCv;
+    bool dumpStop = false;
+    std::thread dumpThread;
+
+    std::atomic<Handle> nextHandle{1};
+    std::vector<std::jthread> queueWorkers;
+    ThreadOptions threadOptions;
+    std::stop_source stopSource;
+
+    // 路由键：事件类型索引是稠密的，直接取模即可均匀分布；调用者提供的 orderKey 由 RouteKey 先行混合
+    Size shardIndex(u64 key) const
+    {
+        return shards.size() == 1 ? 0 : As<Size>(key % shards.size());
+    }
+
+    EventShard& shardOf(u64 key)
+    {
+        return shards[shardIndex(key)];
+    }
+
+    // 分片内的 lane 使用路由键除去分片下标后的部分，避免与分片选择相关
+    Size laneOf(const EventShard& shard, u64 key) const
+    {
+        return shard.lanes.size() == 1 ? 0 : As<Size>(key / shards.size() % shard.lanes.size());
+    }
+
+    template <typename T>
+    T sum(std::atomic<T> EventShard::* counter) const
+    {
+        T total{};
+        for (const auto& shard : shards)
+            total += (shard.*counter).load(std::memory_order_relaxed);
+        return total;
+    }
+
+    // 复制被修改类型的列表与表头，发布新快照并回收旧快照（需持有分片的 writeMutex）
+    template <typename F>
+    void updateList(EventShard& shard, ListenerSlot& slot, EventTypeIndex eventType, F&& modify)
+    {
+        const auto* oldTable = slot.table.load(std::memory_order_relaxed);
+        const auto* oldList  = oldTable->find(eventType);
+
+        auto* newList = new ListenerList();
+        if (oldList)
+            newList->nodes = oldList->nodes;
+        modify(newList->nodes);
+        newList->rebuildMasks();
+
+        auto* newTable = new ListenerTable(*oldTable);
+        if (newTable->lists.size() <= eventType)
+            newTable->lists.resize(eventType + 1, nullptr);
+
+        if (newList->nodes.empty())
+        {
+            newTable->lists[eventType] = nullptr;
+            delete newList;
+        }
+        else
+        {
+            newTable->lists[eventType] = newList;
+        }
+
+        // 必须先发布新快照再退休旧快照：退休时记录的纪元晚于发布，之后进入的读者只会看到新快照
+        slot.table.store(newTable, std::memory_order_release);
+        shard.retired.retire(oldList);
+        shard.retired.retire(oldTable);
+    }
+
+    // 句柄的低位编码所在分片：handle = 序号 * 分片数 + 分片下标
+    Handle addListener(bool queued, EventTypeIndex eventType, GenericEventCallback callback, const EventMask& mask)
+    {
+        const auto index = shardIndex(eventType);
+        auto& shard      = shards[index];
+        auto handle      = nextHandle.fetch_add(1) * shards.size() + index;
+        auto* node       = new ListenerNode{handle, std::move(callback), AcceptBits(mask)};
+
+        std::lock_guard lock(shard.writeMutex);
+        updateList(shard, queued ? shard.queuedListeners : shard.directListeners, eventType,
+                   [node](auto& nodes) { nodes.push_back(node); });
+        shard.handleRecord.emplace(handle, HandleRecord{eventType, node, queued});
+        shard.retired.collect();
+
+        return handle;
+    }
+
+    bool removeHandle(Handle handle)
+    {
+        auto& shard = shards[handle % shards.size()];
+
+        std::lock_guard lock(shard.writeMutex);
+        auto it = shard.handleRecord.find(handle);
+        if (it == shard.handleRecord.end())
+            return false;
+
+        auto record = it->second;
+        shard.handleRecord.erase(it);
+
+        record.node->active.store(false, std::memory_order_release);
+        updateList(shard, record.queued ? shard.queuedListeners : shard.directListeners, record.eventType,
+                   [node = record.node](auto& nodes) { std::erase(nodes, node); });
+        shard.retired.retire(record.node);
+        shard.retired.collect();
+
+        return true;
+    }
+
+    void removeAll()
+    {
+        for (auto& shard : shards)
+        {
+            std::lock_guard lock(shard.writeMutex);
+            for (auto* slot : {&shard.directListeners, &shard.queuedListeners})
+            {
+                const auto* oldTable = slot->table.load(std::memory_order_relaxed);
+                slot->table.store(new ListenerTable(), std::memory_order_release);
+
+                for (const auto* list : oldTable->lists)
+                {
+                    if (!list)
+                        continue;
+                    for (auto* node : list->nodes)
+                    {
+                        node->active.store(false, std::memory_order_release);
+                        shard.retired.retire(node);
+                    }
+                    shard.retired.retire(list);
+                }
+                shard.retired.retire(oldTable);
+            }
+            shard.handleRecord.clear();
+            shard.retired.collect();
+        }
+    }
+
+    static void ReleaseSlots(EventShard& shard, Size count)
+    {
+        if (count == 0)
+            return;
+
+        shard.pendingCount.fetch_sub(count);
+        if (shard.blockedProducers.load() > 0)
+            shard.pendingCount.notify_all();
+    }
+
+    enum class Eviction
+    {
+        Evicted,
+        NoVictim,
+        Retry,
+    };
+
+    // 在优先级不高于新事件的待处理事件中，驱逐最低优先级里最早入队的一个
+    static Eviction EvictOldest(EventShard& shard, EventPriority incoming)
+    {
+        const auto maxLevel = PriorityLevel(incoming);
+        for (Size level = 0; level <= maxLevel; ++level)
+        {
+            QueueLane* victim = nullptr;
+            u64 oldest        = std::numeric_limits<u64>::max();
+            for (auto& lane : shard.lanes)
+            {
+                std::lock_guard lock(lane.mutex);
+                const auto& queue = lane.pending[level];
+                if (!queue.empty() && queue.front().sequence < oldest)
+                {
+                    oldest = queue.front().sequence;
+                    victim = &lane;
+                }
+            }
 
-struct EventCompare
-{
-    template <typename T>
-    bool operator()(const T& a, const T& b) const
+            if (!victim)
+                continue;
+
+            std::lock_guard lock(victim->mutex);
+            if (victim->pending[level].empty())
+                return Eviction::Retry; // 已被工作线程取走，重新尝试预留
+
+            victim->takeFront(level);
+            return Eviction::Evicted;
+        }
+        return Eviction::NoVictim;
+    }
+
+    // 按容量与溢出策略决定新事件能否入队。返回 false 时事件已被丢弃或合并，不应再入队
+    bool admit(EventShard& shard, Size laneIndex, EventWrap& wrap)
     {
-        // 高优先级的事件应该先处理
-        const auto& wrapA = a.template getArgument<0>();
-        const auto& wrapB = b.template getArgument<0>();
-        return wrapA.priority > wrapB.priority;
+        if (shard.capacity == 0)
+        {
+            shard.pendingCount.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        for (;;)
+        {
+            Size current = shard.pendingCount.load(std::memory_order_relaxed);
+            while (current < shard.capacity)
+            {
+                if (shard.pendingCount.compare_exchange_weak(current, current + 1, std::memory_order_acq_rel))
+                    return true;
+            }
+
+            switch (overflowPolicy)
+            {
+            case OverflowPolicy::Block:
+            {
+                // 在处理器中入队时阻塞会使工作线程等待自己，此时允许暂时超出容量
+                if (tDrainingQueue)
+                {
+                    shard.pendingCount.fetch_add(1);
+                    return true;
+                }
+
+                shard.blockedProducers.fetch_add(1);
+                current = shard.pendingCount.load();
+                if (current >= shard.capacity)
+                    shard.pendingCount.wait(current);
+                shard.blockedProducers.fetch_sub(1);
+                break;
+            }
+            case OverflowPolicy::DropNewest:
+            {
+                shard.droppedNewestCount.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            case OverflowPolicy::DropOldestLowestPriority:
+            {
+                const auto result = EvictOldest(shard, wrap.priority);
+                if (result == Eviction::Evicted)
+                {
+                    // 被驱逐事件的位置直接转给新事件
+                    shard.evictedCount.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+                if (result == Eviction::NoVictim)
+                {
+                    shard.droppedNewestCount.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                break;
+            }
+            case OverflowPolicy::Coalesce:
+            {
+                auto& lane = shard.lanes[laneIndex];
+                std::lock_guard lock(lane.mutex);
+                if (lane.mergeIntoPending(wrap, PriorityLevel(wrap.priority)))
+                    shard.coalescedCount.fetch_add(1, std::memory_order_relaxed);
+                else
+                    shard.droppedNewestCount.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            }
+        }
     }
-};
 
-XIHE_PUSH_WARNING
-XIHE_CLANG_DISABLE_WARNING("-Wunneeded-member-function")
+    void postToFrame(EventPtr event)
+    {
+        auto& buffer = LocalBuffer(busId, frameBuffers);
 
-// 同步分发策略
-struct EventPolicy
-{
-    static std::type_index getEvent(const EventWrap& wrap)
+        std::lock_guard lock(buffer.mutex);
+        buffer.events.push_back(std::move(event));
+    }
+
+    // 交换后 frameStaging 中的数组保留容量，下一帧继续复用
+    void swapFrameBuffers()
     {
-        return wrap.id;
+        std::lock_guard lock(frameMutex);
+        {
+            std::lock_guard poolLock(frameBuffers->mutex);
+            const auto& buffers = frameBuffers->buffers;
+            frameStaging.resize(buffers.size());
+            for (Size i = 0; i < buffers.size(); ++i)
+            {
+                std::lock_guard bufferLock(buffers[i]->mutex);
+                std::swap(buffers[i]->events, frameStaging[i]);
+            }
+        }
+
+        frameEvents.build(frameStaging);
+        for (auto& staging : frameStaging)
+            staging.clear();
     }
-};
 
-// 异步队列策略
-struct EventQueuePolicy
-{
-    template <typename Item>
-    using QueueList = eventpp::OrderedQueueList<Item, EventCompare>;
+    void addWaiter(EventWaiter& waiter)
+    {
+        std::lock_guard lock(waiterMutex);
+        if (waiters.size() <= waiter.eventType)
+            waiters.resize(waiter.eventType + 1);
+
+        auto& list  = waiters[waiter.eventType];
+        waiter.next = nullptr;
+        (list.tail ? list.tail->next : list.head) = &waiter;
+        list.tail = &waiter;
+        waiterCount.fetch_add(1, std::memory_order_relaxed);
+    }
 
-    static std::type_index getEvent(const EventWrap& wrap)
+    // 取出所有匹配事件的等待者，监听器取消的事件不会唤醒等待者。
+    // 返回的链表由调用者在释放总线的锁、离开纪元临界区之后交给 ResumeWaiters，
+    // 协程的后续代码可以再次处理队列、入队或等待纪元推进
+    EventWaiter* takeWaiters(const EventWrap& wrap)
     {
-        return wrap.id;
+        if (waiterCount.load(std::memory_order_relaxed) == 0 || wrap.event->isCancelled())
+            return nullptr;
+
+        EventWaiter* ready      = nullptr;
+        EventWaiter** readyTail = &ready;
+        {
+            std::lock_guard lock(waiterMutex);
+            if (wrap.id >= waiters.size())
+                return nullptr;
+
+            auto& list        = waiters[wrap.id];
+            EventWaiter* prev = nullptr;
+            for (auto* waiter = list.head; waiter;)
+            {
+                auto* next = waiter->next;
+                if (waiter->match(*waiter, *wrap.event))
+                {
+                    (prev ? prev->next : list.head) = next;
+                    if (list.tail == waiter)
+                        list.tail = prev;
+
+                    waiter->event = wrap.event;
+                    waiter->next  = nullptr;
+                    *readyTail    = waiter;
+                    readyTail     = &waiter->next;
+                    waiterCount.fetch_sub(1, std::memory_order_relaxed);
+                }
+                else
+                {
+                    prev = waiter;
+                }
+                waiter = next;
+            }
+        }
+        return ready;
     }
-};
 
-XIHE_POP_WARNING
-} // namespace 
+    // 总线析构时以空事件恢复所有仍在等待的协程
+    void cancelWaiters()
+    {
+        EventWaiter* ready      = nullptr;
+        EventWaiter** readyTail = &ready;
+        {
+            std::lock_guard lock(waiterMutex);
+            for (auto& list : waiters)
+            {
+                if (list.head)
+                {
+                    *readyTail = list.head;
+                    readyTail  = &list.tail->next;
+                }
+                list = {};
+            }
+            waiterCount.store(0, std::memory_order_relaxed);
+        }
+        ResumeWaiters(ready);
+    }
 
-class EventBus::Impl
-{
-public:
-    using DispatcherType = eventpp::EventDispatcher<std::type_index, void(const EventWrap&), EventPolicy>;
-    using QueueType      = eventpp::EventQueue<std::type_index, void(const EventWrap&), EventQueuePolicy>;
+    static void ResumeWaiters(EventWaiter* waiter)
+    {
+        while (waiter)
+        {
+            // 恢复后等待者所在的协程帧可能已被释放，先取出所需字段
+            auto* next     = waiter->next;
+            auto handle    = waiter->handle;
+            auto* executor = waiter->executor;
+            if (executor)
+                executor->post(handle);
+            else
+                handle.resume();
+            waiter = next;
+        }
+    }
+
+    void enqueue(EventPtr event, EventPriority priority, std::optional<u64> orderKey)
+    {
+        event->setPriority(priority);
+
+        // 观察者为空时不进入临界区
+        if (observer.load(std::memory_order_relaxed))
+        {
+            EpochGuard guard;
+            if (auto* current = observer.load(std::memory_order_acquire))
+                current->onEnqueue(event, priority, orderKey);
+        }
 
-    using DispatcherHandle = DispatcherType::Handle;
-    using QueueHandle      = QueueType::Handle;
+        EventWrap wrap(std::move(event));
+        if (metricsEnabled.load(std::memory_order_relaxed))
+            wrap.enqueuedAt = FastClock::now();
+        const u64 routeKey = orderKey ? MixKey(*orderKey) : As<u64>(wrap.id);
+        auto& shard        = shardOf(routeKey);
+        push(shard, laneOf(shard, routeKey), std::move(wrap));
+        shard.queuedCount.fetch_add(1, std::memory_order_relaxed);
+    }
 
-    using HandleRecordDispatcher = std::unordered_map<Handle, DispatcherHandle>;
-    using HandleRecordQueue      = std::unordered_map<Handle, QueueHandle>;
-    using EventRecord            = std::unordered_map<Handle, std::type_index>;
+    void push(EventShard& shard, Size laneIndex, EventWrap&& wrap)
+    {
+        auto& lane        = shard.lanes[laneIndex];
+        const auto level  = PriorityLevel(wrap.priority);
+        const auto policy = wrap.event->getCoalescePolicy();
 
-    DispatcherType dispatcher;
-    QueueType queue;
+        // 可合并的事件先尝试合并，不占用队列容量
+        if (policy != EventCoalesce::None)
+        {
+            std::lock_guard lock(lane.mutex);
+            if (lane.tryCoalesce(wrap, policy))
+            {
+                shard.coalescedCount.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
 
-    std::shared_mutex dispatcherMutex;
-    std::shared_mutex queueMutex;
-    std::mutex handleMutex;
+        if (!admit(shard, laneIndex, wrap))
+            return;
 
-    HandleRecordDispatcher dispatcherRecord;
-    HandleRecordQueue queueRecord;
-    EventRecord eventRecord;
+        bool needSchedule = false;
+        {
+            std::lock_guard lock(lane.mutex);
+            if (policy != EventCoalesce::None)
+            {
+                if (lane.tryCoalesce(wrap, policy))
+                {
+                    shard.coalescedCount.fetch_add(1, std::memory_order_relaxed);
+                    ReleaseSlots(shard, 1);
+                    return;
+                }
+
+                auto& queue   = lane.pending[level];
+                wrap.sequence = shard.nextSequence.fetch_add(1, std::memory_order_relaxed);
+                queue.push_back(std::move(wrap));
+                lane.coalescing.insert_or_assign(queue.back().id, &queue.back());
+            }
+            else
+            {
+                wrap.sequence = shard.nextSequence.fetch_add(1, std::memory_order_relaxed);
+                lane.pending[level].push_back(std::move(wrap));
+            }
 
-    std::atomic<Handle> nextHandle{1};
-    std::jthread queueWorker;
-    std::stop_source stopSource;
+            needSchedule   = shard.workerCount > 0 && !lane.scheduled;
+            lane.scheduled = needSchedule || lane.scheduled;
+        }
 
-    std::atomic<u64> dispatchedCount{0};
-    std::atomic<u64> queuedCount{0};
+        if (needSchedule)
+            schedule(shard, laneIndex);
+    }
 
-    bool removeHandle(Handle handle)
+    void schedule(const EventShard& shard, Size laneIndex)
+    {
+        auto& ready = readyQueues[shard.readyQueue];
+        {
+            std::lock_guard lock(ready.mutex);
+            ready.lanes.emplace_back(As<Size>(&shard - shards.data()), laneIndex);
+        }
+        ready.cv.notify_one();
+    }
+
+    // 处理 lane 中至多 maxCount 个事件，返回 lane 是否已清空。
+    // 有协程等待的事件处理后提前结束本批，在释放处理锁后恢复协程，再处理后续事件
+    bool drainLane(EventShard& shard, QueueLane& lane, Size maxCount)
+    {
+        EventWaiter* ready = nullptr;
+        const bool drained = drainLocked(shard, lane, maxCount, ready);
+        ResumeWaiters(ready);
+        return drained;
+    }
+
+    bool drainLocked(EventShard& shard, QueueLane& lane, Size maxCount, EventWaiter*& ready)
     {
-        // Try dispatcher first
+        std::lock_guard processLock(lane.processMutex);
+        DrainingScope draining;
+
+        for (Size i = 0; i < maxCount; ++i)
         {
-            std::scoped_lock lock{handleMutex, dispatcherMutex};
-            if (dispatcherRecord.contains(handle) && eventRecord.contains(handle))
+            std::optional<EventWrap> wrap;
+            {
+                std::lock_guard lock(lane.mutex);
+                wrap = lane.pop();
+            }
+
+            if (!wrap)
+                return true;
+
+            ReleaseSlots(shard, 1);
+            if (!wrap->event->isCancelled())
             {
-                auto dispatcherHandle = dispatcherRecord.extract(handle).mapped();
-                auto eventType        = eventRecord.extract(handle).mapped();
-                return dispatcher.removeListener(eventType, dispatcherHandle);
+                EpochGuard guard;
+                auto& listeners = shardOf(wrap->id).queuedListeners;
+                if (metricsEnabled.load(std::memory_order_relaxed))
+                    callMeasured(listeners, *wrap, true);
+                else
+                    listeners.call(*wrap);
             }
+            ready = takeWaiters(*wrap);
+            if (ready)
+                break;
         }
 
-        // Try queue if not found in dispatcher
+        std::lock_guard lock(lane.mutex);
+        return lane.empty();
+    }
+
+    void queueProcess(Size workerIndex, Size readyIndex, std::stop_token stopToken)
+    {
+        ApplyThreadOptions(MakeWorkerThreadOptions(threadOptions, workerIndex));
+
+        auto& ready = readyQueues[readyIndex];
+        while (!stopToken.stop_requested())
         {
-            std::scoped_lock lock{handleMutex, queueMutex};
-            if (queueRecord.contains(handle) && eventRecord.contains(handle))
+            Size shardIndex = 0;
+            Size laneIndex  = 0;
             {
-                auto queueHandle = queueRecord.extract(handle).mapped();
-                auto eventType   = eventRecord.extract(handle).mapped();
-                return queue.removeListener(eventType, queueHandle);
+                std::unique_lock lock(ready.mutex);
+                ready.cv.wait(lock, [&] { return stopToken.stop_requested() || !ready.lanes.empty(); });
+                if (stopToken.stop_requested())
+                    break;
+
+                std::tie(shardIndex, laneIndex) = ready.lanes.front();
+                ready.lanes.pop_front();
             }
-        }
 
-        return false;
+            auto& shard  = shards[shardIndex];
+            auto& lane   = shard.lanes[laneIndex];
+            bool drained = drainLane(shard, lane, kLaneBatchSize);
+
+            // 未处理完的 lane 重新排到就绪队列末尾，让其他类型有机会执行
+            bool reschedule = false;
+            {
+                std::lock_guard lock(lane.mutex);
+                drained        = drained && lane.empty();
+                reschedule     = !drained;
+                lane.scheduled = reschedule;
+            }
+
+            if (reschedule)
+                schedule(shard, laneIndex);
+        }
     }
 
-    bool isDispatchHandle(Handle handle)
+    void stopWorkers()
     {
-        DispatcherHandle disHandle;
-        std::optional<std::type_index> eventId;
+        stopSource.request_stop();
+        for (auto& ready : readyQueues)
+        {
+            // 持锁后再通知，避免工作线程在检查停止标志与进入等待之间错过唤醒
+            {
+                std::lock_guard lock(ready.mutex);
+            }
+            ready.cv.notify_all();
+        }
 
+        for (auto& worker : queueWorkers)
         {
-            std::scoped_lock lock{handleMutex, dispatcherMutex};
-            if (dispatcherRecord.contains(handle) && eventRecord.contains(handle))
+            if (worker.joinable())
             {
-                disHandle = dispatcherRecord.at(handle);
-                eventId   = eventRecord.at(handle);
+                worker.join();
             }
         }
+    }
 
-        if (disHandle && eventId.has_value())
-            return dispatcher.ownsHandle(eventId.value(), disHandle);
+    void processAll()
+    {
+        for (auto& shard : shards)
+        {
+            for (auto& lane : shard.lanes)
+            {
+                while (!drainLane(shard, lane, numeric_limits<Size>::max()))
+                {
+                }
+            }
+        }
+    }
 
-        return false;
+    void clearAll()
+    {
+        for (auto& shard : shards)
+        {
+            for (auto& lane : shard.lanes)
+            {
+                Size cleared = 0;
+                {
+                    std::lock_guard lock(lane.mutex);
+                    cleared = lane.clear();
+                }
+                ReleaseSlots(shard, cleared);
+            }
+        }
+    }
+
+    MetricsBuffer& localMetrics()
+    {
+        return LocalBuffer(busId, metricsBuffers);
     }
 
-    bool isQueueHandle(Handle handle)
+    // 带计时的分发，监听器执行期间不持有缓冲区的锁，允许在处理器中嵌套分发
+    void callMeasured(const ListenerSlot& slot, const EventWrap& wrap, bool queued)
     {
-        QueueHandle queHandle;
-        std::optional<std::type_index> eventId;
+        auto& metrics    = localMetrics();
+        const auto start = FastClock::now();
+
+        slot.forEachListener(wrap, [&](ListenerNode* node)
+        {
+            const auto callStart = FastClock::now();
+            node->callback(wrap.event);
+            const auto elapsed = ElapsedNs(callStart, FastClock::now());
+
+            std::lock_guard lock(metrics.mutex);
+            auto& listener     = metrics.listeners[node->handle];
+            listener.typeIndex = wrap.id;
+            listener.executionTime.record(elapsed);
+        });
+
+        const auto elapsed = ElapsedNs(start, FastClock::now());
+
+        std::lock_guard lock(metrics.mutex);
+        auto& type = metrics.type(wrap.id);
+        if (queued)
+        {
+            ++type.queuedCount;
+            if (wrap.enqueuedAt != TimePoint{})
+                type.queueWait.record(ElapsedNs(wrap.enqueuedAt, start));
+        }
+        else
+        {
+            ++type.dispatchCount;
+        }
+        type.handlerTime.record(elapsed);
+    }
 
+    EventMetricsSnapshot snapshotMetrics()
+    {
+        std::vector<MetricsBuffer::TypeData> types;
+        std::unordered_map<Handle, MetricsBuffer::ListenerData> listeners;
         {
-            std::scoped_lock lock{handleMutex, queueMutex};
-            if (queueRecord.contains(handle) && eventRecord.contains(handle))
+            std::lock_guard lock(metricsBuffers->mutex);
+            for (auto& buffer : metricsBuffers->buffers)
             {
-                queHandle = queueRecord.at(handle);
-                eventId   = eventRecord.at(handle);
+                std::lock_guard bufferLock(buffer->mutex);
+                if (types.size() < buffer->types.size())
+                    types.resize(buffer->types.size());
+
+                for (Size i = 0; i < buffer->types.size(); ++i)
+                {
+                    const auto& from = buffer->types[i];
+                    auto& to         = types[i];
+                    to.dispatchCount += from.dispatchCount;
+                    to.queuedCount += from.queuedCount;
+                    to.queueWait.merge(from.queueWait);
+                    to.handlerTime.merge(from.handlerTime);
+                }
+
+                for (const auto& [handle, from] : buffer->listeners)
+                {
+                    auto& to     = listeners[handle];
+                    to.typeIndex = from.typeIndex;
+                    to.executionTime.merge(from.executionTime);
+                }
             }
         }
 
-        if (queHandle && eventId.has_value())
-            return queue.ownsHandle(eventId.value(), queHandle);
+        EventMetricsSnapshot snapshot;
+        for (Size i = 0; i < types.size(); ++i)
+        {
+            auto& data = types[i];
+            if (data.dispatchCount == 0 && data.queuedCount == 0)
+                continue;
+
+            auto& type         = snapshot.types.emplace_back();
+            type.typeIndex     = As<EventTypeIndex>(i);
+            type.typeName      = EventTypeName(type.typeIndex);
+            type.dispatchCount = data.dispatchCount;
+            type.queuedCount   = data.queuedCount;
+            type.queueWait     = data.queueWait;
+            type.handlerTime   = data.handlerTime;
+        }
 
-        return false;
+        for (auto& [handle, data] : listeners)
+        {
+            auto& listener         = snapshot.listeners.emplace_back();
+            listener.handle        = handle;
+            listener.typeIndex     = data.typeIndex;
+            listener.executionTime = data.executionTime;
+        }
+        std::ranges::sort(snapshot.listeners, {}, &ListenerMetrics::handle);
+
+        return snapshot;
     }
 
-    void queueProcess(std::stop_token stopToken)
+    void resetMetrics()
     {
-        while (true)
+        std::lock_guard lock(metricsBuffers->mutex);
+        for (auto& buffer : metricsBuffers->buffers)
         {
-            while (!queue.waitFor(std::chrono::milliseconds(20)) && !stopToken.stop_requested());
-            if (stopToken.stop_requested())
-                break;
+            std::lock_guard bufferLock(buffer->mutex);
+            buffer->types.clear();
+            buffer->listeners.clear();
+        }
+    }
+
+    void dumpLoop()
+    {
+        SetCurrentThreadName("XiheEventDump");
 
-            queue.process();
+        std::unique_lock lock(dumpMutex);
+        while (!dumpCv.wait_for(lock, dumpInterval, [this] { return dumpStop; }))
+        {
+            if (!metricsEnabled.load(std::memory_order_relaxed))
+                continue;
+
+            lock.unlock();
+            const auto snapshot = snapshotMetrics();
+            if (dumpCallback)
+                dumpCallback(snapshot);
+            else
+                XIHE_CORE_INFO("{}", snapshot.toString());
+            lock.lock();
+        }
+    }
+
+    void stopDump()
+    {
+        {
+            std::lock_guard lock(dumpMutex);
+            dumpStop = true;
         }
+        dumpCv.notify_all();
+
+        if (dumpThread.joinable())
+            dumpThread.join();
     }
 
     size_t getSubscriberCount()
     {
-        std::shared_lock dispatcherLock(dispatcherMutex);
-        std::shared_lock queueLock(queueMutex);
-        return dispatcherRecord.size() + queueRecord.size();
+        size_t count = 0;
+        for (auto& shard : shards)
+        {
+            std::lock_guard lock(shard.writeMutex);
+            count += shard.handleRecord.size();
+        }
+        return count;
+    }
+
+    // 每个分片的监听器快照在整个批次中只加载一次
+    Size callBatch(const std::vector<EventPtr>& events)
+    {
+        std::vector<const ListenerTable*> tables(shards.size(), nullptr);
+        return CallBatch(events, [this, &tables](EventTypeIndex id)
+        {
+            auto& table = tables[shardIndex(id)];
+            if (!table)
+                table = shards[shardIndex(id)].directListeners.table.load(std::memory_order_acquire);
+            return table->find(id);
+        });
     }
 };
 
 // ======================================
 
 EventBus::EventBus() :
-    _pImpl(std::make_unique<Impl>())
+    EventBus(Config{})
 {
-    _pImpl->queueWorker = std::jthread(&Impl::queueProcess, _pImpl.get(), _pImpl->stopSource.get_token());
 }
 
-EventBus::~EventBus()
+EventBus::EventBus(const Config& config) :
+    _pImpl(std::make_unique<Impl>(config))
 {
-    if (_pImpl)
+    _pImpl->queueWorkers.reserve(_pImpl->workerCount);
+    for (Size i = 0; i < _pImpl->workerCount; ++i)
     {
-        _pImpl->stopSource.request_stop();
-        if (_pImpl->queueWorker.joinable())
-        {
-            _pImpl->queueWorker.join();
-        }
+        _pImpl->queueWorkers.emplace_back(&Impl::queueProcess, _pImpl.get(), i, i % _pImpl->readyQueues.size(),
+                                          _pImpl->stopSource.get_token());
+    }
 
-        // 处理剩余事件
-        _pImpl->queue.process();
+    if (_pImpl->dumpInterval > Duration::zero())
+    {
+        _pImpl->dumpThread = std::thread(&Impl::dumpLoop, _pImpl.get());
     }
 }
 
-Handle EventBus::subscribeDirectImpl(std::type_index eventType, GenericEventCallback inCallback) const
+EventBus::~EventBus()
 {
-    auto handle = _pImpl->nextHandle.fetch_add(1);
-
-    auto wrappedCallback = [callback = std::move(inCallback)](const EventWrap& wrap)
+    if (_pImpl)
     {
-        callback(wrap.event);
-    };
+        _pImpl->stopDump();
+        _pImpl->stopWorkers();
 
-    // 按照统一的锁顺序获取所有需要的锁
-    std::scoped_lock lock{_pImpl->handleMutex, _pImpl->dispatcherMutex};
-
-    auto dispatcherHandle = _pImpl->dispatcher.appendListener(eventType, std::move(wrappedCallback));
-    _pImpl->dispatcherRecord.emplace(handle, dispatcherHandle);
-    _pImpl->eventRecord.emplace(handle, eventType);
-
-    return handle;
+        // 处理剩余事件
+        _pImpl->processAll();
+        _pImpl->cancelWaiters();
+    }
 }
 
-Handle EventBus::subscribeQueuedImpl(std::type_index eventType, GenericEventCallback inCallback) const
+Handle EventBus::subscribeDirectImpl(EventTypeIndex eventType, GenericEventCallback callback, const EventMask& mask) const
 {
-    auto handle = _pImpl->nextHandle.fetch_add(1);
-
-    auto wrappedCallback = [callback = std::move(inCallback)](const EventWrap& wrap)
-    {
-        callback(wrap.event);
-    };
-
-    // 按照统一的锁顺序获取所有需要的锁
-    std::scoped_lock lock{_pImpl->handleMutex, _pImpl->queueMutex};
-
-    auto queueHandle = _pImpl->queue.appendListener(eventType, std::move(wrappedCallback));
-    _pImpl->queueRecord.emplace(handle, queueHandle);
-    _pImpl->eventRecord.emplace(handle, eventType);
+    return _pImpl->addListener(false, eventType, std::move(callback), mask);
+}
 
-    return handle;
+Handle EventBus::subscribeQueuedImpl(EventTypeIndex eventType, GenericEventCallback callback, const EventMask& mask) const
+{
+    return _pImpl->addListener(true, eventType, std::move(callback), mask);
 }
 
 bool EventBus::unsubscribe(Handle handle) const
@@ -273,86 +1483,103 @@ bool EventBus::unsubscribe(Handle handle) const
 
 void EventBus::unsubscribeAll() const
 {
-    std::scoped_lock lock{_pImpl->handleMutex, _pImpl->dispatcherMutex, _pImpl->queueMutex};
+    _pImpl->removeAll();
+}
 
-    // 移除所有dispatcher监听器
-    for (const auto& [handle, dispatcherHandle] : _pImpl->dispatcherRecord)
-    {
-        auto it = _pImpl->eventRecord.find(handle);
-        if (it != _pImpl->eventRecord.end())
-        {
-            _pImpl->dispatcher.removeListener(it->second, dispatcherHandle);
-        }
-    }
+void EventBus::dispatch(EventPtr event) const
+{
+    if (!event || event->isCancelled())
+        return;
 
-    // 移除所有queue监听器
-    for (const auto& [handle, queueHandle] : _pImpl->queueRecord)
+    EventWaiter* ready = nullptr;
     {
-        auto it = _pImpl->eventRecord.find(handle);
-        if (it != _pImpl->eventRecord.end())
-        {
-            _pImpl->queue.removeListener(it->second, queueHandle);
-        }
+        EpochGuard guard;
+        if (auto* observer = _pImpl->observer.load(std::memory_order_acquire))
+            observer->onDispatch(event);
+
+        EventWrap wrap(std::move(event));
+        auto& shard = _pImpl->shardOf(wrap.id);
+        if (_pImpl->metricsEnabled.load(std::memory_order_relaxed))
+            _pImpl->callMeasured(shard.directListeners, wrap, false);
+        else
+            shard.directListeners.call(wrap);
+        shard.dispatchedCount.fetch_add(1, std::memory_order_relaxed);
+        ready = _pImpl->takeWaiters(wrap);
     }
 
-    _pImpl->dispatcherRecord.clear();
-    _pImpl->queueRecord.clear();
-    _pImpl->eventRecord.clear();
+    // 离开临界区后再恢复协程
+    Impl::ResumeWaiters(ready);
 }
 
-void EventBus::dispatch(EventPtr event) const
+void EventBus::enqueue(EventPtr event, EventPriority priority) const
 {
     if (!event || event->isCancelled())
         return;
 
-    std::shared_lock lock(_pImpl->dispatcherMutex);
-    EventWrap wrap(event);
-    _pImpl->dispatcher.dispatch(wrap.id, wrap);
-    _pImpl->dispatchedCount.fetch_add(1);
+    _pImpl->enqueue(std::move(event), priority, std::nullopt);
 }
 
-void EventBus::enqueue(EventPtr event, EventPriority priority) const
+void EventBus::enqueue(EventPtr event, EventPriority priority, u64 orderKey) const
 {
     if (!event || event->isCancelled())
         return;
 
-    event->setPriority(priority);
-
-    std::shared_lock lock(_pImpl->queueMutex);
-    EventWrap wrap(event);
-    _pImpl->queue.enqueue(wrap.id, wrap);
-    _pImpl->queuedCount.fetch_add(1);
+    _pImpl->enqueue(std::move(event), priority, orderKey);
 }
 
 void EventBus::processBatch(const std::vector<EventPtr>& events)
 {
-    for (const auto& event : events)
+    // 统计、观察或有协程等待时逐个分发，不做分组
+    if (_pImpl->metricsEnabled.load(std::memory_order_relaxed) || _pImpl->observer.load(std::memory_order_relaxed) ||
+        _pImpl->waiterCount.load(std::memory_order_relaxed) != 0)
     {
-        if (event && !event->isCancelled())
-        {
+        for (const auto& event : events)
             dispatch(event);
-        }
+        return;
     }
+
+    EpochGuard guard;
+    const auto count = _pImpl->callBatch(events);
+    // 批量分发只需要总数，计入第一个分片
+    _pImpl->shards.front().dispatchedCount.fetch_add(As<u64>(count), std::memory_order_relaxed);
+}
+
+void EventBus::postToFrame(EventPtr event) const
+{
+    if (!event || event->isCancelled())
+        return;
+
+    _pImpl->postToFrame(std::move(event));
+}
+
+void EventBus::swapFrameBuffers()
+{
+    _pImpl->swapFrameBuffers();
+}
+
+const FrameEvents& EventBus::getFrameEvents() const
+{
+    return _pImpl->frameEvents;
 }
 
 void EventBus::processQueue()
 {
-    _pImpl->queue.process();
+    _pImpl->processAll();
 }
 
 void EventBus::clearQueue()
 {
-    _pImpl->queue.clearEvents();
+    _pImpl->clearAll();
 }
 
 u64 EventBus::getDispatchedCount() const
 {
-    return _pImpl->dispatchedCount.load();
+    return _pImpl->sum(&EventShard::dispatchedCount);
 }
 
 u64 EventBus::getQueuedCount() const
 {
-    return _pImpl->queuedCount.load();
+    return _pImpl->sum(&EventShard::queuedCount);
 }
 
 size_t EventBus::getSubscriberCount() const
@@ -360,11 +1587,80 @@ size_t EventBus::getSubscriberCount() const
     return _pImpl->getSubscriberCount();
 }
 
+u64 EventBus::getCoalescedCount() const
+{
+    return _pImpl->sum(&EventShard::coalescedCount);
+}
+
+u64 EventBus::getDroppedCount() const
+{
+    return _pImpl->sum(&EventShard::droppedNewestCount) + _pImpl->sum(&EventShard::evictedCount);
+}
+
+Size EventBus::getPendingCount() const
+{
+    return _pImpl->sum(&EventShard::pendingCount);
+}
+
+void EventBus::setMetricsEnabled(bool enabled)
+{
+    _pImpl->metricsEnabled.store(enabled);
+}
+
+bool EventBus::isMetricsEnabled() const
+{
+    return _pImpl->metricsEnabled.load();
+}
+
+EventMetricsSnapshot EventBus::getMetricsSnapshot() const
+{
+    return _pImpl->snapshotMetrics();
+}
+
+void EventBus::resetMetrics()
+{
+    _pImpl->resetMetrics();
+}
+
+void EventBus::addWaiter(EventWaiter& waiter) const
+{
+    _pImpl->addWaiter(waiter);
+}
+
+void EventBus::setObserver(IEventObserver* observer)
+{
+    std::lock_guard lock(_pImpl->observerMutex);
+    if (_pImpl->observer.exchange(observer, std::memory_order_acq_rel) != nullptr)
+    {
+        // 等待正在通知旧观察者的线程离开临界区
+        Epoch::Synchronize();
+    }
+}
+
+IEventObserver* EventBus::getObserver() const
+{
+    return _pImpl->observer.load();
+}
+
+Size EventBus::getQueueWorkerCount() const
+{
+    return _pImpl->workerCount;
+}
+
+Size EventBus::getShardCount() const
+{
+    return _pImpl->shards.size();
+}
+
 EventBus::Statistics EventBus::getStatistics() const
 {
     Statistics stats;
     stats.dispatchedCount = getDispatchedCount();
     stats.queuedCount     = getQueuedCount();
+    stats.coalescedCount  = getCoalescedCount();
+    stats.droppedNewest   = _pImpl->sum(&EventShard::droppedNewestCount);
+    stats.droppedEvicted  = _pImpl->sum(&EventShard::evictedCount);
+    stats.pendingCount    = getPendingCount();
     stats.subscriberCount = getSubscriberCount();
     return stats;
 }
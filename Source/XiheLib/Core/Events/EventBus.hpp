@@ -12,8 +12,13 @@
 #include <vector>
 #include <functional>
 #include <chrono>
+#include <optional>
 
 #include "Core/Events/Event.hpp"
+#include "Core/Events/EventCoroutine.hpp"
+#include "Core/Events/EventMetrics.hpp"
+#include "Core/Events/FrameEvents.hpp"
+#include "Core/Threading/Threads.hpp"
 
 namespace xihe {
 // 组合过滤器
@@ -49,6 +54,18 @@ private:
     std::vector<EventFilter<E>> _filters;
 };
 
+/**
+ * @brief 声明式过滤条件
+ *
+ * 由事件总线在调用监听器前以位掩码测试，不匹配的监听器直接跳过，不经过 std::function 调用。
+ * 任意谓词过滤器只对通过位掩码测试的事件执行。
+ */
+struct EventMask
+{
+    EventCategory categories  = EventCategory::None; // 事件分类与其有交集时通过，None 表示不按分类过滤
+    EventPriority minPriority = EventPriority::Low;  // 事件优先级不低于该值时通过
+};
+
 // 预定义过滤器
 namespace filters {
     template <cEventType E>
@@ -69,6 +86,17 @@ namespace filters {
         };
     }
 
+    // 声明式版本，订阅时使用可由事件总线预先过滤
+    constexpr EventMask category(EventCategory categories)
+    {
+        return EventMask{.categories = categories};
+    }
+
+    constexpr EventMask minPriority(EventPriority priority)
+    {
+        return EventMask{.minPriority = priority};
+    }
+
     template <cEventType E>
     EventFilter<E> notCancelled()
     {
@@ -89,13 +117,80 @@ namespace filters {
     }
 }
 
+template <cEventType E, typename F>
+class EventAwaiter;
+
+/**
+ * @brief 总线观察者，在事件进入总线时收到通知（用于录制等工具）
+ *
+ * 回调在调用 dispatch/enqueue 的线程上执行，可能被多个线程并发调用。
+ */
+class IEventObserver
+{
+public:
+    virtual ~IEventObserver() = default;
+
+    virtual void onDispatch(const EventPtr& event) = 0;
+
+    // orderKey 为空表示调用的是不带 orderKey 的 enqueue
+    virtual void onEnqueue(const EventPtr& event, EventPriority priority, std::optional<u64> orderKey) = 0;
+};
+
 class XIHE_API EventBus
 {
 public:
     using Handle                          = u64;
     static constexpr Handle InvalidHandle = 0;
 
+    /**
+     * @brief 队列已满时的处理策略
+     */
+    enum class OverflowPolicy : u8
+    {
+        Block,                    // 阻塞入队线程直到有空位（在队列处理器中入队时不阻塞，允许暂时超出容量）
+        DropNewest,               // 丢弃新入队的事件
+        DropOldestLowestPriority, // 驱逐优先级最低（且不高于新事件）的待处理事件中最早入队的一个
+        Coalesce,                 // 与队列中同类型同优先级的最近事件合并（只限声明了合并策略的类型），无法合并时丢弃新事件
+    };
+
+    /**
+     * @brief 事件总线配置
+     */
+    struct Config
+    {
+        // 队列分发的工作线程数。为 1 时与单线程队列行为一致（全局按优先级排序）；
+        // 大于 1 时进入线程池模式：同一事件类型（或同一 orderKey）的事件保持顺序，不同类型并行处理；
+        // 为 0 时不创建工作线程，队列只在调用 processQueue 时处理
+        Size queueWorkers = 1;
+
+        // 队列容量（所有待处理事件的总数），为 0 时不限制
+        Size queueCapacity = 0;
+
+        // 分片数。事件类型按类型索引（队列中指定 orderKey 时按其哈希）分配到分片，每个分片拥有独立的监听器表、写锁、队列与计数，
+        // 不相关的事件类型在订阅、分发与入队时互不竞争。大于 1 时：
+        // - 队列的优先级顺序只在同一分片内保证；
+        // - 分片数与工作线程数无关：分片多于工作线程时分片 i 由工作线程 i % queueWorkers 处理，反之工作线程平均分配到各分片；
+        // - queueCapacity 平均分配到各分片
+        Size shardCount = 1;
+
+        // 队列已满时的处理策略。使用 Block 且 queueWorkers 为 0 时，需要由其他线程调用 processQueue
+        OverflowPolicy overflowPolicy = OverflowPolicy::Block;
+
+        // 是否记录各事件类型与各监听器的耗时统计（见 getMetricsSnapshot），也可以运行时通过 setMetricsEnabled 切换
+        bool enableMetrics = false;
+
+        // 定期输出统计信息的间隔，为 0 时不输出；只在统计开启时输出
+        Duration metricsDumpInterval = Duration::zero();
+
+        // 定期输出时调用的回调，为空时写入日志
+        std::function<void(const EventMetricsSnapshot&)> metricsDumpCallback;
+
+        // 队列工作线程属性，名称后追加线程下标
+        ThreadOptions workerThreads{.name = "XiheEvent"};
+    };
+
     EventBus();
+    explicit EventBus(const Config& config);
     ~EventBus();
 
     // 禁止拷贝和移动
@@ -148,6 +243,31 @@ public:
         return subscribeQueued(std::move(wrappedCallback));
     }
 
+    // 声明式过滤：分类与优先级由总线以位掩码预先过滤
+    template <cEventType E>
+    Handle subscribe(EventCallback<E> listener, const EventMask& mask)
+    {
+        return subscribeDirectImpl(EventTypeIndexOf<E>(), WrapCallback<E>(std::move(listener)), mask);
+    }
+
+    template <cEventType E>
+    Handle subscribe(EventCallback<E> listener, const EventMask& mask, EventFilter<E> filter)
+    {
+        return subscribeDirectImpl(EventTypeIndexOf<E>(), WrapFilteredCallback<E>(std::move(listener), std::move(filter)), mask);
+    }
+
+    template <cEventType E>
+    Handle subscribeAsync(EventCallback<E> listener, const EventMask& mask)
+    {
+        return subscribeQueuedImpl(EventTypeIndexOf<E>(), WrapCallback<E>(std::move(listener)), mask);
+    }
+
+    template <cEventType E>
+    Handle subscribeAsync(EventCallback<E> listener, const EventMask& mask, EventFilter<E> filter)
+    {
+        return subscribeQueuedImpl(EventTypeIndexOf<E>(), WrapFilteredCallback<E>(std::move(listener), std::move(filter)), mask);
+    }
+
     template <cEventType E>
     Handle subscribeWithFilter(EventCallback<E> inListener, EventFilter<E> inFilter)
     {
@@ -182,12 +302,50 @@ public:
         enqueue(std::move(event), priority);
     }
 
-    // 异步入队
+    // 异步分发，orderKey 相同的事件按入队顺序串行处理（用于跨类型的保序）
+    void dispatchAsync(EventPtr event, EventPriority priority, u64 orderKey)
+    {
+        enqueue(std::move(event), priority, orderKey);
+    }
+
+    // 异步入队。声明了合并策略的事件类型会与队列中尚未处理的同类型事件合并（见 EventCoalesce）
     void enqueue(EventPtr event, EventPriority priority = EventPriority::Normal) const;
+    void enqueue(EventPtr event, EventPriority priority, u64 orderKey) const;
+
+    // 等待下一个满足过滤条件的 E 类型事件：auto event = co_await bus.next<E>(filter, executor);
+    // 等待只在挂起期间占用总线的等待表，事件到达后自动移除。executor 为空时在分发事件的线程上恢复，
+    // 恢复时总线已释放内部锁并离开纪元临界区，协程可以继续分发、处理队列或修改订阅；
+    // 但在队列工作线程上恢复时仍占用该线程，长时间运行或以 Block 策略向已满的队列入队的协程应指定 executor。
+    // 总线析构时仍在等待的协程以空指针恢复。过滤器在总线内部锁中调用，不能访问总线
+    template <cEventType E, typename F = AcceptAnyEvent> requires std::predicate<F, const E&>
+    XIHE_NODISCARD EventAwaiter<E, F> next(F filter = {}, ICoroutineExecutor* executor = nullptr) const
+    {
+        return EventAwaiter<E, F>(*this, std::move(filter), executor);
+    }
+
+    template <cEventType E>
+    XIHE_NODISCARD EventAwaiter<E, AcceptAnyEvent> next(ICoroutineExecutor* executor) const
+    {
+        return EventAwaiter<E, AcceptAnyEvent>(*this, {}, executor);
+    }
 
-    // 批量处理
+    // 批量同步分发。事件按类型分组，每个监听器依次处理同类型的全部事件；
+    // 同类型事件保持相对顺序，不同类型之间不保证与输入顺序一致
     void processBatch(const std::vector<EventPtr>& events);
 
+    // -----------------------------
+    // 帧阶段通道
+    // -----------------------------
+
+    // 投递到帧阶段通道（任意线程），事件在下一次交换缓冲区后对消费者可见
+    void postToFrame(EventPtr event) const;
+
+    // 每帧由主循环调用一次，将本帧投递的事件按类型分组后移入前台
+    void swapFrameBuffers();
+
+    // 上一次交换得到的事件，只应在调用 swapFrameBuffers() 的线程上访问
+    XIHE_NODISCARD const FrameEvents& getFrameEvents() const;
+
     // -----------------------------
     // 队列管理
     // -----------------------------
@@ -206,31 +364,116 @@ public:
     {
         u64 dispatchedCount  = 0; // 已分发的事件数量
         u64 queuedCount      = 0; // 已排队的事件数量
+        u64 coalescedCount   = 0; // 入队时被合并到待处理事件中的数量
+        u64 droppedNewest    = 0; // 队列已满时被丢弃的新事件数量
+        u64 droppedEvicted   = 0; // 队列已满时被驱逐的待处理事件数量
+        Size pendingCount    = 0; // 当前等待处理的事件数量
         Size subscriberCount = 0; // 订阅者数量
     };
 
     XIHE_NODISCARD u64 getDispatchedCount() const;
     XIHE_NODISCARD u64 getQueuedCount() const;
+    XIHE_NODISCARD u64 getCoalescedCount() const;
+    XIHE_NODISCARD u64 getDroppedCount() const;
+    XIHE_NODISCARD Size getPendingCount() const;
     XIHE_NODISCARD Size getSubscriberCount() const;
     XIHE_NODISCARD Statistics getStatistics() const;
 
+    XIHE_NODISCARD Size getQueueWorkerCount() const;
+    XIHE_NODISCARD Size getShardCount() const;
+
+    // -----------------------------
+    // 耗时统计
+    // -----------------------------
+
+    void setMetricsEnabled(bool enabled);
+    XIHE_NODISCARD bool isMetricsEnabled() const;
+
+    // 汇总所有线程的统计数据
+    XIHE_NODISCARD EventMetricsSnapshot getMetricsSnapshot() const;
+    void resetMetrics();
+
+    // -----------------------------
+    // 观察者
+    // -----------------------------
+
+    // 设置观察者，传入 nullptr 取消。返回时旧观察者已不再被调用，
+    // 因此不能在事件处理函数中调用
+    void setObserver(IEventObserver* observer);
+    XIHE_NODISCARD IEventObserver* getObserver() const;
+
 private:
+    template <cEventType E, typename F>
+    friend class EventAwaiter;
+
     class Impl;
     std::unique_ptr<Impl> _pImpl;
 
-    Handle subscribeDirectImpl(std::type_index eventType, GenericEventCallback callback) const;
-    Handle subscribeQueuedImpl(std::type_index eventType, GenericEventCallback callback) const;
+    void addWaiter(EventWaiter& waiter) const;
+
+    Handle subscribeDirectImpl(EventTypeIndex eventType, GenericEventCallback callback, const EventMask& mask = {}) const;
+    Handle subscribeQueuedImpl(EventTypeIndex eventType, GenericEventCallback callback, const EventMask& mask = {}) const;
+
+    template <cEventType E>
+    static GenericEventCallback WrapFilteredCallback(EventCallback<E> inListener, EventFilter<E> inFilter)
+    {
+        return WrapCallback<E>([listener = std::move(inListener), filter = std::move(inFilter)](const E& event)
+        {
+            if (filter(event))
+            {
+                listener(event);
+            }
+        });
+    }
+};
+
+// co_await bus.next<E>() 返回的等待对象，恢复后得到匹配的事件
+template <cEventType E, typename F>
+class EventAwaiter : EventWaiter
+{
+public:
+    EventAwaiter(const EventBus& bus, F filter, ICoroutineExecutor* inExecutor) :
+        _bus(&bus), _filter(std::move(filter))
+    {
+        eventType = EventTypeIndexOf<E>();
+        executor  = inExecutor;
+        match     = [](const EventWaiter& waiter, const IEvent& event)
+        {
+            return static_cast<const EventAwaiter&>(waiter)._filter(static_cast<const E&>(event));
+        };
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> inHandle)
+    {
+        // 注册后协程可能立即在其他线程上恢复，之后不能再访问 this
+        handle = inHandle;
+        _bus->addWaiter(*this);
+    }
+
+    SharedPtr<const E> await_resume() noexcept
+    {
+        return std::static_pointer_cast<const E>(std::move(event));
+    }
+
+private:
+    const EventBus* _bus;
+    F _filter;
 };
 
 template <cEventType E>
 Handle EventBus::subscribeDirect(EventCallback<E> listener)
 {
-    return subscribeDirectImpl(EventTypeId<E>(), WrapCallback<E>(std::move(listener)));
+    return subscribeDirectImpl(EventTypeIndexOf<E>(), WrapCallback<E>(std::move(listener)));
 }
 
 template <cEventType E>
 Handle EventBus::subscribeQueued(EventCallback<E> listener)
 {
-    return subscribeQueuedImpl(EventTypeId<E>(), WrapCallback<E>(std::move(listener)));
+    return subscribeQueuedImpl(EventTypeIndexOf<E>(), WrapCallback<E>(std::move(listener)));
 }
 } // namespace xihe
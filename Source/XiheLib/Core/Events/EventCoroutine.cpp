@@ -0,0 +1,96 @@
+/**
+ * @File EventCoroutine.cpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/9/23
+ * @Brief This file is part of Xihe.
+ */
+
+#include "EventCoroutine.hpp"
+#include "Core/Memory/Memory.hpp"
+
+#include <array>
+
+using namespace xihe;
+
+namespace {
+constexpr Size kFrameGranularity  = 64;
+constexpr Size kFrameClassCount   = kMaxPooledFrameSize / kFrameGranularity;
+constexpr Size kMaxCachedPerClass = 64;
+
+struct FreeFrame
+{
+    FreeFrame* next;
+};
+
+// 线程本地的空闲帧缓存，线程退出时归还给 mimalloc
+struct FrameCache
+{
+    std::array<FreeFrame*, kFrameClassCount> heads{};
+    std::array<Size, kFrameClassCount> counts{};
+
+    ~FrameCache()
+    {
+        for (auto* head : heads)
+        {
+            while (head)
+            {
+                auto* next = head->next;
+                mi_free(head);
+                head = next;
+            }
+        }
+    }
+
+    static FrameCache& Get()
+    {
+        thread_local FrameCache cache;
+        return cache;
+    }
+};
+
+constexpr Size FrameClass(Size size)
+{
+    return (size - 1) / kFrameGranularity;
+}
+} // namespace
+
+void* xihe::AllocateCoroutineFrame(Size size)
+{
+    if (size == 0 || size > kMaxPooledFrameSize)
+        return mi_malloc(size);
+
+    const auto index = FrameClass(size);
+    auto& cache      = FrameCache::Get();
+    if (auto* frame = cache.heads[index])
+    {
+        cache.heads[index] = frame->next;
+        --cache.counts[index];
+        return frame;
+    }
+    return mi_malloc((index + 1) * kFrameGranularity);
+}
+
+void xihe::FreeCoroutineFrame(void* ptr, Size size) noexcept
+{
+    if (!ptr)
+        return;
+
+    if (size == 0 || size > kMaxPooledFrameSize)
+    {
+        mi_free(ptr);
+        return;
+    }
+
+    const auto index = FrameClass(size);
+    auto& cache      = FrameCache::Get();
+    if (cache.counts[index] >= kMaxCachedPerClass)
+    {
+        mi_free(ptr);
+        return;
+    }
+
+    auto* frame        = static_cast<FreeFrame*>(ptr);
+    frame->next        = cache.heads[index];
+    cache.heads[index] = frame;
+    ++cache.counts[index];
+}
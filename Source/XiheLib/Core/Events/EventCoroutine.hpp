@@ -0,0 +1,162 @@
+/**
+ * @File EventCoroutine.hpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/9/23
+ * @Brief This file is part of Xihe.
+ */
+
+#pragma once
+
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <mutex>
+
+#include "Core/Base/Defines.hpp"
+#include "Core/Events/Event.hpp"
+
+namespace xihe {
+// ======================================
+// 协程帧内存池
+//
+// 按 64 字节分级缓存在线程本地，跨线程释放的帧进入释放线程的缓存；
+// 超过 kMaxPooledFrameSize 的帧直接向 mimalloc 申请。
+
+constexpr Size kMaxPooledFrameSize = 1024;
+
+XIHE_API void* AllocateCoroutineFrame(Size size);
+XIHE_API void FreeCoroutineFrame(void* ptr, Size size) noexcept;
+
+// ======================================
+// 协程恢复执行的位置
+
+class ICoroutineExecutor
+{
+public:
+    virtual ~ICoroutineExecutor() = default;
+
+    virtual void post(std::coroutine_handle<> handle) = 0;
+};
+
+// 由使用者在指定线程上调用 runPending() 恢复协程，例如主线程每帧一次
+class ManualExecutor final : public ICoroutineExecutor
+{
+public:
+    ~ManualExecutor() override
+    {
+        runPending();
+    }
+
+    void post(std::coroutine_handle<> handle) override
+    {
+        std::lock_guard lock(_mutex);
+        _pending.push_back(handle);
+    }
+
+    // 恢复当前已提交的协程，执行期间新提交的协程留到下一次，返回恢复的数量
+    Size runPending()
+    {
+        std::deque<std::coroutine_handle<>> pending;
+        {
+            std::lock_guard lock(_mutex);
+            pending.swap(_pending);
+        }
+
+        for (auto handle : pending)
+            handle.resume();
+        return pending.size();
+    }
+
+    XIHE_NODISCARD Size pendingCount() const
+    {
+        std::lock_guard lock(_mutex);
+        return _pending.size();
+    }
+
+private:
+    mutable std::mutex _mutex;
+    std::deque<std::coroutine_handle<>> _pending;
+};
+
+// ======================================
+// 事件协程
+
+/**
+ * @brief 立即开始执行、结束后自动释放的事件协程
+ *
+ *   EventTask WaitForClose(EventBus& bus)
+ *   {
+ *       auto event = co_await bus.next<WindowCloseEvent>();
+ *       ...
+ *   }
+ *
+ * 协程帧从帧内存池分配。未捕获的异常会终止程序，与 std::thread 的行为一致。
+ */
+class EventTask
+{
+public:
+    struct promise_type
+    {
+        EventTask get_return_object() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void return_void() noexcept
+        {
+        }
+
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+
+        static void* operator new(Size size)
+        {
+            return AllocateCoroutineFrame(size);
+        }
+
+        static void operator delete(void* ptr, Size size) noexcept
+        {
+            FreeCoroutineFrame(ptr, size);
+        }
+    };
+};
+
+/**
+ * @brief 一次性的事件等待者，内嵌在协程帧中的等待对象里，注册与触发都不分配内存
+ *
+ * 总线在匹配的事件分发后（同步分发）或处理后（队列分发）将其移出等待表并恢复协程。
+ */
+struct EventWaiter
+{
+    using MatchFunc = bool (*)(const EventWaiter&, const IEvent&);
+
+    EventTypeIndex eventType       = kInvalidEventTypeIndex;
+    MatchFunc match                = nullptr;
+    ICoroutineExecutor* executor   = nullptr; // 为空时在分发事件的线程上直接恢复
+    std::coroutine_handle<> handle = nullptr;
+    EventPtr event;                           // 恢复前写入，总线析构时为空
+    EventWaiter* next = nullptr;
+};
+
+// next<E>() 未指定过滤器时接受所有事件
+struct AcceptAnyEvent
+{
+    template <typename E>
+    constexpr bool operator()(const E&) const noexcept
+    {
+        return true;
+    }
+};
+} // namespace xihe
@@ -0,0 +1,124 @@
+/**
+ * @File EventMetrics.hpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/9/21
+ * @Brief This file is part of Xihe.
+ */
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <string>
+#include <vector>
+#include <format>
+#include <algorithm>
+
+#include "Core/Base/Defines.hpp"
+#include "Core/Events/Event.hpp"
+
+namespace xihe {
+/**
+ * @brief 以 2 的幂为桶宽的耗时直方图（纳秒）
+ *
+ * 第 0 个桶统计 0ns，第 i 个桶统计 [2^(i-1), 2^i) ns，最后一个桶包含所有更大的值。
+ */
+struct LatencyHistogram
+{
+    static constexpr Size kBucketCount = 32;
+
+    std::array<u64, kBucketCount> buckets{};
+    u64 count   = 0;
+    u64 totalNs = 0;
+    u64 maxNs   = 0;
+
+    void record(u64 ns)
+    {
+        ++buckets[std::min<Size>(std::bit_width(ns), kBucketCount - 1)];
+        ++count;
+        totalNs += ns;
+        maxNs = std::max(maxNs, ns);
+    }
+
+    void merge(const LatencyHistogram& other)
+    {
+        for (Size i = 0; i < kBucketCount; ++i)
+            buckets[i] += other.buckets[i];
+        count += other.count;
+        totalNs += other.totalNs;
+        maxNs = std::max(maxNs, other.maxNs);
+    }
+
+    XIHE_NODISCARD f64 meanNs() const
+    {
+        return count == 0 ? 0.0 : As<f64>(totalNs) / As<f64>(count);
+    }
+
+    // 返回百分位所在桶的上界，p 取值 [0, 1]
+    XIHE_NODISCARD u64 percentileNs(f64 p) const
+    {
+        if (count == 0)
+            return 0;
+
+        const auto target = std::max<u64>(1, As<u64>(p * As<f64>(count) + 0.5));
+        u64 seen          = 0;
+        for (Size i = 0; i < kBucketCount; ++i)
+        {
+            seen += buckets[i];
+            if (seen >= target)
+                return std::min(i == 0 ? 0 : (u64{1} << i) - 1, maxNs);
+        }
+        return maxNs;
+    }
+};
+
+// 单个事件类型的统计
+struct EventTypeMetrics
+{
+    EventTypeIndex typeIndex = kInvalidEventTypeIndex;
+    std::string typeName;
+
+    u64 dispatchCount = 0; // 同步分发次数（包括批量分发）
+    u64 queuedCount   = 0; // 队列分发次数
+
+    LatencyHistogram queueWait;   // 入队到开始处理的等待时间
+    LatencyHistogram handlerTime; // 单个事件所有监听器的总执行时间
+};
+
+// 单个监听器的统计
+struct ListenerMetrics
+{
+    u64 handle               = 0;
+    EventTypeIndex typeIndex = kInvalidEventTypeIndex;
+
+    LatencyHistogram executionTime; // 每次调用的执行时间
+};
+
+struct EventMetricsSnapshot
+{
+    std::vector<EventTypeMetrics> types;
+    std::vector<ListenerMetrics> listeners;
+
+    XIHE_NODISCARD std::string toString() const
+    {
+        std::string result = "EventBus metrics:\n";
+        for (const auto& type : types)
+        {
+            result += std::format("  {} dispatch={} queued={} wait(mean={:.0f}ns p99={}ns max={}ns) "
+                                  "handlers(mean={:.0f}ns p99={}ns max={}ns)\n",
+                                  type.typeName, type.dispatchCount, type.queuedCount,
+                                  type.queueWait.meanNs(), type.queueWait.percentileNs(0.99), type.queueWait.maxNs,
+                                  type.handlerTime.meanNs(), type.handlerTime.percentileNs(0.99),
+                                  type.handlerTime.maxNs);
+        }
+        for (const auto& listener : listeners)
+        {
+            result += std::format("  listener #{} (type {}) calls={} mean={:.0f}ns p99={}ns max={}ns\n",
+                                  listener.handle, listener.typeIndex, listener.executionTime.count,
+                                  listener.executionTime.meanNs(), listener.executionTime.percentileNs(0.99),
+                                  listener.executionTime.maxNs);
+        }
+        return result;
+    }
+};
+} // namespace xihe
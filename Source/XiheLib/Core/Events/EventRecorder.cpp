@@ -0,0 +1,273 @@
+/**
+ * @File EventRecorder.cpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/9/22
+ * @Brief This file is part of Xihe.
+ */
+
+#include "EventRecorder.hpp"
+
+#include <atomic>
+#include <iterator>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <unordered_map>
+
+using namespace xihe;
+
+namespace {
+constexpr char kMagic[4] = {'X', 'E', 'V', 'R'};
+constexpr u8 kVersion    = 1;
+
+enum class RecordTag : u8
+{
+    TypeDef        = 0,
+    Dispatch       = 1,
+    Enqueue        = 2,
+    EnqueueOrdered = 3, // 带 orderKey 的入队
+};
+} // namespace
+
+// ======================================
+
+class EventRecorder::Impl
+{
+public:
+    explicit Impl(std::ostream& out) :
+        out(out)
+    {
+        out.write(kMagic, sizeof(kMagic));
+        out.put(As<char>(kVersion));
+    }
+
+    void record(RecordTag tag, const EventPtr& event, EventPriority priority, std::optional<u64> orderKey)
+    {
+        const auto* codec = EventCodecRegistry::FindByType(event->typeIndex());
+        if (!codec)
+        {
+            skippedCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        // 先在锁外编码负载，锁内只写入记录
+        thread_local EventWriter tPayload;
+        tPayload.clear();
+        codec->encode(*event, tPayload);
+
+        std::lock_guard lock(mutex);
+        writer.clear();
+
+        auto [it, inserted] = codecIds.try_emplace(codec, As<u32>(codecIds.size()));
+        if (inserted)
+        {
+            writer.write(static_cast<u8>(RecordTag::TypeDef));
+            writer.writeVarint(it->second);
+            writer.writeString(codec->name);
+        }
+
+        // 时间从第一条记录开始计算
+        const auto now = Clock::now();
+        if (recordedCount == 0)
+            lastTime = now;
+        writer.write(static_cast<u8>(tag));
+        writer.writeVarint(As<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - lastTime).count()));
+        writer.writeVarint(it->second);
+        writer.write(static_cast<u8>(priority));
+        if (orderKey)
+            writer.writeVarint(*orderKey);
+        writer.writeVarint(tPayload.data().size());
+        writer.writeBytes(tPayload.data());
+        lastTime = now;
+
+        out.write(reinterpret_cast<const char*>(writer.data().data()), As<std::streamsize>(writer.data().size()));
+        ++recordedCount;
+    }
+
+    std::ostream& out;
+    std::mutex mutex;
+    EventWriter writer;
+    std::unordered_map<const EventCodecRegistry::Codec*, u32> codecIds;
+    TimePoint lastTime;
+    u64 recordedCount  = 0;
+    std::atomic<u64> skippedCount{0};
+
+    EventBus* bus = nullptr;
+};
+
+EventRecorder::EventRecorder(std::ostream& out) :
+    _pImpl(std::make_unique<Impl>(out))
+{
+}
+
+EventRecorder::~EventRecorder()
+{
+    detach();
+    flush();
+}
+
+void EventRecorder::attach(EventBus& bus)
+{
+    detach();
+    _pImpl->bus = &bus;
+    bus.setObserver(this);
+}
+
+void EventRecorder::detach()
+{
+    if (_pImpl->bus)
+    {
+        if (_pImpl->bus->getObserver() == this)
+            _pImpl->bus->setObserver(nullptr);
+        _pImpl->bus = nullptr;
+    }
+}
+
+void EventRecorder::flush()
+{
+    std::lock_guard lock(_pImpl->mutex);
+    _pImpl->out.flush();
+}
+
+u64 EventRecorder::getRecordedCount() const
+{
+    std::lock_guard lock(_pImpl->mutex);
+    return _pImpl->recordedCount;
+}
+
+u64 EventRecorder::getSkippedCount() const
+{
+    return _pImpl->skippedCount.load();
+}
+
+void EventRecorder::onDispatch(const EventPtr& event)
+{
+    _pImpl->record(RecordTag::Dispatch, event, event->getPriority(), std::nullopt);
+}
+
+void EventRecorder::onEnqueue(const EventPtr& event, EventPriority priority, std::optional<u64> orderKey)
+{
+    _pImpl->record(orderKey ? RecordTag::EnqueueOrdered : RecordTag::Enqueue, event, priority, orderKey);
+}
+
+// ======================================
+
+class EventReplayer::Impl
+{
+public:
+    explicit Impl(std::istream& in)
+    {
+        const std::vector<u8> data{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+        EventReader reader(data);
+
+        for (const char c : kMagic)
+        {
+            if (reader.read<char>() != c)
+                XIHE_THROW("EventReplayer: 不是事件录制文件");
+        }
+        if (const auto version = reader.read<u8>(); version != kVersion)
+            XIHE_THROW("EventReplayer: 不支持的录制版本 {}", version);
+
+        // 录制文件中的编号 -> 当前进程的编码器，未注册的类型为 nullptr
+        std::unordered_map<u64, const EventCodecRegistry::Codec*> codecs;
+        Duration offset{};
+
+        while (!reader.atEnd())
+        {
+            const auto tag = static_cast<RecordTag>(reader.read<u8>());
+            if (tag == RecordTag::TypeDef)
+            {
+                const auto id   = reader.readVarint();
+                const auto name = reader.readString();
+                codecs[id]      = EventCodecRegistry::FindByName(name);
+                continue;
+            }
+            if (tag != RecordTag::Dispatch && tag != RecordTag::Enqueue && tag != RecordTag::EnqueueOrdered)
+                XIHE_THROW("EventReplayer: 未知的记录类型 {}", static_cast<u32>(tag));
+
+            offset += std::chrono::duration_cast<Duration>(std::chrono::nanoseconds(reader.readVarint()));
+
+            Record record;
+            record.kind   = tag == RecordTag::Dispatch ? RecordKind::Dispatch : RecordKind::Enqueue;
+            record.offset = offset;
+
+            const auto id = reader.readVarint();
+            auto it       = codecs.find(id);
+            if (it == codecs.end())
+                XIHE_THROW("EventReplayer: 记录引用了未定义的类型编号 {}", id);
+
+            record.priority = static_cast<EventPriority>(reader.read<u8>());
+            if (tag == RecordTag::EnqueueOrdered)
+                record.orderKey = reader.readVarint();
+
+            const auto payload = reader.readBytes(As<Size>(reader.readVarint()));
+            if (!it->second)
+            {
+                ++skippedCount;
+                continue;
+            }
+
+            record.codec = it->second;
+            record.payload.assign(payload.begin(), payload.end());
+            records.push_back(std::move(record));
+        }
+        duration = offset;
+    }
+
+    std::vector<Record> records;
+    Duration duration{};
+    u64 skippedCount = 0;
+};
+
+EventReplayer::EventReplayer(std::istream& in) :
+    _pImpl(std::make_unique<Impl>(in))
+{
+}
+
+EventReplayer::~EventReplayer() = default;
+
+const std::vector<EventReplayer::Record>& EventReplayer::getRecords() const
+{
+    return _pImpl->records;
+}
+
+Duration EventReplayer::getDuration() const
+{
+    return _pImpl->duration;
+}
+
+u64 EventReplayer::getSkippedCount() const
+{
+    return _pImpl->skippedCount;
+}
+
+Size EventReplayer::replay(EventBus& bus, Speed speed) const
+{
+    // 提前解码，避免解码开销混入回放节奏
+    std::vector<EventPtr> events;
+    events.reserve(_pImpl->records.size());
+    for (const auto& record : _pImpl->records)
+    {
+        EventReader reader(record.payload);
+        auto event = record.codec->decode(reader);
+        event->setPriority(record.priority);
+        events.push_back(std::move(event));
+    }
+
+    const auto start = Clock::now();
+    for (Size i = 0; i < events.size(); ++i)
+    {
+        const auto& record = _pImpl->records[i];
+        if (speed == Speed::Original)
+            std::this_thread::sleep_until(start + record.offset);
+
+        if (record.kind == RecordKind::Dispatch)
+            bus.dispatch(std::move(events[i]));
+        else if (record.orderKey)
+            bus.enqueue(std::move(events[i]), record.priority, *record.orderKey);
+        else
+            bus.enqueue(std::move(events[i]), record.priority);
+    }
+    return events.size();
+}
@@ -0,0 +1,104 @@
+/**
+ * @File EventRecorder.hpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/9/22
+ * @Brief This file is part of Xihe.
+ */
+
+#pragma once
+
+#include <iosfwd>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "Core/Events/EventBus.hpp"
+#include "Core/Events/EventSerialization.hpp"
+
+namespace xihe {
+/**
+ * @brief 将经过 EventBus 的事件录制为紧凑的二进制流
+ *
+ * 只录制通过 EventCodecRegistry 注册过的事件类型，其余类型计入 getSkippedCount()。
+ * 流格式：
+ *   头部    "XEVR" + u8 版本
+ *   类型    u8 kind=TypeDef, varint 编号, string 名称（首次出现时写入）
+ *   事件    u8 kind, varint 距上一条记录的纳秒数, varint 类型编号, u8 优先级,
+ *           [varint orderKey], varint 负载长度, 负载
+ */
+class XIHE_API EventRecorder final : public IEventObserver
+{
+public:
+    // 流的生命周期需长于录制器
+    explicit EventRecorder(std::ostream& out);
+    ~EventRecorder() override;
+
+    EventRecorder(const EventRecorder&)            = delete;
+    EventRecorder& operator=(const EventRecorder&) = delete;
+
+    // 开始录制总线上的事件，同一时间只能录制一条总线
+    void attach(EventBus& bus);
+    void detach();
+
+    void flush();
+
+    XIHE_NODISCARD u64 getRecordedCount() const;
+    XIHE_NODISCARD u64 getSkippedCount() const;
+
+    void onDispatch(const EventPtr& event) override;
+    void onEnqueue(const EventPtr& event, EventPriority priority, std::optional<u64> orderKey) override;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> _pImpl;
+};
+
+/**
+ * @brief 回放 EventRecorder 录制的事件流
+ *
+ * 构造时读取整个流，流格式错误时抛出异常；当前进程未注册的事件类型会被跳过。
+ * 每次回放前重新解码全部事件，因此同一录制可以多次回放。
+ */
+class XIHE_API EventReplayer
+{
+public:
+    enum class Speed : u8
+    {
+        Original, // 按录制时的时间间隔回放
+        Maximum,  // 不等待，尽快回放
+    };
+
+    enum class RecordKind : u8
+    {
+        Dispatch,
+        Enqueue,
+    };
+
+    struct Record
+    {
+        RecordKind kind = RecordKind::Dispatch;
+        Duration offset{};                     // 距第一条记录的时间
+        const EventCodecRegistry::Codec* codec = nullptr;
+        EventPriority priority                 = EventPriority::Normal;
+        std::optional<u64> orderKey;
+        std::vector<u8> payload;
+    };
+
+    explicit EventReplayer(std::istream& in);
+    ~EventReplayer();
+
+    EventReplayer(const EventReplayer&)            = delete;
+    EventReplayer& operator=(const EventReplayer&) = delete;
+
+    XIHE_NODISCARD const std::vector<Record>& getRecords() const;
+    XIHE_NODISCARD Duration getDuration() const;
+    XIHE_NODISCARD u64 getSkippedCount() const;
+
+    // 将录制的事件依次送入总线，返回回放的事件数量
+    Size replay(EventBus& bus, Speed speed = Speed::Maximum) const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> _pImpl;
+};
+} // namespace xihe
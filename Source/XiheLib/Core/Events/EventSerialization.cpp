@@ -0,0 +1,65 @@
+/**
+ * @File EventSerialization.cpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/9/22
+ * @Brief This file is part of Xihe.
+ */
+
+#include "EventSerialization.hpp"
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+using namespace xihe;
+
+namespace {
+struct CodecStorage
+{
+    std::mutex mutex;
+    std::deque<EventCodecRegistry::Codec> codecs; // deque 保证已返回的指针不会失效
+    std::unordered_map<EventTypeIndex, const EventCodecRegistry::Codec*> byType;
+    std::unordered_map<std::string_view, const EventCodecRegistry::Codec*> byName;
+
+    static CodecStorage& Get()
+    {
+        static CodecStorage storage;
+        return storage;
+    }
+};
+} // namespace
+
+void EventCodecRegistry::Add(Codec codec)
+{
+    auto& storage = CodecStorage::Get();
+
+    std::lock_guard lock(storage.mutex);
+    if (auto it = storage.byType.find(codec.typeIndex); it != storage.byType.end())
+    {
+        XIHE_CHECK(it->second->name == codec.name, "事件类型已以名称 '{}' 注册，不能再注册为 '{}'", it->second->name, codec.name);
+        return;
+    }
+    XIHE_CHECK(!storage.byName.contains(codec.name), "事件序列化名称 '{}' 已被其他类型使用", codec.name);
+
+    const auto& stored = storage.codecs.emplace_back(std::move(codec));
+    storage.byType.emplace(stored.typeIndex, &stored);
+    storage.byName.emplace(stored.name, &stored);
+}
+
+const EventCodecRegistry::Codec* EventCodecRegistry::FindByType(EventTypeIndex typeIndex)
+{
+    auto& storage = CodecStorage::Get();
+
+    std::lock_guard lock(storage.mutex);
+    auto it = storage.byType.find(typeIndex);
+    return it != storage.byType.end() ? it->second : nullptr;
+}
+
+const EventCodecRegistry::Codec* EventCodecRegistry::FindByName(std::string_view name)
+{
+    auto& storage = CodecStorage::Get();
+
+    std::lock_guard lock(storage.mutex);
+    auto it = storage.byName.find(name);
+    return it != storage.byName.end() ? it->second : nullptr;
+}
@@ -0,0 +1,182 @@
+/**
+ * @File EventSerialization.hpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/9/22
+ * @Brief This file is part of Xihe.
+ */
+
+#pragma once
+
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "Core/Base/Defines.hpp"
+#include "Core/Base/Error.hpp"
+#include "Core/Events/Event.hpp"
+
+namespace xihe {
+// 紧凑的二进制写入器，整数使用变长编码，其余平凡类型按内存布局写入
+class EventWriter
+{
+public:
+    template <typename T> requires std::is_trivially_copyable_v<T>
+    void write(const T& value)
+    {
+        const auto* bytes = reinterpret_cast<const u8*>(&value);
+        _buffer.insert(_buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    void writeVarint(u64 value)
+    {
+        while (value >= 0x80)
+        {
+            _buffer.push_back(As<u8>(value | 0x80));
+            value >>= 7;
+        }
+        _buffer.push_back(As<u8>(value));
+    }
+
+    void writeString(std::string_view str)
+    {
+        writeVarint(str.size());
+        _buffer.insert(_buffer.end(), str.begin(), str.end());
+    }
+
+    void writeBytes(std::span<const u8> bytes)
+    {
+        _buffer.insert(_buffer.end(), bytes.begin(), bytes.end());
+    }
+
+    XIHE_NODISCARD const std::vector<u8>& data() const
+    {
+        return _buffer;
+    }
+
+    void clear()
+    {
+        _buffer.clear();
+    }
+
+private:
+    std::vector<u8> _buffer;
+};
+
+// 与 EventWriter 对应的读取器，数据不完整时抛出异常
+class EventReader
+{
+public:
+    explicit EventReader(std::span<const u8> data) :
+        _data(data)
+    {
+    }
+
+    template <typename T> requires std::is_trivially_copyable_v<T>
+    T read()
+    {
+        require(sizeof(T));
+        T value;
+        std::memcpy(&value, _data.data() + _pos, sizeof(T));
+        _pos += sizeof(T);
+        return value;
+    }
+
+    u64 readVarint()
+    {
+        u64 value = 0;
+        for (u32 shift = 0; shift < 64; shift += 7)
+        {
+            require(1);
+            const u8 byte = _data[_pos++];
+            value |= As<u64>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0)
+                return value;
+        }
+        XIHE_THROW("EventReader: 变长整数编码无效");
+    }
+
+    std::string readString()
+    {
+        const auto size = As<Size>(readVarint());
+        require(size);
+        std::string str(reinterpret_cast<const char*>(_data.data() + _pos), size);
+        _pos += size;
+        return str;
+    }
+
+    std::span<const u8> readBytes(Size size)
+    {
+        require(size);
+        auto bytes = _data.subspan(_pos, size);
+        _pos += size;
+        return bytes;
+    }
+
+    XIHE_NODISCARD bool atEnd() const
+    {
+        return _pos >= _data.size();
+    }
+
+private:
+    void require(Size size) const
+    {
+        if (_data.size() - _pos < size)
+            XIHE_THROW("EventReader: 数据不完整，需要 {} 字节，剩余 {} 字节", size, _data.size() - _pos);
+    }
+
+    std::span<const u8> _data;
+    Size _pos = 0;
+};
+
+/**
+ * @brief 可序列化的事件类型
+ *
+ * 事件类型需要提供：
+ *   void serialize(EventWriter& writer) const;
+ *   static E Deserialize(EventReader& reader);
+ * 并通过 EventCodecRegistry::Register<E>(name) 注册后才会被录制。
+ */
+template <typename E>
+concept cSerializableEvent = cEventType<E> && requires(const E& event, EventWriter& writer, EventReader& reader)
+{
+    { event.serialize(writer) } -> std::same_as<void>;
+    { E::Deserialize(reader) } -> std::convertible_to<E>;
+};
+
+// 事件序列化注册表，名称在录制文件中标识事件类型，需在各次运行间保持不变
+class XIHE_API EventCodecRegistry
+{
+public:
+    using EncodeFunc = void (*)(const IEvent&, EventWriter&);
+    using DecodeFunc = EventPtr (*)(EventReader&);
+
+    struct Codec
+    {
+        std::string name;
+        EventTypeIndex typeIndex = kInvalidEventTypeIndex;
+        EncodeFunc encode        = nullptr;
+        DecodeFunc decode        = nullptr;
+    };
+
+    template <cSerializableEvent E>
+    static void Register(std::string_view name)
+    {
+        Add(Codec{
+            std::string(name),
+            EventTypeIndexOf<E>(),
+            [](const IEvent& event, EventWriter& writer) { static_cast<const E&>(event).serialize(writer); },
+            [](EventReader& reader) -> EventPtr { return MakeShared<E>(E::Deserialize(reader)); },
+        });
+    }
+
+    // 返回的指针在程序运行期间保持有效
+    static const Codec* FindByType(EventTypeIndex typeIndex);
+    static const Codec* FindByName(std::string_view name);
+
+private:
+    static void Add(Codec codec);
+};
+} // namespace xihe
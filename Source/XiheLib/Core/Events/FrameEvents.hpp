@@ -0,0 +1,119 @@
+/**
+ * @File FrameEvents.hpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/9/24
+ * @Brief This file is part of Xihe.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+#include "Core/Base/Defines.hpp"
+#include "Core/Events/Event.hpp"
+
+namespace xihe {
+/**
+ * @brief 一帧内投递到帧阶段通道的事件，按类型连续存放
+ *
+ * 同一类型的事件在同一线程内保持投递顺序，不同线程之间的顺序不确定。
+ * 内容在下一次 EventBus::swapFrameBuffers() 之前保持不变。
+ */
+class FrameEvents
+{
+public:
+    XIHE_NODISCARD std::span<const EventPtr> all() const
+    {
+        return _events;
+    }
+
+    XIHE_NODISCARD std::span<const EventPtr> ofType(EventTypeIndex type) const
+    {
+        if (type + 1 >= _offsets.size())
+            return {};
+        return std::span(_events).subspan(_offsets[type], _offsets[type + 1] - _offsets[type]);
+    }
+
+    template <cEventType E>
+    XIHE_NODISCARD std::span<const EventPtr> ofType() const
+    {
+        return ofType(EventTypeIndexOf<E>());
+    }
+
+    template <cEventType E, typename F>
+    void forEach(F&& func) const
+    {
+        for (const auto& event : ofType<E>())
+            func(static_cast<const E&>(*event));
+    }
+
+    XIHE_NODISCARD Size size() const
+    {
+        return _events.size();
+    }
+
+    XIHE_NODISCARD bool empty() const
+    {
+        return _events.empty();
+    }
+
+    // 第几帧，每次交换缓冲区加 1
+    XIHE_NODISCARD u64 frameIndex() const
+    {
+        return _frameIndex;
+    }
+
+    // 由 EventBus 在交换缓冲区时调用：按类型计数排序，移出 sources 中未取消的事件
+    void build(std::span<std::vector<EventPtr>> sources)
+    {
+        ++_frameIndex;
+        _events.clear();
+        std::fill(_offsets.begin(), _offsets.end(), 0);
+
+        // 先记录每个事件的类型，两遍扫描之间被取消的事件仍按第一遍的结果放置
+        _types.clear();
+        for (const auto& source : sources)
+        {
+            for (const auto& event : source)
+            {
+                if (!event || event->isCancelled())
+                {
+                    _types.push_back(kInvalidEventTypeIndex);
+                    continue;
+                }
+
+                const auto type = event->typeIndex();
+                if (_offsets.size() < type + 2)
+                    _offsets.resize(type + 2, 0);
+                ++_offsets[type + 1];
+                _types.push_back(type);
+            }
+        }
+
+        for (Size i = 1; i < _offsets.size(); ++i)
+            _offsets[i] += _offsets[i - 1];
+
+        _events.resize(_offsets.empty() ? 0 : _offsets.back());
+        _cursor.assign(_offsets.begin(), _offsets.end());
+
+        Size index = 0;
+        for (auto& source : sources)
+        {
+            for (auto& event : source)
+            {
+                if (const auto type = _types[index++]; type != kInvalidEventTypeIndex)
+                    _events[_cursor[type]++] = std::move(event);
+            }
+        }
+    }
+
+private:
+    std::vector<EventPtr> _events;
+    std::vector<u32> _offsets; // 类型 i 的事件位于 [_offsets[i], _offsets[i + 1])
+    std::vector<u32> _cursor;
+    std::vector<EventTypeIndex> _types;
+    u64 _frameIndex = 0;
+};
+} // namespace xihe
@@ -0,0 +1,309 @@
+/**
+ * @File SharedEventRing.cpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/9/25
+ * @Brief This file is part of Xihe.
+ */
+
+#include "SharedEventRing.hpp"
+#include "Core/Base/Error.hpp"
+
+#include <bit>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+#ifndef XIHE_ON_WINDOWS
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+using namespace xihe;
+
+namespace {
+constexpr Size kDataOffset = (sizeof(SharedEventRingHeader) + 63) / 64 * 64;
+
+constexpr u64 AlignRecord(u64 size)
+{
+    return (size + kSharedEventAlignment - 1) / kSharedEventAlignment * kSharedEventAlignment;
+}
+
+// 命名共享内存的映射，创建者在析构时删除名称
+class SharedMemoryRegion
+{
+public:
+    SharedMemoryRegion() = default;
+
+    ~SharedMemoryRegion()
+    {
+        close();
+    }
+
+    SharedMemoryRegion(const SharedMemoryRegion&)            = delete;
+    SharedMemoryRegion& operator=(const SharedMemoryRegion&) = delete;
+
+    void create(std::string_view name, Size size)
+    {
+        _name  = MakeName(name);
+        _size  = size;
+        _owner = true;
+
+#ifdef XIHE_ON_WINDOWS
+        _mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, As<DWORD>(As<u64>(size) >> 32),
+                                      As<DWORD>(size & 0xffffffff), _name.c_str());
+        if (!_mapping)
+            XIHE_THROW("无法创建共享内存 '{}'：{}", _name, GetLastError());
+        _address = MapViewOfFile(_mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+#else
+        // 上一次运行遗留的同名对象直接替换
+        shm_unlink(_name.c_str());
+        const int fd = shm_open(_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0)
+            XIHE_THROW("无法创建共享内存 '{}'：{}", _name, errno);
+        if (ftruncate(fd, As<off_t>(size)) != 0)
+        {
+            ::close(fd);
+            shm_unlink(_name.c_str());
+            XIHE_THROW("无法设置共享内存 '{}' 的大小：{}", _name, errno);
+        }
+        _address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (_address == MAP_FAILED)
+            _address = nullptr;
+#endif
+        if (!_address)
+        {
+            close();
+            XIHE_THROW("无法映射共享内存 '{}'", name);
+        }
+    }
+
+    void open(std::string_view name)
+    {
+        _name  = MakeName(name);
+        _owner = false;
+
+#ifdef XIHE_ON_WINDOWS
+        _mapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, _name.c_str());
+        if (!_mapping)
+            XIHE_THROW("无法打开共享内存 '{}'：{}", _name, GetLastError());
+        _address = MapViewOfFile(_mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+        if (_address)
+        {
+            MEMORY_BASIC_INFORMATION info{};
+            VirtualQuery(_address, &info, sizeof(info));
+            _size = info.RegionSize;
+        }
+#else
+        const int fd = shm_open(_name.c_str(), O_RDWR, 0600);
+        if (fd < 0)
+            XIHE_THROW("无法打开共享内存 '{}'：{}", _name, errno);
+        struct stat info{};
+        if (fstat(fd, &info) == 0)
+        {
+            _size    = As<Size>(info.st_size);
+            _address = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (_address == MAP_FAILED)
+                _address = nullptr;
+        }
+        ::close(fd);
+#endif
+        if (!_address)
+        {
+            close();
+            XIHE_THROW("无法映射共享内存 '{}'", name);
+        }
+    }
+
+    void close()
+    {
+#ifdef XIHE_ON_WINDOWS
+        if (_address)
+            UnmapViewOfFile(_address);
+        if (_mapping)
+            CloseHandle(_mapping);
+        _mapping = nullptr;
+#else
+        if (_address)
+            munmap(_address, _size);
+        if (_owner && !_name.empty())
+            shm_unlink(_name.c_str());
+#endif
+        _address = nullptr;
+        _owner   = false;
+    }
+
+    XIHE_NODISCARD void* address() const
+    {
+        return _address;
+    }
+
+    XIHE_NODISCARD Size size() const
+    {
+        return _size;
+    }
+
+private:
+    static std::string MakeName(std::string_view name)
+    {
+#ifdef XIHE_ON_WINDOWS
+        return std::string(name);
+#else
+        // POSIX 共享内存名称需以 '/' 开头
+        return name.starts_with('/') ? std::string(name) : "/" + std::string(name);
+#endif
+    }
+
+    std::string _name;
+    void* _address = nullptr;
+    Size _size     = 0;
+    bool _owner    = false;
+#ifdef XIHE_ON_WINDOWS
+    HANDLE _mapping = nullptr;
+#endif
+};
+} // namespace
+
+// ======================================
+
+class SharedEventRingWriter::Impl
+{
+public:
+    SharedMemoryRegion region;
+    SharedEventRingHeader* header = nullptr;
+    u8* data                      = nullptr;
+    u64 capacity                  = 0;
+    u64 writePos                  = 0; // 写者本地的写位置副本
+    u64 cachedReadPos             = 0; // 最近一次读取的读者位置，空间足够时不访问共享的 readPos
+    u64 sequence                  = 0;
+    std::mutex typeMutex;
+};
+
+SharedEventRingWriter::SharedEventRingWriter(std::string_view name, Size capacity) :
+    _pImpl(std::make_unique<Impl>())
+{
+    const auto dataSize = std::bit_ceil(std::max<Size>(capacity, 4096));
+    _pImpl->region.create(name, kDataOffset + dataSize);
+
+    auto* header = new(_pImpl->region.address()) SharedEventRingHeader{};
+    header->magic    = kSharedEventRingMagic;
+    header->version  = kSharedEventRingVersion;
+    header->capacity = dataSize;
+
+    _pImpl->header   = header;
+    _pImpl->data     = static_cast<u8*>(_pImpl->region.address()) + kDataOffset;
+    _pImpl->capacity = dataSize;
+}
+
+SharedEventRingWriter::~SharedEventRingWriter() = default;
+
+u16 SharedEventRingWriter::registerType(std::string_view name)
+{
+    std::lock_guard lock(_pImpl->typeMutex);
+
+    auto* header     = _pImpl->header;
+    const auto count = header->typeCount.load(std::memory_order_relaxed);
+    for (u32 i = 0; i < count; ++i)
+    {
+        if (name == std::string_view(header->typeNames[i], strnlen(header->typeNames[i], kSharedEventTypeNameSize)))
+            return As<u16>(i);
+    }
+
+    XIHE_CHECK(count < kSharedEventMaxTypes, "共享事件类型数量超过上限 {}", kSharedEventMaxTypes);
+    XIHE_CHECK(name.size() < kSharedEventTypeNameSize, "共享事件类型名称过长：{}", name);
+
+    std::memcpy(header->typeNames[count], name.data(), name.size());
+    header->typeNames[count][name.size()] = '\0';
+    header->typeCount.store(count + 1, std::memory_order_release);
+    return As<u16>(count);
+}
+
+bool SharedEventRingWriter::write(u16 type, EventPriority priority, bool queued, u64 timestampNs, std::span<const u8> payload)
+{
+    auto& impl        = *_pImpl;
+    const u64 seq     = impl.sequence++;
+    const u64 total   = AlignRecord(sizeof(SharedEventRecordHeader) + payload.size());
+    const u64 offset  = impl.writePos & (impl.capacity - 1);
+    const u64 tail    = impl.capacity - offset;
+    const u64 padding = tail < total ? tail : 0;
+    const u64 needed  = padding + total;
+
+    if (impl.writePos + needed - impl.cachedReadPos > impl.capacity)
+    {
+        impl.cachedReadPos = impl.header->readPos.load(std::memory_order_acquire);
+        if (impl.writePos + needed - impl.cachedReadPos > impl.capacity)
+        {
+            impl.header->droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+
+    if (padding != 0)
+    {
+        auto* record = reinterpret_cast<SharedEventRecordHeader*>(impl.data + offset);
+        *record      = {As<u32>(padding), kSharedEventPaddingType, 0, 0, 0, 0, 0, seq};
+        impl.writePos += padding;
+    }
+
+    auto* record = reinterpret_cast<SharedEventRecordHeader*>(impl.data + (impl.writePos & (impl.capacity - 1)));
+    *record      = {As<u32>(total), type, static_cast<u8>(priority), As<u8>(queued ? 1 : 0), As<u32>(payload.size()), 0,
+                    timestampNs, seq};
+    if (!payload.empty())
+        std::memcpy(record + 1, payload.data(), payload.size());
+
+    impl.writePos += total;
+    impl.header->writePos.store(impl.writePos, std::memory_order_release);
+    return true;
+}
+
+u64 SharedEventRingWriter::getDroppedCount() const
+{
+    return _pImpl->header->droppedCount.load(std::memory_order_relaxed);
+}
+
+Size SharedEventRingWriter::getCapacity() const
+{
+    return _pImpl->capacity;
+}
+
+// ======================================
+
+class SharedEventReader::Impl
+{
+public:
+    SharedMemoryRegion region;
+};
+
+SharedEventReader::SharedEventReader(std::string_view name) :
+    _pImpl(std::make_unique<Impl>())
+{
+    _pImpl->region.open(name);
+    if (_pImpl->region.size() < kDataOffset)
+        XIHE_THROW("共享内存 '{}' 不是事件环形缓冲区", name);
+
+    _header   = static_cast<SharedEventRingHeader*>(_pImpl->region.address());
+    _capacity = _header->capacity;
+    if (_header->magic != kSharedEventRingMagic || _header->version != kSharedEventRingVersion ||
+        !std::has_single_bit(_capacity) || _capacity < kSharedEventAlignment ||
+        kDataOffset + _capacity > _pImpl->region.size())
+    {
+        XIHE_THROW("共享内存 '{}' 不是兼容的事件环形缓冲区", name);
+    }
+    _data = static_cast<const u8*>(_pImpl->region.address()) + kDataOffset;
+}
+
+SharedEventReader::~SharedEventReader() = default;
+
+u64 SharedEventReader::getDroppedCount() const
+{
+    return _header->droppedCount.load(std::memory_order_relaxed);
+}
+
+std::string_view SharedEventReader::typeName(u16 type) const
+{
+    if (type >= _header->typeCount.load(std::memory_order_acquire))
+        return {};
+    return {_header->typeNames[type], strnlen(_header->typeNames[type], kSharedEventTypeNameSize)};
+}
@@ -0,0 +1,206 @@
+/**
+ * @File SharedEventRing.hpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/9/25
+ * @Brief This file is part of Xihe.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "Core/Base/Defines.hpp"
+#include "Core/Events/Event.hpp"
+#include "Core/Events/EventSerialization.hpp"
+
+namespace xihe {
+// ======================================
+// 共享内存事件环形缓冲区
+//
+// 引擎进程写入、外部工具进程读取的单生产者单消费者环形缓冲区，位于命名共享内存中
+// （POSIX 为 shm_open + mmap，Windows 为具名文件映射）。
+// 记录按 32 字节对齐、不跨越缓冲区末尾，末尾空间不足时写入填充记录；
+// 缓冲区已满时写者丢弃新记录并计数，从不等待读者。
+
+constexpr u32 kSharedEventRingMagic     = 0x52455358; // "XSER"
+constexpr u32 kSharedEventRingVersion   = 1;
+constexpr Size kSharedEventMaxTypes     = 64;
+constexpr Size kSharedEventTypeNameSize = 64;
+constexpr Size kSharedEventAlignment    = 32;
+constexpr u16 kSharedEventPaddingType   = 0xffff;
+
+struct SharedEventRecordHeader
+{
+    u32 size;  // 记录总长度（含头部与对齐填充）
+    u16 type;  // 类型表中的编号，kSharedEventPaddingType 表示填充记录
+    u8 priority;
+    u8 queued; // 1 表示由队列分发
+    u32 payloadSize;
+    u32 reserved;
+    u64 timestampNs;
+    u64 sequence; // 写者尝试写入的第几条记录（含被丢弃的），读者据此发现丢失
+};
+
+static_assert(sizeof(SharedEventRecordHeader) == kSharedEventAlignment);
+static_assert(std::atomic<u64>::is_always_lock_free, "共享内存中的原子变量需要是无锁的");
+
+struct SharedEventRingHeader
+{
+    u32 magic;
+    u32 version;
+    u64 capacity; // 数据区字节数，2 的幂
+
+    std::atomic<u32> typeCount;
+    char typeNames[kSharedEventMaxTypes][kSharedEventTypeNameSize];
+
+    alignas(64) std::atomic<u64> writePos; // 只由写者修改
+    alignas(64) std::atomic<u64> readPos;  // 只由读者修改
+    alignas(64) std::atomic<u64> droppedCount;
+};
+
+// 读者看到的一条记录，payload 直接指向共享内存，在 poll 的回调返回前有效
+struct SharedEventView
+{
+    u16 type = 0;
+    std::string_view typeName;
+    EventPriority priority = EventPriority::Normal;
+    bool queued            = false;
+    u64 timestampNs        = 0;
+    u64 sequence           = 0;
+    std::span<const u8> payload;
+
+    template <cSerializableEvent E>
+    XIHE_NODISCARD E decode() const
+    {
+        EventReader reader(payload);
+        return E::Deserialize(reader);
+    }
+};
+
+/**
+ * @brief 共享内存环形缓冲区的写者（引擎侧）
+ *
+ * 创建同名共享内存（已存在时替换），析构时删除。write() 本身不加锁，只能由一个线程调用。
+ */
+class XIHE_API SharedEventRingWriter
+{
+public:
+    // capacity 会向上取整为 2 的幂
+    SharedEventRingWriter(std::string_view name, Size capacity);
+    ~SharedEventRingWriter();
+
+    SharedEventRingWriter(const SharedEventRingWriter&)            = delete;
+    SharedEventRingWriter& operator=(const SharedEventRingWriter&) = delete;
+
+    // 注册类型名称，返回记录中使用的编号
+    u16 registerType(std::string_view name);
+
+    // 写入一条记录，缓冲区空间不足时丢弃并返回 false
+    bool write(u16 type, EventPriority priority, bool queued, u64 timestampNs, std::span<const u8> payload);
+
+    XIHE_NODISCARD u64 getDroppedCount() const;
+    XIHE_NODISCARD Size getCapacity() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> _pImpl;
+};
+
+/**
+ * @brief 共享内存环形缓冲区的读者（工具侧）
+ *
+ * 打开已存在的共享内存，不存在或格式不符时抛出异常。同一缓冲区只能有一个读者。
+ * 共享内存可以被其他进程任意改写，读者在使用记录头前校验长度、对齐与边界，
+ * 发现损坏的记录时停止读取并标记缓冲区已损坏。
+ */
+class XIHE_API SharedEventReader
+{
+public:
+    explicit SharedEventReader(std::string_view name);
+    ~SharedEventReader();
+
+    SharedEventReader(const SharedEventReader&)            = delete;
+    SharedEventReader& operator=(const SharedEventReader&) = delete;
+
+    // 依次对新记录调用 func(const SharedEventView&)，返回处理的记录数。
+    // 回调返回后才释放对应空间，因此回调中可以直接使用共享内存中的负载。缓冲区损坏后不再返回记录
+    template <typename F>
+    Size poll(F&& func, Size maxCount = numeric_limits<Size>::max());
+
+    XIHE_NODISCARD u64 getDroppedCount() const;
+    XIHE_NODISCARD std::string_view typeName(u16 type) const;
+
+    // 是否读到过损坏的记录或读写位置
+    XIHE_NODISCARD bool isCorrupt() const { return _corrupt; }
+
+private:
+    // 记录位于 [read, write) 内、不跨越缓冲区末尾，负载不超出记录
+    static bool IsValidRecord(const SharedEventRecordHeader& record, u64 read, u64 write, u64 capacity)
+    {
+        return record.size >= sizeof(SharedEventRecordHeader) && record.size % kSharedEventAlignment == 0 &&
+               record.size <= write - read && (read & (capacity - 1)) + record.size <= capacity &&
+               record.payloadSize <= record.size - sizeof(SharedEventRecordHeader);
+    }
+
+    class Impl;
+    std::unique_ptr<Impl> _pImpl;
+
+    SharedEventRingHeader* _header = nullptr;
+    const u8* _data                = nullptr;
+    u64 _capacity                  = 0; // 打开时校验过的容量，不再读取共享内存中的值
+    bool _corrupt                  = false;
+};
+
+template <typename F>
+Size SharedEventReader::poll(F&& func, Size maxCount)
+{
+    if (_corrupt)
+        return 0;
+
+    const u64 mask  = _capacity - 1;
+    const u64 write = _header->writePos.load(std::memory_order_acquire);
+    u64 read        = _header->readPos.load(std::memory_order_relaxed);
+    if (write < read || write - read > _capacity || read % kSharedEventAlignment != 0)
+    {
+        _corrupt = true;
+        return 0;
+    }
+
+    Size count = 0;
+    while (read < write && count < maxCount)
+    {
+        // 复制记录头后再校验，避免校验与使用之间被其他进程改写
+        const u8* base = _data + (read & mask);
+        SharedEventRecordHeader record;
+        std::memcpy(&record, base, sizeof(record));
+        if (!IsValidRecord(record, read, write, _capacity))
+        {
+            _corrupt = true;
+            break;
+        }
+
+        if (record.type != kSharedEventPaddingType)
+        {
+            SharedEventView view;
+            view.type        = record.type;
+            view.typeName    = typeName(record.type);
+            view.priority    = static_cast<EventPriority>(record.priority);
+            view.queued      = record.queued != 0;
+            view.timestampNs = record.timestampNs;
+            view.sequence    = record.sequence;
+            view.payload     = {base + sizeof(record), record.payloadSize};
+            func(view);
+            ++count;
+        }
+        read += record.size;
+    }
+
+    _header->readPos.store(read, std::memory_order_release);
+    return count;
+}
+} // namespace xihe
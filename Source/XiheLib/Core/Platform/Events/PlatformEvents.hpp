@@ -12,6 +12,7 @@
 #include <format>
 #include "Core/Base/Defines.hpp"
 #include "Core/Events/Event.hpp"
+#include "Core/Events/EventSerialization.hpp"
 #include "Core/Platform/Input.hpp"
 
 namespace xihe {
@@ -34,6 +35,23 @@ public:
     {
         return std::format("KeyboardEvent: key={}, pressed={}, repeat={}", static_cast<u32>(key), pressed, repeat);
     }
+
+    void serialize(EventWriter& writer) const
+    {
+        writer.write(key);
+        writer.write(pressed);
+        writer.write(repeat);
+        writer.write(scancode);
+    }
+
+    static KeyboardEvent Deserialize(EventReader& reader)
+    {
+        const auto k  = reader.read<KeyCode>();
+        const auto p  = reader.read<bool>();
+        const auto r  = reader.read<bool>();
+        const auto sc = reader.read<u16>();
+        return {k, p, r, sc};
+    }
 };
 
 class TextInputEvent : public EventBase<TextInputEvent>
@@ -52,6 +70,16 @@ public:
     {
         return std::format("TextInputEvent: text='{}'", text);
     }
+
+    void serialize(EventWriter& writer) const
+    {
+        writer.writeString(text);
+    }
+
+    static TextInputEvent Deserialize(EventReader& reader)
+    {
+        return TextInputEvent(reader.readString());
+    }
 };
 
 class TextEditingEvent : public EventBase<TextEditingEvent>
@@ -72,6 +100,21 @@ public:
     {
         return std::format("TextEditingEvent: text='{}', start={}, length={}", text, start, length);
     }
+
+    void serialize(EventWriter& writer) const
+    {
+        writer.writeString(text);
+        writer.write(start);
+        writer.write(length);
+    }
+
+    static TextEditingEvent Deserialize(EventReader& reader)
+    {
+        auto t       = reader.readString();
+        const auto s = reader.read<i32>();
+        const auto l = reader.read<i32>();
+        return {std::move(t), s, l};
+    }
 };
 
 // -----------------------------
@@ -96,11 +139,33 @@ public:
         return std::format("MouseButtonEvent: button={}, pressed={}, pos=({},{}), clicks={}", static_cast<u32>(button),
                            pressed, x, y, clicks);
     }
+
+    void serialize(EventWriter& writer) const
+    {
+        writer.write(button);
+        writer.write(pressed);
+        writer.write(x);
+        writer.write(y);
+        writer.write(clicks);
+    }
+
+    static MouseButtonEvent Deserialize(EventReader& reader)
+    {
+        const auto b  = reader.read<MouseButton>();
+        const auto p  = reader.read<bool>();
+        const auto x_ = reader.read<i32>();
+        const auto y_ = reader.read<i32>();
+        const auto c  = reader.read<u8>();
+        return {b, p, x_, y_, c};
+    }
 };
 
 class MouseMotionEvent : public EventBase<MouseMotionEvent>
 {
 public:
+    // 队列中合并：位置取最新值，位移累加
+    static constexpr EventCoalesce kCoalescePolicy = EventCoalesce::Accumulate;
+
     i32 x, y;
     i32 deltaX, deltaY;
 
@@ -115,11 +180,39 @@ public:
     {
         return std::format("MouseMotionEvent: pos=({},{}), delta=({},{})", x, y, deltaX, deltaY);
     }
+
+    void merge(const MouseMotionEvent& newer)
+    {
+        x = newer.x;
+        y = newer.y;
+        deltaX += newer.deltaX;
+        deltaY += newer.deltaY;
+    }
+
+    void serialize(EventWriter& writer) const
+    {
+        writer.write(x);
+        writer.write(y);
+        writer.write(deltaX);
+        writer.write(deltaY);
+    }
+
+    static MouseMotionEvent Deserialize(EventReader& reader)
+    {
+        const auto x_ = reader.read<i32>();
+        const auto y_ = reader.read<i32>();
+        const auto dx = reader.read<i32>();
+        const auto dy = reader.read<i32>();
+        return {x_, y_, dx, dy};
+    }
 };
 
 class MouseWheelEvent : public EventBase<MouseWheelEvent>
 {
 public:
+    // 队列中合并：滚动量累加，位置取最新值
+    static constexpr EventCoalesce kCoalescePolicy = EventCoalesce::Accumulate;
+
     f32 deltaX, deltaY;
     i32 x, y;
     bool flipped;
@@ -135,6 +228,38 @@ public:
     {
         return std::format("MouseWheelEvent: delta=({},{}), pos=({},{})", deltaX, deltaY, x, y);
     }
+
+    XIHE_NODISCARD bool canCoalesceWith(const MouseWheelEvent& newer) const
+    {
+        return flipped == newer.flipped;
+    }
+
+    void merge(const MouseWheelEvent& newer)
+    {
+        deltaX += newer.deltaX;
+        deltaY += newer.deltaY;
+        x = newer.x;
+        y = newer.y;
+    }
+
+    void serialize(EventWriter& writer) const
+    {
+        writer.write(deltaX);
+        writer.write(deltaY);
+        writer.write(x);
+        writer.write(y);
+        writer.write(flipped);
+    }
+
+    static MouseWheelEvent Deserialize(EventReader& reader)
+    {
+        const auto dx = reader.read<f32>();
+        const auto dy = reader.read<f32>();
+        const auto x_ = reader.read<i32>();
+        const auto y_ = reader.read<i32>();
+        const auto f  = reader.read<bool>();
+        return {dx, dy, x_, y_, f};
+    }
 };
 
 // -----------------------------
@@ -155,11 +280,24 @@ public:
     {
         return std::format("WindowCloseEvent: windowId={}", windowId);
     }
+
+    void serialize(EventWriter& writer) const
+    {
+        writer.write(windowId);
+    }
+
+    static WindowCloseEvent Deserialize(EventReader& reader)
+    {
+        return WindowCloseEvent(reader.read<u32>());
+    }
 };
 
 class WindowResizeEvent : public EventBase<WindowResizeEvent>
 {
 public:
+    // 队列中只保留同一窗口最新的尺寸
+    static constexpr EventCoalesce kCoalescePolicy = EventCoalesce::LatestWins;
+
     u32 windowId;
     u32 width, height;
 
@@ -174,6 +312,26 @@ public:
     {
         return std::format("WindowResizeEvent: windowId={}, size={}x{}", windowId, width, height);
     }
+
+    XIHE_NODISCARD bool canCoalesceWith(const WindowResizeEvent& newer) const
+    {
+        return windowId == newer.windowId;
+    }
+
+    void serialize(EventWriter& writer) const
+    {
+        writer.write(windowId);
+        writer.write(width);
+        writer.write(height);
+    }
+
+    static WindowResizeEvent Deserialize(EventReader& reader)
+    {
+        const auto id = reader.read<u32>();
+        const auto w  = reader.read<u32>();
+        const auto h  = reader.read<u32>();
+        return {id, w, h};
+    }
 };
 
 class WindowFocusEvent : public EventBase<WindowFocusEvent>
@@ -193,11 +351,27 @@ public:
     {
         return std::format("WindowFocusEvent: windowId={}, gained={}", windowId, gained);
     }
+
+    void serialize(EventWriter& writer) const
+    {
+        writer.write(windowId);
+        writer.write(gained);
+    }
+
+    static WindowFocusEvent Deserialize(EventReader& reader)
+    {
+        const auto id = reader.read<u32>();
+        const auto g  = reader.read<bool>();
+        return {id, g};
+    }
 };
 
 class WindowMoveEvent : public EventBase<WindowMoveEvent>
 {
 public:
+    // 队列中只保留同一窗口最新的位置
+    static constexpr EventCoalesce kCoalescePolicy = EventCoalesce::LatestWins;
+
     u32 windowId;
     i32 x, y; // 新的窗口位置
 
@@ -212,6 +386,26 @@ public:
     {
         return std::format("WindowMoveEvent: windowId={}, pos=({},{})", windowId, x, y);
     }
+
+    XIHE_NODISCARD bool canCoalesceWith(const WindowMoveEvent& newer) const
+    {
+        return windowId == newer.windowId;
+    }
+
+    void serialize(EventWriter& writer) const
+    {
+        writer.write(windowId);
+        writer.write(x);
+        writer.write(y);
+    }
+
+    static WindowMoveEvent Deserialize(EventReader& reader)
+    {
+        const auto id = reader.read<u32>();
+        const auto x_ = reader.read<i32>();
+        const auto y_ = reader.read<i32>();
+        return {id, x_, y_};
+    }
 };
 
 // -----------------------------
@@ -229,6 +423,15 @@ public:
     {
         return "AppQuitEvent";
     }
+
+    void serialize(EventWriter&) const
+    {
+    }
+
+    static AppQuitEvent Deserialize(EventReader& reader)
+    {
+        return {};
+    }
 };
 
 class AppLowMemoryEvent : public EventBase<AppLowMemoryEvent>
@@ -244,6 +447,15 @@ public:
     {
         return "AppLowMemoryEvent";
     }
+
+    void serialize(EventWriter&) const
+    {
+    }
+
+    static AppLowMemoryEvent Deserialize(EventReader& reader)
+    {
+        return {};
+    }
 };
 
 // -----------------------------
@@ -260,4 +472,21 @@ using WindowFocusEventPtr  = SharedPtr<WindowFocusEvent>;
 using WindowMoveEventPtr   = SharedPtr<WindowMoveEvent>;
 using AppQuitEventPtr      = SharedPtr<AppQuitEvent>;
 using AppLowMemoryEventPtr = SharedPtr<AppLowMemoryEvent>;
+
+// 注册平台事件的序列化方式，用于事件录制与回放。Context::Create 时自动调用，重复调用无副作用
+inline void RegisterPlatformEventCodecs()
+{
+    EventCodecRegistry::Register<KeyboardEvent>("KeyboardEvent");
+    EventCodecRegistry::Register<TextInputEvent>("TextInputEvent");
+    EventCodecRegistry::Register<TextEditingEvent>("TextEditingEvent");
+    EventCodecRegistry::Register<MouseButtonEvent>("MouseButtonEvent");
+    EventCodecRegistry::Register<MouseMotionEvent>("MouseMotionEvent");
+    EventCodecRegistry::Register<MouseWheelEvent>("MouseWheelEvent");
+    EventCodecRegistry::Register<WindowCloseEvent>("WindowCloseEvent");
+    EventCodecRegistry::Register<WindowResizeEvent>("WindowResizeEvent");
+    EventCodecRegistry::Register<WindowFocusEvent>("WindowFocusEvent");
+    EventCodecRegistry::Register<WindowMoveEvent>("WindowMoveEvent");
+    EventCodecRegistry::Register<AppQuitEvent>("AppQuitEvent");
+    EventCodecRegistry::Register<AppLowMemoryEvent>("AppLowMemoryEvent");
+}
 } // namespace xihe
@@ -0,0 +1,297 @@
+/**
+ * @File Epoch.cpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/10/5
+ * @Brief This file is part of Xihe.
+ */
+
+#include "Epoch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <thread>
+
+using namespace xihe;
+
+namespace {
+struct EpochRecord
+{
+    std::atomic<u64> epoch{0}; // 0 表示未处于临界区
+    std::atomic<bool> inUse{false};
+    u32 nesting       = 0;
+    EpochRecord* next = nullptr;
+};
+
+struct RetiredItem
+{
+    u64 epoch;
+    void* ptr;
+    Epoch::Deleter deleter;
+    void* context;
+};
+
+using RetiredItems = std::vector<RetiredItem, PlainAllocator<RetiredItem>>;
+
+// 移出纪元不晚于 safeEpoch - 2 的对象
+RetiredItems TakeSafe(RetiredItems& items, u64 safeEpoch)
+{
+    const auto first = std::partition(items.begin(), items.end(),
+                                      [safeEpoch](const RetiredItem& item) { return item.epoch + 2 > safeEpoch; });
+    RetiredItems ready(first, items.end());
+    items.erase(first, items.end());
+    return ready;
+}
+
+// 先移出再调用 deleter，deleter 内可以继续 Retire
+Size Free(const RetiredItems& ready)
+{
+    for (const auto& item : ready)
+        item.deleter(item.ptr, item.context);
+    return ready.size();
+}
+
+class EpochDomain
+{
+public:
+    static EpochDomain& Get()
+    {
+        // 不析构：线程本地状态可能在静态对象析构后才注销
+        static auto* domain = new EpochDomain();
+        return *domain;
+    }
+
+    u64 current() const { return _epoch.load(std::memory_order_acquire); }
+
+    // 登记记录只增不减，线程退出后留给后来的线程复用
+    EpochRecord* acquireRecord()
+    {
+        for (auto* record = _records.load(std::memory_order_acquire); record; record = record->next)
+        {
+            bool expected = false;
+            if (!record->inUse.load(std::memory_order_relaxed) &&
+                record->inUse.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+                return record;
+        }
+
+        auto* memory = PlainAllocator<EpochRecord>{}.allocate(1);
+        auto* record = ::new (memory) EpochRecord();
+        record->inUse.store(true, std::memory_order_relaxed);
+        record->next = _records.load(std::memory_order_relaxed);
+        while (!_records.compare_exchange_weak(record->next, record, std::memory_order_acq_rel)) {}
+        return record;
+    }
+
+    static void ReleaseRecord(EpochRecord* record)
+    {
+        record->epoch.store(0, std::memory_order_release);
+        record->nesting = 0;
+        record->inUse.store(false, std::memory_order_release);
+    }
+
+    u64 tryAdvance()
+    {
+        u64 epoch = current();
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        for (auto* record = _records.load(std::memory_order_acquire); record; record = record->next)
+        {
+            const u64 local = record->epoch.load(std::memory_order_acquire);
+            if (local != 0 && local != epoch)
+                return epoch;
+        }
+
+        _epoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_acq_rel);
+        return current();
+    }
+
+    void synchronize()
+    {
+        const u64 target = current() + 2;
+        while (tryAdvance() < target)
+            std::this_thread::yield();
+    }
+
+    // 退出线程留下的对象
+    void adoptOrphans(RetiredItems& items)
+    {
+        if (items.empty())
+            return;
+
+        std::lock_guard lock(_orphanMutex);
+        _orphans.insert(_orphans.end(), items.begin(), items.end());
+        _orphanCount.store(_orphans.size(), std::memory_order_relaxed);
+        items.clear();
+    }
+
+    Size collectOrphans(u64 safeEpoch, bool wait)
+    {
+        if (_orphanCount.load(std::memory_order_relaxed) == 0)
+            return 0;
+
+        RetiredItems ready;
+        {
+            std::unique_lock lock(_orphanMutex, std::defer_lock);
+            if (wait)
+                lock.lock();
+            else if (!lock.try_lock())
+                return 0;
+
+            ready = TakeSafe(_orphans, safeEpoch);
+            _orphanCount.store(_orphans.size(), std::memory_order_relaxed);
+        }
+        return Free(ready);
+    }
+
+    Size getOrphanCount() const { return _orphanCount.load(std::memory_order_relaxed); }
+
+private:
+    EpochDomain() = default;
+
+    alignas(64) std::atomic<u64> _epoch{1};
+    std::atomic<EpochRecord*> _records{nullptr};
+
+    std::mutex _orphanMutex;
+    RetiredItems _orphans;
+    std::atomic<Size> _orphanCount{0};
+};
+
+struct ThreadEpoch
+{
+    EpochRecord* record = nullptr;
+    RetiredItems retired;
+
+    EpochRecord* getRecord()
+    {
+        if (!record)
+            record = EpochDomain::Get().acquireRecord();
+        return record;
+    }
+
+    void release()
+    {
+        auto& domain = EpochDomain::Get();
+        Free(TakeSafe(retired, domain.tryAdvance()));
+        domain.adoptOrphans(retired);
+        if (record)
+        {
+            EpochDomain::ReleaseRecord(record);
+            record = nullptr;
+        }
+    }
+
+    ~ThreadEpoch() { release(); }
+};
+
+thread_local ThreadEpoch tThreadEpoch;
+} // namespace
+
+// ======================================
+// Epoch
+
+u64 Epoch::Current()
+{
+    return EpochDomain::Get().current();
+}
+
+u64 Epoch::TryAdvance()
+{
+    return EpochDomain::Get().tryAdvance();
+}
+
+void Epoch::Synchronize()
+{
+    EpochDomain::Get().synchronize();
+}
+
+void Epoch::RegisterThread()
+{
+    tThreadEpoch.getRecord();
+}
+
+void Epoch::UnregisterThread()
+{
+    tThreadEpoch.release();
+}
+
+void Epoch::Retire(void* ptr, Deleter deleter, void* context)
+{
+    if (!ptr)
+        return;
+
+    // 与 EpochGuard 中发布纪元后的栅栏配对
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto& state = tThreadEpoch;
+    state.retired.push_back({Current(), ptr, deleter, context});
+    if (state.retired.size() >= kRetireBatch)
+        Collect();
+}
+
+void Epoch::Retire(IAllocator& allocator, const AllocationHandle& handle)
+{
+    if (!handle)
+        return;
+
+    auto* copy = ::new (PlainAllocator<AllocationHandle>{}.allocate(1)) AllocationHandle(handle);
+    Retire(copy, [](void* ptr, void* context)
+    {
+        auto* h = static_cast<AllocationHandle*>(ptr);
+        static_cast<IAllocator*>(context)->deallocate(*h);
+        PlainAllocator<AllocationHandle>{}.deallocate(h, 1);
+    }, &allocator);
+}
+
+Size Epoch::Collect()
+{
+    auto& domain    = EpochDomain::Get();
+    const u64 epoch = domain.tryAdvance();
+    return Free(TakeSafe(tThreadEpoch.retired, epoch)) + domain.collectOrphans(epoch, false);
+}
+
+void Epoch::Drain()
+{
+    auto& domain = EpochDomain::Get();
+    while (!tThreadEpoch.retired.empty() || domain.getOrphanCount() > 0)
+    {
+        domain.synchronize();
+        const u64 epoch = domain.current();
+        Free(TakeSafe(tThreadEpoch.retired, epoch));
+        domain.collectOrphans(epoch, true);
+    }
+}
+
+Size Epoch::GetPendingCount()
+{
+    return tThreadEpoch.retired.size() + EpochDomain::Get().getOrphanCount();
+}
+
+// ======================================
+// EpochGuard
+
+EpochGuard::EpochGuard()
+{
+    auto* record = tThreadEpoch.getRecord();
+    if (record->nesting++ == 0)
+    {
+        // 发布后重新检查：读取与发布之间纪元可能已被推进，发布过期的纪元会让回收方误判
+        auto& domain = EpochDomain::Get();
+        u64 epoch    = domain.current();
+        for (;;)
+        {
+            record->epoch.store(epoch, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const u64 now = domain.current();
+            if (now == epoch)
+                break;
+            epoch = now;
+        }
+    }
+    _record = record;
+}
+
+EpochGuard::~EpochGuard()
+{
+    auto* record = static_cast<EpochRecord*>(_record);
+    if (--record->nesting == 0)
+        record->epoch.store(0, std::memory_order_release);
+}
@@ -0,0 +1,147 @@
+/**
+ * @File Epoch.hpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/10/5
+ * @Brief This file is part of Xihe.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include "Core/Base/Defines.hpp"
+#include "Core/Memory/IAllocator.hpp"
+#include "Core/Memory/Memory.hpp"
+
+namespace xihe {
+/**
+ * @brief 纪元回收（Epoch-Based Reclamation）
+ *
+ * 无锁读者在 EpochGuard 的作用域内访问共享数据，进入与离开时只写自己线程的纪元槽位，不获取任何锁；
+ * 写者替换数据后把旧对象交给 Retire，待所有处于临界区的线程都越过两个纪元后再释放。
+ *
+ * - 线程首次进入临界区时自动登记，线程退出时自动注销，也可以提前调用 RegisterThread；
+ * - Retire 先放入当前线程的批次，攒满 kRetireBatch 个后尝试推进纪元并释放已安全的对象，
+ *   线程退出时未释放的对象转交给全局列表，由其他线程的回收顺带处理；
+ * - 批次与登记记录通过引擎分配器分配，也可以通过分配器句柄延迟归还内存。
+ *
+ * 临界区内不能调用 Synchronize 与 Drain，也不应长时间停留，否则所有线程的回收都会被推迟。
+ */
+class XIHE_API Epoch
+{
+public:
+    using Deleter = void (*)(void* ptr, void* context);
+
+    // 每个线程攒够这么多待回收对象后尝试回收一次
+    static constexpr Size kRetireBatch = 64;
+
+    static u64 Current();
+
+    // 所有处于临界区的线程都已观察到当前纪元时推进一次，返回推进后的纪元
+    static u64 TryAdvance();
+
+    // 等待调用前进入临界区的线程全部离开
+    static void Synchronize();
+
+    static void RegisterThread();
+    static void UnregisterThread();
+
+    // 延迟调用 deleter(ptr, context)。调用前需已发布替换后的对象，读取纪元前的全序栅栏
+    // 保证替换不会排到纪元读取之后，否则晚一个纪元进入的读者仍可能读到旧对象
+    static void Retire(void* ptr, Deleter deleter, void* context = nullptr);
+
+    // 延迟归还分配器分配的内存
+    static void Retire(IAllocator& allocator, const AllocationHandle& handle);
+
+    template <typename T>
+    static void Retire(const T* ptr)
+    {
+        if (ptr)
+            Retire(const_cast<T*>(ptr), [](void* p, void*) { delete static_cast<T*>(p); });
+    }
+
+    // 回收当前线程批次中已经安全的对象，返回释放数量
+    static Size Collect();
+
+    // 释放所有线程已退休的对象，用于关闭阶段
+    static void Drain();
+
+    // 当前线程批次与全局列表中尚未释放的对象数
+    static Size GetPendingCount();
+};
+
+// 读者临界区，可以嵌套
+class XIHE_API EpochGuard
+{
+public:
+    EpochGuard();
+    ~EpochGuard();
+
+    EpochGuard(const EpochGuard&)            = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+
+private:
+    void* _record;
+};
+
+/**
+ * @brief 单一所有者的回收列表
+ *
+ * 用于已经由写锁串行化的结构：写者把旧对象挂到自己的列表上，不经过线程批次，
+ * 随后的写操作调用 collect 释放已安全的对象。列表析构时直接释放剩余对象，调用者需保证此时没有读者。
+ */
+class RetireList
+{
+public:
+    RetireList() = default;
+
+    ~RetireList()
+    {
+        for (auto& item : _items)
+            item.deleter(item.ptr, nullptr);
+    }
+
+    RetireList(const RetireList&)            = delete;
+    RetireList& operator=(const RetireList&) = delete;
+
+    // 调用前需已发布替换后的对象，见 Epoch::Retire
+    template <typename T>
+    void retire(const T* ptr)
+    {
+        if (!ptr)
+            return;
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        _items.push_back({Epoch::Current(), const_cast<T*>(ptr), [](void* p, void*) { delete static_cast<T*>(p); }});
+    }
+
+    void collect()
+    {
+        if (_items.empty())
+            return;
+
+        const u64 epoch = Epoch::TryAdvance();
+        std::erase_if(_items, [epoch](const Item& item)
+        {
+            if (item.epoch + 2 > epoch)
+                return false;
+            item.deleter(item.ptr, nullptr);
+            return true;
+        });
+    }
+
+    Size size() const { return _items.size(); }
+
+private:
+    struct Item
+    {
+        u64 epoch;
+        void* ptr;
+        Epoch::Deleter deleter;
+    };
+
+    std::vector<Item, PlainAllocator<Item>> _items;
+};
+} // namespace xihe
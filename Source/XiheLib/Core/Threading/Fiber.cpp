@@ -0,0 +1,313 @@
+/**
+ * @File Fiber.cpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/9/30
+ * @Brief This file is part of Xihe.
+ */
+
+#include "Fiber.hpp"
+#include "Core/Base/Concepts.hpp"
+#include "Core/Base/Error.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef XIHE_ON_WINDOWS
+#  define XIHE_FIBER_BACKEND_NONE 1
+#else
+#  include <sys/mman.h>
+#  include <unistd.h>
+#  if defined(XIHE_ON_LINUX) && defined(__x86_64__)
+#    define XIHE_FIBER_BACKEND_ASM 1
+#  else
+#    include <ucontext.h>
+#    define XIHE_FIBER_BACKEND_UCONTEXT 1
+#  endif
+#endif
+
+// ThreadSanitizer 需要知道栈切换，否则会把不同纤程上的访问当作同一线程的乱序访问
+#if defined(__SANITIZE_THREAD__)
+#  define XIHE_FIBER_TSAN 1
+#elif defined(__has_feature)
+#  if __has_feature(thread_sanitizer)
+#    define XIHE_FIBER_TSAN 1
+#  endif
+#endif
+
+#if XIHE_FIBER_TSAN
+extern "C" {
+void* __tsan_get_current_fiber();
+void* __tsan_create_fiber(unsigned flags);
+void __tsan_destroy_fiber(void* fiber);
+void __tsan_switch_to_fiber(void* fiber, unsigned flags);
+}
+#endif
+
+using namespace xihe;
+
+#if XIHE_FIBER_BACKEND_ASM
+extern "C" {
+void XiheFiberSwitch(void** from, void* to);
+void XiheFiberStart();
+}
+
+// 保存 System V 被调用者保存寄存器与 MXCSR/x87 控制字，切换栈指针后恢复目标的同一组寄存器
+asm(R"(
+    .text
+    .globl XiheFiberSwitch
+    .hidden XiheFiberSwitch
+    .type XiheFiberSwitch, @function
+XiheFiberSwitch:
+    pushq %rbp
+    pushq %rbx
+    pushq %r12
+    pushq %r13
+    pushq %r14
+    pushq %r15
+    subq $8, %rsp
+    stmxcsr (%rsp)
+    fnstcw 4(%rsp)
+    movq %rsp, (%rdi)
+    movq %rsi, %rsp
+    ldmxcsr (%rsp)
+    fldcw 4(%rsp)
+    addq $8, %rsp
+    popq %r15
+    popq %r14
+    popq %r13
+    popq %r12
+    popq %rbx
+    popq %rbp
+    ret
+    .size XiheFiberSwitch, .-XiheFiberSwitch
+
+    .globl XiheFiberStart
+    .hidden XiheFiberStart
+    .type XiheFiberStart, @function
+XiheFiberStart:
+    movq %r13, %rdi
+    callq *%r12
+    ud2
+    .size XiheFiberStart, .-XiheFiberStart
+)");
+
+namespace {
+// 新纤程的初始栈帧，布局与 XiheFiberSwitch 压栈顺序一致
+struct InitialFrame
+{
+    u32 mxcsr;
+    u16 fpuControl;
+    u16 padding;
+    void* r15;
+    void* r14;
+    void* r13; // arg
+    void* r12; // entry
+    void* rbx;
+    void* rbp;
+    void* returnAddress;
+};
+
+static_assert(sizeof(InitialFrame) == 64);
+} // namespace
+#endif
+
+#if XIHE_FIBER_BACKEND_UCONTEXT
+namespace {
+struct UContext
+{
+    ucontext_t context;
+    Fiber::Entry entry = nullptr;
+    void* arg          = nullptr;
+};
+
+// makecontext 只能传 int 参数，指针拆成两半
+void UContextStart(int high, int low)
+{
+    const auto address = (As<u64>(As<u32>(high)) << 32) | As<u32>(low);
+    auto* context      = reinterpret_cast<UContext*>(address);
+    context->entry(context->arg);
+    std::abort();
+}
+} // namespace
+#endif
+
+// ======================================
+// FiberStackPool
+
+Size FiberStackPool::PageSize()
+{
+#ifdef XIHE_ON_WINDOWS
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+#else
+    static const Size pageSize = As<Size>(sysconf(_SC_PAGESIZE));
+    return pageSize;
+#endif
+}
+
+FiberStackPool::FiberStackPool(Size stackSize)
+{
+    const Size page = PageSize();
+    _stackSize      = (std::max(stackSize, page) + page - 1) / page * page;
+}
+
+FiberStackPool::~FiberStackPool()
+{
+    const Size page = PageSize();
+    for (const auto& stack : _cached)
+    {
+#ifdef XIHE_ON_WINDOWS
+        VirtualFree(stack.base - page, 0, MEM_RELEASE);
+#else
+        munmap(stack.base - page, stack.size + page);
+#endif
+    }
+}
+
+FiberStack FiberStackPool::acquire()
+{
+    {
+        std::lock_guard lock(_mutex);
+        if (!_cached.empty())
+        {
+            const auto stack = _cached.back();
+            _cached.pop_back();
+            return stack;
+        }
+    }
+
+    const Size page  = PageSize();
+    const Size total = _stackSize + page;
+
+#ifdef XIHE_ON_WINDOWS
+    auto* memory = static_cast<std::byte*>(VirtualAlloc(nullptr, total, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+    if (!memory)
+        XIHE_THROW("无法分配纤程栈：{}", GetLastError());
+    DWORD oldProtect = 0;
+    if (!VirtualProtect(memory, page, PAGE_NOACCESS, &oldProtect))
+    {
+        VirtualFree(memory, 0, MEM_RELEASE);
+        XIHE_THROW("无法设置纤程栈保护页：{}", GetLastError());
+    }
+#else
+    void* mapped = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+    if (mapped == MAP_FAILED)
+        XIHE_THROW("无法分配纤程栈：{}", errno);
+    auto* memory = static_cast<std::byte*>(mapped);
+    if (mprotect(memory, page, PROT_NONE) != 0)
+    {
+        munmap(memory, total);
+        XIHE_THROW("无法设置纤程栈保护页：{}", errno);
+    }
+#endif
+
+    return {memory + page, _stackSize};
+}
+
+void FiberStackPool::release(FiberStack stack)
+{
+    if (!stack)
+        return;
+
+    std::lock_guard lock(_mutex);
+    _cached.push_back(stack);
+}
+
+Size FiberStackPool::getCachedCount() const
+{
+    std::lock_guard lock(_mutex);
+    return _cached.size();
+}
+
+// ======================================
+// Fiber
+
+bool Fiber::IsSupported()
+{
+#if XIHE_FIBER_BACKEND_NONE
+    return false;
+#else
+    return true;
+#endif
+}
+
+Fiber::Fiber()
+{
+#if XIHE_FIBER_BACKEND_UCONTEXT
+    _context = new UContext();
+#endif
+#if XIHE_FIBER_TSAN
+    _sanitizerFiber = __tsan_get_current_fiber();
+#endif
+}
+
+Fiber::Fiber(FiberStack stack, Entry entry, void* arg) :
+    _stack(stack)
+{
+#if XIHE_FIBER_BACKEND_NONE
+    (void)entry;
+    (void)arg;
+    XIHE_THROW("当前平台不支持纤程");
+#else
+    if (!stack || !entry)
+        XIHE_THROW("纤程需要有效的栈与入口函数");
+
+#  if XIHE_FIBER_BACKEND_ASM
+    auto top    = reinterpret_cast<uintptr_t>(stack.top()) & ~uintptr_t{15};
+    auto* frame = reinterpret_cast<InitialFrame*>(top - 16 - sizeof(InitialFrame));
+    std::memset(frame, 0, sizeof(InitialFrame));
+    frame->mxcsr         = 0x1F80; // 默认舍入模式，屏蔽所有浮点异常
+    frame->fpuControl    = 0x037F;
+    frame->r13           = arg;
+    frame->r12           = reinterpret_cast<void*>(entry);
+    frame->returnAddress = reinterpret_cast<void*>(&XiheFiberStart);
+    _context             = frame;
+#  else
+    auto* context  = new UContext();
+    context->entry = entry;
+    context->arg   = arg;
+    getcontext(&context->context);
+    context->context.uc_stack.ss_sp   = stack.base;
+    context->context.uc_stack.ss_size = stack.size;
+    context->context.uc_link          = nullptr;
+    const auto address                = reinterpret_cast<u64>(context);
+    makecontext(&context->context, reinterpret_cast<void (*)()>(&UContextStart), 2, As<int>(As<u32>(address >> 32)),
+                As<int>(As<u32>(address & 0xFFFF'FFFF)));
+    _context = context;
+#  endif
+
+#  if XIHE_FIBER_TSAN
+    _sanitizerFiber     = __tsan_create_fiber(0);
+    _ownsSanitizerFiber = true;
+#  endif
+#endif
+}
+
+Fiber::~Fiber()
+{
+#if XIHE_FIBER_BACKEND_UCONTEXT
+    delete static_cast<UContext*>(_context);
+#endif
+#if XIHE_FIBER_TSAN
+    if (_ownsSanitizerFiber)
+        __tsan_destroy_fiber(_sanitizerFiber);
+#endif
+}
+
+void Fiber::switchTo(Fiber& target)
+{
+#if XIHE_FIBER_TSAN
+    __tsan_switch_to_fiber(target._sanitizerFiber, 0);
+#endif
+
+#if XIHE_FIBER_BACKEND_ASM
+    XiheFiberSwitch(&_context, target._context);
+#elif XIHE_FIBER_BACKEND_UCONTEXT
+    swapcontext(&static_cast<UContext*>(_context)->context, &static_cast<UContext*>(target._context)->context);
+#else
+    (void)target;
+    XIHE_THROW("当前平台不支持纤程");
+#endif
+}
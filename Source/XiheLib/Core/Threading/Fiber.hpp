@@ -0,0 +1,109 @@
+/**
+ * @File Fiber.hpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/9/30
+ * @Brief This file is part of Xihe.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include "Core/Base/Defines.hpp"
+
+namespace xihe {
+/**
+ * @brief 纤程栈，[base, base + size) 可用，base 之下是一页不可访问的保护页
+ */
+struct FiberStack
+{
+    std::byte* base = nullptr;
+    Size size       = 0;
+
+    XIHE_NODISCARD std::byte* top() const
+    {
+        return base + size;
+    }
+
+    explicit operator bool() const
+    {
+        return base != nullptr;
+    }
+};
+
+/**
+ * @brief 纤程栈池
+ *
+ * 栈直接向系统按页申请，低地址端放一页保护页，栈溢出时立即触发访问错误而不是破坏相邻内存。
+ * 归还的栈缓存复用，池析构时释放；池析构前所有借出的栈必须已归还。
+ */
+class XIHE_API FiberStackPool
+{
+public:
+    static constexpr Size kDefaultStackSize = 64 * 1024;
+
+    explicit FiberStackPool(Size stackSize = kDefaultStackSize);
+    ~FiberStackPool();
+
+    FiberStackPool(const FiberStackPool&)            = delete;
+    FiberStackPool& operator=(const FiberStackPool&) = delete;
+
+    FiberStack acquire();
+    void release(FiberStack stack);
+
+    // 按页大小向上取整后的可用栈大小
+    XIHE_NODISCARD Size getStackSize() const
+    {
+        return _stackSize;
+    }
+
+    XIHE_NODISCARD Size getCachedCount() const;
+
+    static Size PageSize();
+
+private:
+    Size _stackSize;
+    mutable std::mutex _mutex;
+    std::vector<FiberStack> _cached;
+};
+
+/**
+ * @brief 用户态纤程
+ *
+ * x86-64 Linux 上使用手写的上下文切换，只保存被调用者保存寄存器与浮点控制字；
+ * 其他 POSIX 平台使用 ucontext。Windows 暂不支持，IsSupported() 返回 false。
+ *
+ * 纤程只能在创建它的线程上切换，入口函数不能返回，结束时切回其他纤程即可。
+ */
+class XIHE_API Fiber
+{
+public:
+    using Entry = void (*)(void* arg);
+
+    // 代表当前线程自身的执行上下文，用于从其他纤程切回线程栈
+    Fiber();
+
+    Fiber(FiberStack stack, Entry entry, void* arg);
+    ~Fiber();
+
+    Fiber(const Fiber&)            = delete;
+    Fiber& operator=(const Fiber&) = delete;
+
+    // 保存当前上下文到 this，恢复 target。this 必须是当前正在运行的纤程
+    void switchTo(Fiber& target);
+
+    XIHE_NODISCARD const FiberStack& getStack() const
+    {
+        return _stack;
+    }
+
+    static bool IsSupported();
+
+private:
+    void* _context = nullptr;
+    FiberStack _stack;
+    void* _sanitizerFiber = nullptr;
+    bool _ownsSanitizerFiber = false;
+};
+} // namespace xihe
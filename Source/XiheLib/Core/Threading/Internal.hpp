@@ -10,6 +10,10 @@
 #include <thread>
 #include "Core/Base/Defines.hpp"
 
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#  include <immintrin.h>
+#endif
+
 namespace xihe {
 inline Size HardwareConcurrency() noexcept
 {
@@ -17,4 +21,14 @@ inline Size HardwareConcurrency() noexcept
     constexpr auto fallbackCount = 8;
     return detectedCount ? detectedCount : fallbackCount;
 }
+
+// 自旋等待时提示处理器，降低功耗并让出超线程的执行资源
+XIHE_ALWAYS_INLINE void CpuRelax() noexcept
+{
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
 } // namespace xihe
@@ -0,0 +1,514 @@
+/**
+ * @File JobSystem.cpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/9/27
+ * @Brief This file is part of Xihe.
+ */
+
+#include "JobSystem.hpp"
+#include "Fiber.hpp"
+#include "Internal.hpp"
+#include "MpmcQueue.hpp"
+#include "WorkStealingDeque.hpp"
+#include "Core/Utils/Logger.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+using namespace xihe;
+
+namespace {
+// 空闲线程进入睡眠前的自旋轮数
+constexpr u32 kIdleSpins = 64;
+
+constexpr Size kNoQueue = numeric_limits<Size>::max();
+
+struct WorkerFibers;
+
+// 当前线程所属的任务系统与队列下标，工作线程启用纤程时还有其纤程状态
+struct JobThreadState
+{
+    const void* system    = nullptr;
+    Size queue            = kNoQueue;
+    WorkerFibers* fibers = nullptr;
+};
+
+thread_local JobThreadState tJobThread;
+
+// 选择窃取起点的线程本地随机数
+u32 NextRandom()
+{
+    thread_local u32 state = 0x9E3779B9u ^ As<u32>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+/**
+ * 工作线程的纤程调度状态，只由该工作线程访问。
+ * 挂起的纤程只在原工作线程上恢复，线程局部变量在纤程内始终指向同一线程。
+ */
+struct WorkerFibers
+{
+    struct Waiting
+    {
+        Fiber* fiber;
+        const JobCounter* counter;
+    };
+
+    Fiber thread;                               // 工作线程自身的栈
+    std::vector<std::unique_ptr<Fiber>> fibers; // 本线程创建的全部纤程
+    std::vector<Fiber*> idle;
+    std::vector<Waiting> waiting;
+
+    void* system      = nullptr; // 所属的任务系统（JobSystem::Impl）
+    Fiber* current    = nullptr; // 正在运行的纤程
+    void* pendingJob  = nullptr; // 交给纤程执行的任务（JobSystem::Job）
+    bool suspended    = false;   // 纤程切回时处于等待而不是执行完毕
+};
+
+// 每个工作线程的睡眠槽位：线程在自己的 wake 上睡眠，唤醒者认领 sleeping 后递增 wake，只唤醒一个确定的线程
+struct alignas(64) WorkerSlot
+{
+    std::atomic<u32> wake{0};
+    std::atomic<bool> sleeping{false};
+    std::atomic<u32> parked{0}; // 本线程挂起的纤程数
+};
+} // namespace
+
+class JobSystem::Impl
+{
+public:
+    explicit Impl(const Config& config) :
+        injected(config.queueCapacity), threadOptions(config.workerThreads)
+    {
+        const Size workers = config.workerCount != kDefaultWorkerCount ? config.workerCount : HardwareConcurrency() - 1;
+
+        // 下标 0 为创建者线程的队列
+        queues.reserve(workers + 1);
+        for (Size i = 0; i <= workers; ++i)
+            queues.push_back(std::make_unique<WorkStealingDeque<Job*>>(config.queueCapacity));
+
+        slots = std::make_unique<WorkerSlot[]>(workers + 1);
+
+        useFibers = config.useFibers && workers > 0 && Fiber::IsSupported();
+        if (useFibers)
+            stackPool.emplace(config.fiberStackSize);
+    }
+
+    std::vector<std::unique_ptr<WorkStealingDeque<Job*>>> queues;
+    std::vector<std::thread> workers;
+
+    // 非本系统线程提交的任务：先进入无锁队列，满时进入有锁的溢出队列
+    MpmcQueue<Job*> injected;
+    std::mutex overflowMutex;
+    std::deque<Job*> overflow;
+    std::atomic<Size> overflowCount{0};
+
+    // 空闲线程在各自的槽位上睡眠，提交者看到有睡眠线程时认领一个并唤醒
+    std::unique_ptr<WorkerSlot[]> slots;
+    alignas(64) std::atomic<u32> sleepers{0};
+    alignas(64) std::atomic<u32> parkedTotal{0};
+    std::atomic<bool> stopping{false};
+
+    JobThreadState previousOwnerState;
+
+    bool useFibers = false;
+    std::optional<FiberStackPool> stackPool;
+
+    ThreadOptions threadOptions;
+
+    void push(Job* job)
+    {
+        if (tJobThread.system == this)
+        {
+            queues[tJobThread.queue]->push(job);
+        }
+        else if (!injected.tryPush(job))
+        {
+            std::lock_guard lock(overflowMutex);
+            overflow.push_back(job);
+            overflowCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // 与 idle() 中先登记睡眠再检查队列的顺序配对，保证不会漏掉唤醒
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers.load(std::memory_order_relaxed) > 0)
+            wakeOne();
+    }
+
+    static bool Wake(WorkerSlot& slot)
+    {
+        bool expected = true;
+        if (!slot.sleeping.compare_exchange_strong(expected, false, std::memory_order_seq_cst))
+            return false;
+
+        slot.wake.fetch_add(1, std::memory_order_release);
+        slot.wake.notify_one();
+        return true;
+    }
+
+    void wakeOne()
+    {
+        const Size count = workers.size();
+        const Size start = NextRandom() % count;
+        for (Size i = 0; i < count; ++i)
+        {
+            if (Wake(slots[1 + (start + i) % count]))
+                return;
+        }
+    }
+
+    // 计数归零时唤醒有挂起纤程的睡眠线程，纤程只能由挂起它的线程恢复
+    void wakeParked()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (parkedTotal.load(std::memory_order_relaxed) == 0)
+            return;
+
+        for (Size i = 1; i <= workers.size(); ++i)
+        {
+            if (slots[i].parked.load(std::memory_order_relaxed) > 0)
+                Wake(slots[i]);
+        }
+    }
+
+    Job* popInjected()
+    {
+        Job* job = nullptr;
+        if (injected.tryPop(job))
+            return job;
+
+        if (overflowCount.load(std::memory_order_relaxed) == 0)
+            return nullptr;
+
+        std::lock_guard lock(overflowMutex);
+        if (overflow.empty())
+            return nullptr;
+
+        job = overflow.front();
+        overflow.pop_front();
+        overflowCount.fetch_sub(1, std::memory_order_relaxed);
+        return job;
+    }
+
+    Job* steal(Size self)
+    {
+        const Size count = queues.size();
+        const Size start = NextRandom() % count;
+        for (Size i = 0; i < count; ++i)
+        {
+            const Size victim = (start + i) % count;
+            if (victim == self)
+                continue;
+            if (auto* job = queues[victim]->steal())
+                return job;
+        }
+        return nullptr;
+    }
+
+    // 依次查找：自己的队列、注入队列、其他线程的队列
+    Job* findJob(Size self)
+    {
+        if (self != kNoQueue)
+        {
+            if (auto* job = queues[self]->pop())
+                return job;
+        }
+        if (auto* job = popInjected())
+            return job;
+        return steal(self);
+    }
+
+    void execute(Job* job)
+    {
+        try
+        {
+            job->execute();
+        }
+        catch (const std::exception& e)
+        {
+            XIHE_CORE_ERROR("任务执行时抛出异常：{}", e.what());
+        }
+        catch (...)
+        {
+            XIHE_CORE_ERROR("任务执行时抛出未知异常");
+        }
+
+        // 归零后计数可能立即被等待者释放，之后不能再访问 counter
+        auto* counter = job->counter;
+        delete job;
+        if (counter && counter->_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            wakeParked();
+    }
+
+    Size currentQueue() const
+    {
+        return tJobThread.system == this ? tJobThread.queue : kNoQueue;
+    }
+
+    void workerLoop(Size index)
+    {
+        std::optional<WorkerFibers> fibers;
+        if (useFibers)
+            fibers.emplace().system = this;
+        tJobThread = {this, index, fibers ? &*fibers : nullptr};
+        ApplyThreadOptions(MakeWorkerThreadOptions(threadOptions, index - 1));
+
+        // 停止时仍要等挂起的纤程完成
+        while (!stopping.load(std::memory_order_acquire) || (fibers && !fibers->waiting.empty()))
+        {
+            if (fibers && resumeWaiting(*fibers, index))
+                continue;
+
+            auto* job = findJob(index);
+            if (!job)
+                job = idle(index, fibers ? &*fibers : nullptr);
+            if (!job)
+                continue;
+
+            if (fibers)
+                runOnNewFiber(*fibers, job);
+            else
+                execute(job);
+        }
+
+        if (fibers)
+        {
+            for (const auto& fiber : fibers->fibers)
+                stackPool->release(fiber->getStack());
+        }
+        tJobThread = {};
+    }
+
+    Job* idle(Size index, const WorkerFibers* fibers)
+    {
+        for (u32 i = 0; i < kIdleSpins; ++i)
+        {
+            CpuRelax();
+            if (auto* job = findJob(index))
+                return job;
+        }
+
+        // 先登记睡眠再检查队列与挂起纤程的计数，与 push() / wakeParked() 中先发布再检查睡眠者的顺序配对
+        auto& slot = slots[index];
+        slot.sleeping.store(true, std::memory_order_seq_cst);
+        sleepers.fetch_add(1, std::memory_order_seq_cst);
+        const u32 observed = slot.wake.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        Job* job         = findJob(index);
+        const bool sleep = !job && !(fibers && HasReadyFiber(*fibers)) && !stopping.load(std::memory_order_acquire);
+        if (sleep)
+            slot.wake.wait(observed, std::memory_order_acquire);
+
+        sleepers.fetch_sub(1, std::memory_order_relaxed);
+        // 没有睡眠却被认领时，把这次唤醒转交给其他睡眠线程，避免新任务无人处理
+        if (!slot.sleeping.exchange(false, std::memory_order_acq_rel) && !sleep && sleepers.load(std::memory_order_relaxed) > 0)
+            wakeOne();
+        return job;
+    }
+
+    // ---------------- 纤程 ----------------
+
+    static void FiberMain(void* arg)
+    {
+        auto& fibers = *static_cast<WorkerFibers*>(arg);
+        auto& system = *static_cast<Impl*>(fibers.system);
+        for (;;)
+        {
+            auto* self = fibers.current;
+            auto* job  = static_cast<Job*>(fibers.pendingJob);
+            fibers.pendingJob = nullptr;
+            system.execute(job);
+
+            fibers.suspended = false;
+            self->switchTo(fibers.thread);
+        }
+    }
+
+    // 切换到纤程，直到它执行完任务或在 wait() 中挂起
+    static void Resume(WorkerFibers& fibers, Fiber* fiber)
+    {
+        fibers.current = fiber;
+        fibers.thread.switchTo(*fiber);
+        fibers.current = nullptr;
+
+        if (!fibers.suspended)
+            fibers.idle.push_back(fiber);
+        fibers.suspended = false;
+    }
+
+    void runOnNewFiber(WorkerFibers& fibers, Job* job)
+    {
+        Fiber* fiber = nullptr;
+        if (fibers.idle.empty())
+        {
+            fibers.fibers.push_back(std::make_unique<Fiber>(stackPool->acquire(), &FiberMain, &fibers));
+            fiber = fibers.fibers.back().get();
+        }
+        else
+        {
+            fiber = fibers.idle.back();
+            fibers.idle.pop_back();
+        }
+
+        fibers.pendingJob = job;
+        Resume(fibers, fiber);
+    }
+
+    static bool HasReadyFiber(const WorkerFibers& fibers)
+    {
+        return std::ranges::any_of(fibers.waiting, [](const auto& waiting) { return waiting.counter->isDone(); });
+    }
+
+    bool resumeWaiting(WorkerFibers& fibers, Size index)
+    {
+        for (Size i = 0; i < fibers.waiting.size(); ++i)
+        {
+            if (!fibers.waiting[i].counter->isDone())
+                continue;
+
+            auto* fiber       = fibers.waiting[i].fiber;
+            fibers.waiting[i] = fibers.waiting.back();
+            fibers.waiting.pop_back();
+            slots[index].parked.fetch_sub(1, std::memory_order_relaxed);
+            parkedTotal.fetch_sub(1, std::memory_order_relaxed);
+            Resume(fibers, fiber);
+            return true;
+        }
+        return false;
+    }
+
+    // 在纤程中等待：挂起当前纤程，计数归零后由调度循环恢复。
+    // 先登记挂起再由调度循环检查计数，与 execute() 中先归零再检查挂起数的顺序配对
+    void suspendUntil(WorkerFibers& fibers, const JobCounter& counter)
+    {
+        slots[tJobThread.queue].parked.fetch_add(1, std::memory_order_relaxed);
+        parkedTotal.fetch_add(1, std::memory_order_seq_cst);
+
+        auto* self = fibers.current;
+        fibers.waiting.push_back({self, &counter});
+        fibers.suspended = true;
+        self->switchTo(fibers.thread);
+    }
+
+    void stop()
+    {
+        stopping.store(true, std::memory_order_seq_cst);
+        for (Size i = 1; i <= workers.size(); ++i)
+            Wake(slots[i]);
+
+        for (auto& worker : workers)
+        {
+            if (worker.joinable())
+                worker.join();
+        }
+
+        // 工作线程已退出，剩余任务（包括执行中新提交的）在当前线程完成
+        while (auto* job = findJob(currentQueue()))
+            execute(job);
+    }
+};
+
+// ======================================
+
+JobSystem::JobSystem() :
+    JobSystem(Config{})
+{
+}
+
+JobSystem::JobSystem(const Config& config) :
+    _pImpl(std::make_unique<Impl>(config))
+{
+    _pImpl->previousOwnerState = tJobThread;
+    tJobThread                 = {_pImpl.get(), 0};
+
+    const Size workers = _pImpl->queues.size() - 1;
+    _pImpl->workers.reserve(workers);
+    for (Size i = 1; i <= workers; ++i)
+        _pImpl->workers.emplace_back(&Impl::workerLoop, _pImpl.get(), i);
+}
+
+JobSystem::~JobSystem()
+{
+    if (_pImpl)
+    {
+        _pImpl->stop();
+        if (tJobThread.system == _pImpl.get())
+            tJobThread = _pImpl->previousOwnerState;
+    }
+}
+
+void JobSystem::submit(Job* job)
+{
+    _pImpl->push(job);
+}
+
+void JobSystem::wait(const JobCounter& counter)
+{
+    if (counter.isDone())
+        return;
+
+    // 工作线程的纤程中等待时挂起纤程，工作线程继续执行其他任务
+    if (tJobThread.system == _pImpl.get() && tJobThread.fibers && tJobThread.fibers->current)
+    {
+        _pImpl->suspendUntil(*tJobThread.fibers, counter);
+        return;
+    }
+
+    const Size self = _pImpl->currentQueue();
+
+    u32 spins = 0;
+    while (!counter.isDone())
+    {
+        if (auto* job = _pImpl->findJob(self))
+        {
+            _pImpl->execute(job);
+            spins = 0;
+            continue;
+        }
+
+        // 剩余任务正在其他线程执行
+        if (++spins < kIdleSpins)
+            CpuRelax();
+        else
+            std::this_thread::yield();
+    }
+}
+
+bool JobSystem::runOne()
+{
+    if (auto* job = _pImpl->findJob(_pImpl->currentQueue()))
+    {
+        _pImpl->execute(job);
+        return true;
+    }
+    return false;
+}
+
+Size JobSystem::getWorkerCount() const
+{
+    return _pImpl->workers.size();
+}
+
+Size JobSystem::getLocalQueueSize() const
+{
+    const Size self = _pImpl->currentQueue();
+    return self != kNoQueue ? _pImpl->queues[self]->size() : 0;
+}
+
+bool JobSystem::isUsingFibers() const
+{
+    return _pImpl->useFibers;
+}
+
+bool JobSystem::isOwnThread() const
+{
+    return tJobThread.system == _pImpl.get();
+}
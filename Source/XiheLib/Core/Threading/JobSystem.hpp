@@ -0,0 +1,174 @@
+/**
+ * @File JobSystem.hpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/9/27
+ * @Brief This file is part of Xihe.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <concepts>
+#include <memory>
+#include <type_traits>
+
+#include "Core/Base/Defines.hpp"
+#include "Core/Memory/Memory.hpp"
+#include "Core/Threading/Threads.hpp"
+
+namespace xihe {
+/**
+ * @brief 任务完成计数
+ *
+ * 每提交一个关联的任务加 1，任务执行完后减 1，归零表示所有关联任务都已完成。
+ * 计数对象需要在关联任务全部完成前保持有效，同一计数可以在完成后继续复用。
+ * 一个计数只关联同一个任务系统的任务，否则归零时无法唤醒等待它的纤程。
+ */
+class JobCounter
+{
+public:
+    JobCounter() = default;
+
+    JobCounter(const JobCounter&)            = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    XIHE_NODISCARD bool isDone() const
+    {
+        return _pending.load(std::memory_order_acquire) == 0;
+    }
+
+    XIHE_NODISCARD u32 pending() const
+    {
+        return _pending.load(std::memory_order_acquire);
+    }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<u32> _pending{0};
+};
+
+/**
+ * @brief 工作窃取任务系统
+ *
+ * - 每个工作线程拥有一个 Chase-Lev 队列，任务内提交的子任务进入当前线程的队列，空闲线程从其他队列窃取；
+ * - 创建者线程（通常是主线程）同样拥有一个队列，在 wait() 中参与执行任务；
+ * - 其他线程提交的任务进入共享的注入队列；
+ * - 默认工作线程数为 HardwareConcurrency() - 1，与创建者线程一起占满所有核心而不过量订阅；
+ * - 启用纤程时工作线程在纤程上执行任务，任务内 wait() 挂起纤程，计数归零后唤醒并由同一工作线程恢复；
+ *   未启用时以及创建者线程与其他线程上的 wait() 在等待期间执行其他任务。
+ *
+ * 任务抛出的异常会被记录到日志，不会传播到等待者。析构时执行完所有剩余任务。
+ */
+class XIHE_API JobSystem
+{
+public:
+    static constexpr Size kDefaultWorkerCount = numeric_limits<Size>::max();
+
+    struct Config
+    {
+        // 工作线程数，默认取 HardwareConcurrency() - 1。为 0 时所有任务在等待时由创建者线程执行
+        Size workerCount = kDefaultWorkerCount;
+
+        // 每个线程工作窃取队列的初始容量，不足时自动扩容；也是外部线程提交队列的无锁部分容量
+        Size queueCapacity = 1024;
+
+        // 工作线程上的任务在纤程中执行，任务内等待时挂起纤程，工作线程继续执行其他任务。
+        // 平台不支持纤程时忽略，等待期间在当前栈上执行其他任务。
+        // 同一线程上会穿插执行其他纤程，启用时任务不能跨 wait() 持有锁（见 wait()）
+        bool useFibers = false;
+
+        // 纤程栈大小，任务内避免在栈上放置大对象
+        Size fiberStackSize = 64 * 1024;
+
+        // 工作线程属性，名称后追加线程下标；亲和性掩码可以让工作线程避开主线程所在核心
+        ThreadOptions workerThreads{.name = "XiheJob"};
+    };
+
+    JobSystem();
+    explicit JobSystem(const Config& config);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&)            = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // 提交任务，counter 不为空时在任务完成后减 1
+    template <typename F>
+        requires std::invocable<std::decay_t<F>&>
+    void run(F&& func, JobCounter* counter = nullptr)
+    {
+        if (counter)
+            counter->_pending.fetch_add(1, std::memory_order_relaxed);
+        submit(new JobImpl<std::decay_t<F>>(std::forward<F>(func), counter));
+    }
+
+    /**
+     * @brief 等待计数归零，期间当前线程执行待处理的任务
+     *
+     * 等待期间同一线程（或同一线程上的其他纤程）会执行其他任务，调用时不能持有
+     * std::mutex、SpinLock、EpochGuard 等与线程绑定或可能被其他任务获取的锁，否则会死锁或破坏锁的归属。
+     */
+    void wait(const JobCounter& counter);
+
+    // 在当前线程执行一个待处理的任务，没有任务时返回 false
+    bool runOne();
+
+    XIHE_NODISCARD Size getWorkerCount() const;
+
+    // 当前线程队列中待执行的任务数（近似值），不属于本系统的线程返回 0。用于按需拆分任务
+    XIHE_NODISCARD Size getLocalQueueSize() const;
+
+    XIHE_NODISCARD bool isUsingFibers() const;
+
+    // 当前线程是否是该任务系统的工作线程或创建者线程
+    XIHE_NODISCARD bool isOwnThread() const;
+
+private:
+    struct Job
+    {
+        explicit Job(JobCounter* inCounter) :
+            counter(inCounter)
+        {
+        }
+
+        virtual ~Job() = default;
+
+        virtual void execute() = 0;
+
+        static void* operator new(Size size)
+        {
+            return mi_malloc(size);
+        }
+
+        static void operator delete(void* ptr)
+        {
+            mi_free(ptr);
+        }
+
+        JobCounter* counter;
+    };
+
+    template <typename F>
+    struct JobImpl final : Job
+    {
+        template <typename U>
+        JobImpl(U&& inFunc, JobCounter* inCounter) :
+            Job(inCounter)
+          , func(std::forward<U>(inFunc))
+        {
+        }
+
+        void execute() override
+        {
+            func();
+        }
+
+        F func;
+    };
+
+    void submit(Job* job);
+
+    class Impl;
+    std::unique_ptr<Impl> _pImpl;
+};
+} // namespace xihe
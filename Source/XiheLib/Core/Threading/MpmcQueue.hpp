@@ -0,0 +1,234 @@
+/**
+ * @File MpmcQueue.hpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/10/4
+ * @Brief This file is part of Xihe.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "Core/Base/Defines.hpp"
+
+namespace xihe {
+/**
+ * @brief 有界多生产者多消费者无锁队列
+ *
+ * 参考 Dmitry Vyukov 的 bounded MPMC queue：每个槽位带一个序号，生产者看到序号等于入队位置时槽位为空，
+ * 消费者看到序号等于出队位置 + 1 时槽位有数据。生产者之间、消费者之间各自只竞争一个计数器，
+ * 生产者与消费者之间只通过槽位序号同步。
+ *
+ * - 容量向上取整为 2 的幂，队列满时 push 失败、空时 pop 失败，不阻塞；
+ * - 批量操作用一次 CAS 占用连续的多个槽位，部分成功时返回实际数量；
+ * - 不保证严格的全局 FIFO：多个生产者同时入队时，顺序由各自占到的位置决定。
+ */
+template <typename T>
+    requires std::is_nothrow_move_constructible_v<T>
+class MpmcQueue
+{
+public:
+    explicit MpmcQueue(Size capacity) :
+        _mask(std::bit_ceil(std::max<Size>(capacity, 2)) - 1),
+        _cells(std::make_unique<Cell[]>(_mask + 1))
+    {
+        for (Size i = 0; i <= _mask; ++i)
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    // 析构时不能有并发的读写
+    ~MpmcQueue()
+    {
+        const Size end = _enqueuePos.load(std::memory_order_relaxed);
+        for (Size pos = _dequeuePos.load(std::memory_order_relaxed); pos != end; ++pos)
+            std::destroy_at(_cells[pos & _mask].item());
+    }
+
+    MpmcQueue(const MpmcQueue&)            = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    // 构造可能抛出时先在局部构造再移入，避免占到槽位后构造失败使槽位永远处于占用状态
+    template <typename... Args>
+    bool tryEmplace(Args&&... args)
+    {
+        if constexpr (std::is_nothrow_constructible_v<T, Args...>)
+            return emplace(std::forward<Args>(args)...);
+        else
+            return emplace(T(std::forward<Args>(args)...));
+    }
+
+    bool tryPush(const T& item) { return tryEmplace(item); }
+
+    bool tryPush(T&& item) { return tryEmplace(std::move(item)); }
+
+    bool tryPop(T& out)
+    {
+        Size pos = _dequeuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Cell& cell       = _cells[pos & _mask];
+            const Size seq   = cell.sequence.load(std::memory_order_acquire);
+            const auto delta = static_cast<std::make_signed_t<Size>>(seq - (pos + 1));
+            if (delta == 0)
+            {
+                if (_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    take(cell, pos, out);
+                    return true;
+                }
+            }
+            else if (delta < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = _dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // 从 items 开头依次移入，返回入队数量
+    Size tryPushBatch(std::span<T> items)
+    {
+        if (items.empty())
+            return 0;
+
+        Size pos = _enqueuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            // 从 pos 开始连续为空的槽位。这些槽位在其他生产者推进 _enqueuePos 之前不会被占用，
+            // 因此 CAS 成功时全部可写
+            Size count = 0;
+            while (count < items.size() &&
+                   _cells[(pos + count) & _mask].sequence.load(std::memory_order_acquire) == pos + count)
+                ++count;
+
+            if (count == 0)
+            {
+                const Size seq = _cells[pos & _mask].sequence.load(std::memory_order_acquire);
+                if (static_cast<std::make_signed_t<Size>>(seq - pos) < 0)
+                    return 0;
+                pos = _enqueuePos.load(std::memory_order_relaxed);
+                continue;
+            }
+
+            if (_enqueuePos.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed))
+            {
+                for (Size i = 0; i < count; ++i)
+                {
+                    Cell& cell = _cells[(pos + i) & _mask];
+                    ::new (cell.storage) T(std::move(items[i]));
+                    cell.sequence.store(pos + i + 1, std::memory_order_release);
+                }
+                return count;
+            }
+        }
+    }
+
+    // 最多取出 out.size() 个元素，返回实际数量
+    Size tryPopBatch(std::span<T> out)
+    {
+        if (out.empty())
+            return 0;
+
+        Size pos = _dequeuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Size count = 0;
+            while (count < out.size() &&
+                   _cells[(pos + count) & _mask].sequence.load(std::memory_order_acquire) == pos + count + 1)
+                ++count;
+
+            if (count == 0)
+            {
+                const Size seq = _cells[pos & _mask].sequence.load(std::memory_order_acquire);
+                if (static_cast<std::make_signed_t<Size>>(seq - (pos + 1)) < 0)
+                    return 0;
+                pos = _dequeuePos.load(std::memory_order_relaxed);
+                continue;
+            }
+
+            if (_dequeuePos.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed))
+            {
+                for (Size i = 0; i < count; ++i)
+                    take(_cells[(pos + i) & _mask], pos + i, out[i]);
+                return count;
+            }
+        }
+    }
+
+    Size capacity() const noexcept { return _mask + 1; }
+
+    // 并发修改时只是近似值
+    Size sizeApprox() const noexcept
+    {
+        const Size enqueue = _enqueuePos.load(std::memory_order_relaxed);
+        const Size dequeue = _dequeuePos.load(std::memory_order_relaxed);
+        return enqueue > dequeue ? enqueue - dequeue : 0;
+    }
+
+private:
+    struct Cell
+    {
+        std::atomic<Size> sequence;
+        alignas(T) std::byte storage[sizeof(T)];
+
+        T* item() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    // 占到槽位后才构造元素，只接受不抛出的构造
+    template <typename... Args>
+        requires std::is_nothrow_constructible_v<T, Args...>
+    bool emplace(Args&&... args) noexcept
+    {
+        Size pos = _enqueuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Cell& cell       = _cells[pos & _mask];
+            const Size seq   = cell.sequence.load(std::memory_order_acquire);
+            const auto delta = static_cast<std::make_signed_t<Size>>(seq - pos);
+            if (delta == 0)
+            {
+                if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    ::new (cell.storage) T(std::forward<Args>(args)...);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (delta < 0)
+            {
+                // 槽位仍被上一轮的数据占用：队列已满
+                return false;
+            }
+            else
+            {
+                pos = _enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // 取出元素后把槽位留给下一轮的生产者
+    void take(Cell& cell, Size pos, T& out)
+    {
+        T* item = cell.item();
+        out     = std::move(*item);
+        std::destroy_at(item);
+        cell.sequence.store(pos + _mask + 1, std::memory_order_release);
+    }
+
+    const Size _mask;
+    const std::unique_ptr<Cell[]> _cells;
+
+    alignas(64) std::atomic<Size> _enqueuePos{0};
+    alignas(64) std::atomic<Size> _dequeuePos{0};
+};
+} // namespace xihe
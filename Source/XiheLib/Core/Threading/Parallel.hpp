@@ -0,0 +1,284 @@
+/**
+ * @File Parallel.hpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/9/29
+ * @Brief This file is part of Xihe.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <iterator>
+#include <span>
+#include <vector>
+
+#include "Core/Base/Concepts.hpp"
+#include "Core/Threading/JobSystem.hpp"
+
+/**
+ * 基于 JobSystem 的数据并行原语，引擎代码通常传入 Context::Get().jobs()。
+ *
+ * - 区间按惰性二分拆分（lazy binary splitting）：任务每处理一个粒度的数据前检查本线程队列，
+ *   队列为空（其他线程没有可窃取的任务）时才把剩余区间对半拆出一个子任务，否则继续串行处理；
+ * - grain 为 0 时只按区间长度决定粒度，与线程数无关，因此 Reduce/Scan 的分块与合并顺序固定，
+ *   浮点等不满足结合律的运算在不同机器上也得到相同结果；
+ * - 调用线程参与执行并等待全部完成。调用线程上的异常会在其他任务完成后继续抛出，
+ *   其他线程上的异常按 JobSystem 的约定记录到日志。
+ */
+namespace xihe {
+namespace details {
+// 默认分块数，粒度取 size / kParallelChunks
+constexpr Size kParallelChunks = 256;
+
+inline Size ParallelGrain(Size size, Size grain)
+{
+    return grain != 0 ? grain : std::max<Size>(1, size / kParallelChunks);
+}
+
+// body(begin, end) 处理 [begin, end)，每次至多 grain 个元素
+template <typename Body>
+void LazySplit(JobSystem& jobs, Size begin, Size end, Size grain, const Body& body, JobCounter& counter)
+{
+    while (end - begin > grain)
+    {
+        if (jobs.getLocalQueueSize() == 0)
+        {
+            const Size mid = begin + (end - begin) / 2;
+            jobs.run([&jobs, mid, end, grain, &body, &counter]
+            {
+                LazySplit(jobs, mid, end, grain, body, counter);
+            }, &counter);
+            end = mid;
+            continue;
+        }
+
+        body(begin, begin + grain);
+        begin += grain;
+    }
+
+    if (begin < end)
+        body(begin, end);
+}
+
+template <typename Body>
+void RunLazySplit(JobSystem& jobs, Size begin, Size end, Size grain, const Body& body)
+{
+    if (begin >= end)
+        return;
+
+    JobCounter counter;
+    try
+    {
+        LazySplit(jobs, begin, end, grain, body, counter);
+    }
+    catch (...)
+    {
+        // 子任务仍引用 body 与 counter
+        jobs.wait(counter);
+        throw;
+    }
+    jobs.wait(counter);
+}
+} // namespace details
+
+/**
+ * @brief 并行执行 func(i)，i ∈ [begin, end)
+ */
+template <typename F>
+    requires std::invocable<F&, Size>
+void ParallelFor(JobSystem& jobs, Size begin, Size end, F&& func, Size grain = 0)
+{
+    if (begin >= end)
+        return;
+
+    grain = details::ParallelGrain(end - begin, grain);
+    details::RunLazySplit(jobs, begin, end, grain, [&func](Size first, Size last)
+    {
+        for (Size i = first; i < last; ++i)
+            func(i);
+    });
+}
+
+/**
+ * @brief 并行执行 func(first, last)，每次调用处理一段连续区间，适合需要在区间内做向量化或累积的循环
+ */
+template <typename F>
+    requires std::invocable<F&, Size, Size>
+void ParallelForRange(JobSystem& jobs, Size begin, Size end, F&& func, Size grain = 0)
+{
+    if (begin >= end)
+        return;
+
+    grain = details::ParallelGrain(end - begin, grain);
+    details::RunLazySplit(jobs, begin, end, grain, [&func](Size first, Size last) { func(first, last); });
+}
+
+/**
+ * @brief 并行归约
+ *
+ * 区间按 grain 划分为固定的块，每块计算 func(first, last, identity)，各块结果再按顺序用 reduce 合并。
+ * 分块只取决于区间长度与 grain，因此结果确定。
+ *
+ * @param func   T(Size first, Size last, T init)，在 init 基础上累积 [first, last)
+ * @param reduce T(T lhs, T rhs)，合并两个相邻块的结果
+ */
+template <typename T, typename F, typename R>
+    requires std::invocable<F&, Size, Size, T> && std::invocable<R&, T, T>
+T ParallelReduce(JobSystem& jobs, Size begin, Size end, T identity, F&& func, R&& reduce, Size grain = 0)
+{
+    if (begin >= end)
+        return identity;
+
+    const Size size       = end - begin;
+    grain                 = details::ParallelGrain(size, grain);
+    const Size chunkCount = (size + grain - 1) / grain;
+
+    std::vector<T> partials(chunkCount, identity);
+    details::RunLazySplit(jobs, 0, chunkCount, 1, [&](Size firstChunk, Size lastChunk)
+    {
+        for (Size chunk = firstChunk; chunk < lastChunk; ++chunk)
+        {
+            const Size first = begin + chunk * grain;
+            const Size last  = std::min(first + grain, end);
+            partials[chunk]  = func(first, last, identity);
+        }
+    });
+
+    T result = std::move(partials[0]);
+    for (Size chunk = 1; chunk < chunkCount; ++chunk)
+        result = reduce(std::move(result), std::move(partials[chunk]));
+    return result;
+}
+
+/**
+ * @brief 并行包含式前缀扫描，output[i] = input[0] op ... op input[i]
+ *
+ * 两遍分块扫描：先并行求各块的合计，串行得到各块的前缀，再并行扫描各块。
+ * 与 ParallelReduce 相同，分块固定，结果确定。input 与 output 可以是同一段内存。
+ */
+template <typename T, typename Op = std::plus<>>
+    requires std::invocable<Op&, T, T>
+void ParallelScan(JobSystem& jobs, std::span<const T> input, std::span<T> output, Op op = {}, Size grain = 0)
+{
+    const Size size = std::min(input.size(), output.size());
+    if (size == 0)
+        return;
+
+    grain                 = details::ParallelGrain(size, grain);
+    const Size chunkCount = (size + grain - 1) / grain;
+
+    // 第一遍：各块的合计
+    std::vector<T> sums(chunkCount);
+    ParallelFor(jobs, 0, chunkCount, [&](Size chunk)
+    {
+        const Size first = chunk * grain;
+        const Size last  = std::min(first + grain, size);
+        T sum            = input[first];
+        for (Size i = first + 1; i < last; ++i)
+            sum = op(std::move(sum), input[i]);
+        sums[chunk] = std::move(sum);
+    }, 1);
+
+    // 各块之前所有元素的合计
+    for (Size chunk = 1; chunk < chunkCount; ++chunk)
+        sums[chunk] = op(sums[chunk - 1], sums[chunk]);
+
+    // 第二遍：块内扫描
+    ParallelFor(jobs, 0, chunkCount, [&](Size chunk)
+    {
+        const Size first = chunk * grain;
+        const Size last  = std::min(first + grain, size);
+        T running        = chunk == 0 ? T(input[first]) : T(op(sums[chunk - 1], input[first]));
+        output[first]    = running;
+        for (Size i = first + 1; i < last; ++i)
+        {
+            running   = op(std::move(running), input[i]);
+            output[i] = running;
+        }
+    }, 1);
+}
+
+namespace details {
+// 小于该长度的区间直接用 std::sort
+constexpr Size kParallelSortCutoff = 2048;
+
+template <typename It, typename Compare>
+void ParallelSortImpl(JobSystem& jobs, It first, It last, Compare& comp, Size cutoff, u32 depth, JobCounter& counter)
+{
+    while (As<Size>(last - first) > cutoff && depth > 0)
+    {
+        --depth;
+
+        // 三数取中
+        auto mid = first + (last - first) / 2;
+        if (comp(*mid, *first))
+            std::iter_swap(mid, first);
+        if (comp(*(last - 1), *mid))
+        {
+            std::iter_swap(last - 1, mid);
+            if (comp(*mid, *first))
+                std::iter_swap(mid, first);
+        }
+        const auto pivot = *mid;
+
+        // 三路划分，等于 pivot 的元素不再参与递归
+        auto lower = std::partition(first, last, [&](const auto& value) { return comp(value, pivot); });
+        auto upper = std::partition(lower, last, [&](const auto& value) { return !comp(pivot, value); });
+
+        // 较短的一侧作为子任务，较长的一侧在当前线程继续
+        if (lower - first < last - upper)
+        {
+            jobs.run([&jobs, first, lower, &comp, cutoff, depth, &counter]
+            {
+                ParallelSortImpl(jobs, first, lower, comp, cutoff, depth, counter);
+            }, &counter);
+            first = upper;
+        }
+        else
+        {
+            jobs.run([&jobs, upper, last, &comp, cutoff, depth, &counter]
+            {
+                ParallelSortImpl(jobs, upper, last, comp, cutoff, depth, counter);
+            }, &counter);
+            last = lower;
+        }
+    }
+
+    // 区间足够小，或划分退化到深度上限
+    std::sort(first, last, comp);
+}
+} // namespace details
+
+/**
+ * @brief 并行排序，不稳定，与 std::sort 相同
+ *
+ * 并行快速排序：三数取中、三路划分，较短一侧作为子任务提交；递归深度超过 2·log2(n) 时退回 std::sort。
+ */
+template <std::random_access_iterator It, typename Compare = std::less<>>
+void ParallelSort(JobSystem& jobs, It first, It last, Compare comp = {}, Size cutoff = 0)
+{
+    const Size size = As<Size>(last - first);
+    cutoff          = std::max<Size>(cutoff != 0 ? cutoff : details::kParallelSortCutoff, 3);
+    if (size <= cutoff)
+    {
+        std::sort(first, last, comp);
+        return;
+    }
+
+    const u32 depth = 2 * As<u32>(std::bit_width(size));
+
+    JobCounter counter;
+    try
+    {
+        details::ParallelSortImpl(jobs, first, last, comp, cutoff, depth, counter);
+    }
+    catch (...)
+    {
+        jobs.wait(counter);
+        throw;
+    }
+    jobs.wait(counter);
+}
+} // namespace xihe
@@ -0,0 +1,181 @@
+/**
+ * @File SpscQueue.hpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/10/4
+ * @Brief This file is part of Xihe.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "Core/Base/Defines.hpp"
+
+namespace xihe {
+/**
+ * @brief 有界单生产者单消费者环形队列
+ *
+ * - 生产者与消费者的下标分别位于独立的缓存行，各自缓存对方下标的最近值，
+ *   只有缓存值显示队列满/空时才读取对方的缓存行；
+ * - 批量操作只发布一次下标，摊薄同步开销；
+ * - 只能有一个线程调用 push 系列、一个线程调用 pop 系列。
+ */
+template <typename T>
+    requires std::is_nothrow_move_constructible_v<T>
+class SpscQueue
+{
+public:
+    explicit SpscQueue(Size capacity) :
+        _mask(std::bit_ceil(std::max<Size>(capacity, 2)) - 1),
+        _slots(std::make_unique<Slot[]>(_mask + 1))
+    {
+    }
+
+    // 析构时不能有并发的读写
+    ~SpscQueue()
+    {
+        const Size tail = _tail.load(std::memory_order_relaxed);
+        for (Size head = _head.load(std::memory_order_relaxed); head != tail; ++head)
+            std::destroy_at(_slots[head & _mask].item());
+    }
+
+    SpscQueue(const SpscQueue&)            = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // ======================================
+    // 生产者
+
+    template <typename... Args>
+    bool tryEmplace(Args&&... args)
+    {
+        const Size tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _cachedHead > _mask)
+        {
+            _cachedHead = _head.load(std::memory_order_acquire);
+            if (tail - _cachedHead > _mask)
+                return false;
+        }
+
+        ::new (_slots[tail & _mask].storage) T(std::forward<Args>(args)...);
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPush(const T& item) { return tryEmplace(item); }
+
+    bool tryPush(T&& item) { return tryEmplace(std::move(item)); }
+
+    // 从 items 开头依次移入，返回入队数量
+    Size tryPushBatch(std::span<T> items)
+    {
+        const Size tail = _tail.load(std::memory_order_relaxed);
+        Size free       = capacity() - (tail - _cachedHead);
+        if (free < items.size())
+        {
+            _cachedHead = _head.load(std::memory_order_acquire);
+            free        = capacity() - (tail - _cachedHead);
+        }
+
+        const Size count = std::min(free, items.size());
+        for (Size i = 0; i < count; ++i)
+            ::new (_slots[(tail + i) & _mask].storage) T(std::move(items[i]));
+        if (count > 0)
+            _tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    // ======================================
+    // 消费者
+
+    bool tryPop(T& out)
+    {
+        const Size head = _head.load(std::memory_order_relaxed);
+        if (head == _cachedTail)
+        {
+            _cachedTail = _tail.load(std::memory_order_acquire);
+            if (head == _cachedTail)
+                return false;
+        }
+
+        T* item = _slots[head & _mask].item();
+        out     = std::move(*item);
+        std::destroy_at(item);
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 队首元素，队列为空时返回 nullptr；指针在 pop 之前有效
+    T* front()
+    {
+        const Size head = _head.load(std::memory_order_relaxed);
+        if (head == _cachedTail)
+        {
+            _cachedTail = _tail.load(std::memory_order_acquire);
+            if (head == _cachedTail)
+                return nullptr;
+        }
+        return _slots[head & _mask].item();
+    }
+
+    // 最多取出 out.size() 个元素，返回实际数量
+    Size tryPopBatch(std::span<T> out)
+    {
+        const Size head = _head.load(std::memory_order_relaxed);
+        Size available  = _cachedTail - head;
+        if (available < out.size())
+        {
+            _cachedTail = _tail.load(std::memory_order_acquire);
+            available   = _cachedTail - head;
+        }
+
+        const Size count = std::min(available, out.size());
+        for (Size i = 0; i < count; ++i)
+        {
+            T* item = _slots[(head + i) & _mask].item();
+            out[i]  = std::move(*item);
+            std::destroy_at(item);
+        }
+        if (count > 0)
+            _head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    // ======================================
+
+    Size capacity() const noexcept { return _mask + 1; }
+
+    // 并发修改时只是近似值
+    Size sizeApprox() const noexcept
+    {
+        const Size head = _head.load(std::memory_order_relaxed);
+        const Size tail = _tail.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+private:
+    struct Slot
+    {
+        alignas(T) std::byte storage[sizeof(T)];
+
+        T* item() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    const Size _mask;
+    const std::unique_ptr<Slot[]> _slots;
+
+    // 生产者写 _tail，读 _cachedHead
+    alignas(64) std::atomic<Size> _tail{0};
+    Size _cachedHead = 0;
+
+    // 消费者写 _head，读 _cachedTail
+    alignas(64) std::atomic<Size> _head{0};
+    Size _cachedTail = 0;
+};
+} // namespace xihe
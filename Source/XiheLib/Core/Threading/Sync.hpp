@@ -0,0 +1,352 @@
+/**
+ * @File Sync.hpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/10/3
+ * @Brief This file is part of Xihe.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+#include "Core/Base/Defines.hpp"
+#include "Core/Threading/Internal.hpp"
+
+namespace xihe {
+/**
+ * @brief 同步原语
+ *
+ * 面向很短的临界区（若干条指令到几百纳秒），满足 Lockable 要求，可以配合 std::lock_guard 使用：
+ * - SpinLock：TTAS 自旋锁，失败后指数退避，无竞争时开销最低；
+ * - TicketLock：按到达顺序获取，竞争激烈时避免饥饿；
+ * - AdaptiveMutex：先自旋，仍未获取时通过 atomic::wait 睡眠（Linux 上为 futex，Windows 上为 WaitOnAddress）；
+ * - SeqLock：读多写少的小对象，读者不写共享内存；
+ * - Latch / Barrier：基于 atomic::wait 的一次性与可重复同步点。
+ *
+ * 自旋锁只在长时间等待后才让出线程，临界区较长或线程数超过核心数时应使用 AdaptiveMutex。
+ */
+
+namespace details {
+// 自旋一段时间后再进入内核等待，值未改变时返回
+template <typename T>
+void SpinThenWait(const std::atomic<T>& value, T old, std::memory_order order) noexcept
+{
+    constexpr u32 kSpinCount = 64;
+    for (u32 i = 0; i < kSpinCount; ++i)
+    {
+        if (value.load(order) != old)
+            return;
+        CpuRelax();
+    }
+    value.wait(old, order);
+}
+} // namespace details
+
+// ======================================
+// SpinLock
+
+class SpinLock
+{
+public:
+    void lock() noexcept
+    {
+        for (;;)
+        {
+            if (!_locked.exchange(true, std::memory_order_acquire))
+                return;
+
+            // 只读等待，锁被释放前不产生缓存行的写竞争；退避到上限后让出线程，持有者被换出时不会空转整个时间片
+            u32 backoff = 1;
+            while (_locked.load(std::memory_order_relaxed))
+            {
+                if (backoff == kMaxBackoff)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                for (u32 i = 0; i < backoff; ++i)
+                    CpuRelax();
+                backoff *= 2;
+            }
+        }
+    }
+
+    bool try_lock() noexcept
+    {
+        return !_locked.load(std::memory_order_relaxed) && !_locked.exchange(true, std::memory_order_acquire);
+    }
+
+    void unlock() noexcept { _locked.store(false, std::memory_order_release); }
+
+private:
+    static constexpr u32 kMaxBackoff = 64;
+
+    std::atomic<bool> _locked{false};
+};
+
+// ======================================
+// TicketLock
+
+class TicketLock
+{
+public:
+    void lock() noexcept
+    {
+        const u32 ticket = _next.fetch_add(1, std::memory_order_relaxed);
+        for (u32 round = 0;; ++round)
+        {
+            const u32 serving = _serving.load(std::memory_order_acquire);
+            if (serving == ticket)
+                return;
+
+            // 按前面排队的线程数成比例退避；等待过久说明排在前面的线程可能被换出，让出线程
+            if (round >= kYieldRounds)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            const u32 spins = (ticket - serving) * kBackoffPerWaiter;
+            for (u32 i = 0; i < spins; ++i)
+                CpuRelax();
+        }
+    }
+
+    bool try_lock() noexcept
+    {
+        u32 serving = _serving.load(std::memory_order_acquire);
+        return _next.compare_exchange_strong(serving, serving + 1, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    // 只有持有者修改 _serving
+    void unlock() noexcept { _serving.store(_serving.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+private:
+    static constexpr u32 kBackoffPerWaiter = 8;
+    static constexpr u32 kYieldRounds      = 16;
+
+    std::atomic<u32> _next{0};
+    std::atomic<u32> _serving{0};
+};
+
+// ======================================
+// AdaptiveMutex
+
+/**
+ * @brief 自旋后睡眠的互斥锁
+ *
+ * 状态 0 为未锁定，1 为锁定且无等待者，2 为可能有等待者。只有状态为 2 时解锁才需要唤醒，
+ * 无竞争时加锁与解锁都只有一次原子操作。参考 Drepper, "Futexes Are Tricky"。
+ */
+class AdaptiveMutex
+{
+public:
+    void lock() noexcept
+    {
+        u32 expected = kUnlocked;
+        if (!_state.compare_exchange_strong(expected, kLocked, std::memory_order_acquire, std::memory_order_relaxed))
+            lockSlow();
+    }
+
+    bool try_lock() noexcept
+    {
+        u32 expected = kUnlocked;
+        return _state.compare_exchange_strong(expected, kLocked, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock() noexcept
+    {
+        if (_state.exchange(kUnlocked, std::memory_order_release) == kContended)
+            _state.notify_one();
+    }
+
+private:
+    static constexpr u32 kUnlocked  = 0;
+    static constexpr u32 kLocked    = 1;
+    static constexpr u32 kContended = 2;
+    static constexpr u32 kSpinCount = 100;
+
+    void lockSlow() noexcept
+    {
+        // 短临界区通常在自旋期间就会释放
+        for (u32 i = 0; i < kSpinCount; ++i)
+        {
+            u32 expected = kUnlocked;
+            if (_state.load(std::memory_order_relaxed) == kUnlocked &&
+                _state.compare_exchange_weak(expected, kLocked, std::memory_order_acquire, std::memory_order_relaxed))
+                return;
+            CpuRelax();
+        }
+
+        // 以 kContended 获取，保证解锁时唤醒其他可能的等待者
+        while (_state.exchange(kContended, std::memory_order_acquire) != kUnlocked)
+            _state.wait(kContended, std::memory_order_relaxed);
+    }
+
+    std::atomic<u32> _state{kUnlocked};
+};
+
+// ======================================
+// SeqLock
+
+/**
+ * @brief 顺序锁
+ *
+ * 写者将序号改为奇数后写入，完成后改回偶数；读者在前后两次读到相同的偶数序号时数据一致，否则重试。
+ * 读者不修改共享状态，多个读者之间没有缓存行竞争，适合频繁读取、偶尔更新的小对象（配置、相机参数等）。
+ * 数据按字保存为原子变量，读取与写入并发时没有数据竞争。多个写者之间互斥。
+ */
+template <typename T>
+    requires std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>
+class SeqLock
+{
+public:
+    SeqLock() { store(T{}); }
+
+    explicit SeqLock(const T& value) { store(value); }
+
+    SeqLock(const SeqLock&)            = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    T load() const noexcept
+    {
+        Words words;
+        for (;;)
+        {
+            const u32 begin = _sequence.load(std::memory_order_acquire);
+            if (begin & 1)
+            {
+                CpuRelax();
+                continue;
+            }
+
+            for (Size i = 0; i < kWordCount; ++i)
+                words[i] = _words[i].load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (_sequence.load(std::memory_order_relaxed) == begin)
+                break;
+        }
+
+        T value;
+        std::memcpy(&value, words.data(), sizeof(T));
+        return value;
+    }
+
+    void store(const T& value) noexcept
+    {
+        Words words{};
+        std::memcpy(words.data(), &value, sizeof(T));
+
+        // 序号从偶数改为奇数的写者获得写权限
+        u32 sequence = _sequence.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            if ((sequence & 1) == 0 &&
+                _sequence.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acquire, std::memory_order_relaxed))
+                break;
+            CpuRelax();
+            sequence = _sequence.load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (Size i = 0; i < kWordCount; ++i)
+            _words[i].store(words[i], std::memory_order_relaxed);
+
+        _sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    // 写入次数
+    u32 getVersion() const noexcept { return _sequence.load(std::memory_order_acquire) / 2; }
+
+private:
+    static constexpr Size kWordCount = (sizeof(T) + sizeof(u64) - 1) / sizeof(u64);
+    using Words                      = std::array<u64, kWordCount>;
+
+    std::atomic<u32> _sequence{0};
+    std::array<std::atomic<u64>, kWordCount> _words{};
+};
+
+// ======================================
+// Latch
+
+// 一次性倒计数，计数归零后所有等待者返回
+class Latch
+{
+public:
+    explicit Latch(u32 count) :
+        _count(count)
+    {
+    }
+
+    Latch(const Latch&)            = delete;
+    Latch& operator=(const Latch&) = delete;
+
+    void countDown(u32 n = 1) noexcept
+    {
+        if (_count.fetch_sub(n, std::memory_order_acq_rel) == n)
+            _count.notify_all();
+    }
+
+    bool tryWait() const noexcept { return _count.load(std::memory_order_acquire) == 0; }
+
+    void wait() const noexcept
+    {
+        for (u32 count = _count.load(std::memory_order_acquire); count != 0; count = _count.load(std::memory_order_acquire))
+            details::SpinThenWait(_count, count, std::memory_order_acquire);
+    }
+
+    void arriveAndWait(u32 n = 1) noexcept
+    {
+        countDown(n);
+        wait();
+    }
+
+private:
+    std::atomic<u32> _count;
+};
+
+// ======================================
+// Barrier
+
+// 可重复使用的屏障，每轮所有参与者到达后进入下一代
+class Barrier
+{
+public:
+    explicit Barrier(u32 count) :
+        _expected(count), _remaining(count)
+    {
+    }
+
+    Barrier(const Barrier&)            = delete;
+    Barrier& operator=(const Barrier&) = delete;
+
+    // 返回本轮的代数
+    u32 arriveAndWait() noexcept
+    {
+        const u32 generation = _generation.load(std::memory_order_acquire);
+        if (_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            // 最后到达者先重置计数再推进代数，被唤醒的线程进入下一轮时看到的是新计数
+            _remaining.store(_expected, std::memory_order_relaxed);
+            _generation.fetch_add(1, std::memory_order_release);
+            _generation.notify_all();
+            return generation;
+        }
+
+        while (_generation.load(std::memory_order_acquire) == generation)
+            details::SpinThenWait(_generation, generation, std::memory_order_acquire);
+        return generation;
+    }
+
+    u32 getGeneration() const noexcept { return _generation.load(std::memory_order_acquire); }
+
+private:
+    const u32 _expected;
+    std::atomic<u32> _remaining;
+    std::atomic<u32> _generation{0};
+};
+} // namespace xihe
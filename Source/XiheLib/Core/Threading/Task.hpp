@@ -0,0 +1,573 @@
+/**
+ * @File Task.hpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/10/1
+ * @Brief This file is part of Xihe.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "Core/Events/EventCoroutine.hpp"
+#include "Core/Threading/JobSystem.hpp"
+#include "Core/Utils/Logger.hpp"
+
+/**
+ * 惰性协程任务，在 JobSystem 上异步执行顺序书写的流程，不需要额外的线程：
+ *
+ *   Task<Mesh> LoadMesh(JobSystem& jobs, std::string path)
+ *   {
+ *       co_await ScheduleOn(jobs);                     // 之后在工作线程上执行
+ *       auto bytes = ReadFile(path);
+ *       auto [mesh, material] = co_await WhenAll(ParseMesh(jobs, bytes), LoadMaterial(jobs, path));
+ *       co_return Bind(mesh, material);
+ *   }
+ *
+ * - Task 创建后不会立即执行，被 co_await 时才开始，结束后通过对称转移恢复等待者；
+ * - ScheduleOn 把协程的后续部分提交到 JobSystem 或 ICoroutineExecutor（例如主线程的 ManualExecutor）；
+ * - 协程帧从 AllocateCoroutineFrame 的帧内存池分配；
+ * - 协程内的异常在 co_await 处重新抛出。
+ */
+namespace xihe {
+template <typename T = void>
+class Task;
+
+namespace details {
+// void 结果在 WhenAll 中以 std::monostate 表示
+template <typename T>
+using TaskValue = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+class TaskPromiseBase
+{
+public:
+    struct FinalAwaiter
+    {
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+        {
+            auto continuation = handle.promise()._continuation;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+    };
+
+    std::suspend_always initial_suspend() const noexcept
+    {
+        return {};
+    }
+
+    FinalAwaiter final_suspend() const noexcept
+    {
+        return {};
+    }
+
+    void setContinuation(std::coroutine_handle<> continuation) noexcept
+    {
+        _continuation = continuation;
+    }
+
+    static void* operator new(Size size)
+    {
+        return AllocateCoroutineFrame(size);
+    }
+
+    static void operator delete(void* ptr, Size size) noexcept
+    {
+        FreeCoroutineFrame(ptr, size);
+    }
+
+private:
+    std::coroutine_handle<> _continuation = nullptr;
+};
+
+template <typename T>
+class TaskPromise final : public TaskPromiseBase
+{
+public:
+    Task<T> get_return_object() noexcept;
+
+    template <typename U>
+        requires std::convertible_to<U&&, T>
+    void return_value(U&& value)
+    {
+        _result.template emplace<1>(std::forward<U>(value));
+    }
+
+    void unhandled_exception() noexcept
+    {
+        _result.template emplace<2>(std::current_exception());
+    }
+
+    T& result() &
+    {
+        rethrowIfFailed();
+        return std::get<1>(_result);
+    }
+
+    T&& result() &&
+    {
+        rethrowIfFailed();
+        return std::move(std::get<1>(_result));
+    }
+
+private:
+    void rethrowIfFailed() const
+    {
+        if (_result.index() == 2)
+            std::rethrow_exception(std::get<2>(_result));
+    }
+
+    std::variant<std::monostate, T, std::exception_ptr> _result;
+};
+
+template <>
+class TaskPromise<void> final : public TaskPromiseBase
+{
+public:
+    Task<void> get_return_object() noexcept;
+
+    void return_void() noexcept
+    {
+    }
+
+    void unhandled_exception() noexcept
+    {
+        _exception = std::current_exception();
+    }
+
+    void result() const
+    {
+        if (_exception)
+            std::rethrow_exception(_exception);
+    }
+
+private:
+    std::exception_ptr _exception;
+};
+} // namespace details
+
+/**
+ * @brief 惰性执行的协程任务，只能移动，析构时销毁协程帧
+ *
+ * 被 co_await 后任务在等待者的线程上开始执行；任务完成前不能析构。
+ */
+template <typename T>
+class [[nodiscard]] Task
+{
+public:
+    using promise_type = details::TaskPromise<T>;
+    using Handle       = std::coroutine_handle<promise_type>;
+
+    Task() = default;
+
+    explicit Task(Handle handle) noexcept :
+        _handle(handle)
+    {
+    }
+
+    Task(Task&& other) noexcept :
+        _handle(std::exchange(other._handle, nullptr))
+    {
+    }
+
+    Task& operator=(Task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            destroy();
+            _handle = std::exchange(other._handle, nullptr);
+        }
+        return *this;
+    }
+
+    Task(const Task&)            = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task()
+    {
+        destroy();
+    }
+
+    XIHE_NODISCARD bool isValid() const noexcept
+    {
+        return static_cast<bool>(_handle);
+    }
+
+    XIHE_NODISCARD bool isReady() const noexcept
+    {
+        return !_handle || _handle.done();
+    }
+
+    auto operator co_await() & noexcept
+    {
+        struct Awaiter : AwaiterBase
+        {
+            decltype(auto) await_resume()
+            {
+                return this->handle.promise().result();
+            }
+        };
+        return Awaiter{{_handle}};
+    }
+
+    auto operator co_await() && noexcept
+    {
+        struct Awaiter : AwaiterBase
+        {
+            decltype(auto) await_resume()
+            {
+                return std::move(this->handle.promise()).result();
+            }
+        };
+        return Awaiter{{_handle}};
+    }
+
+    // 只等待完成而不取结果，也不抛出任务内的异常
+    auto whenReady() noexcept
+    {
+        struct Awaiter : AwaiterBase
+        {
+            void await_resume() const noexcept
+            {
+            }
+        };
+        return Awaiter{{_handle}};
+    }
+
+    // 任务完成后取结果，任务内有异常时重新抛出
+    decltype(auto) result() &
+    {
+        return _handle.promise().result();
+    }
+
+    decltype(auto) result() &&
+    {
+        return std::move(_handle.promise()).result();
+    }
+
+private:
+    struct AwaiterBase
+    {
+        Handle handle;
+
+        bool await_ready() const noexcept
+        {
+            return !handle || handle.done();
+        }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+        {
+            handle.promise().setContinuation(awaiting);
+            return handle;
+        }
+    };
+
+    void destroy() noexcept
+    {
+        if (_handle)
+            std::exchange(_handle, nullptr).destroy();
+    }
+
+    Handle _handle = nullptr;
+};
+
+namespace details {
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept
+{
+    return Task<T>{std::coroutine_handle<TaskPromise>::from_promise(*this)};
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept
+{
+    return Task<void>{std::coroutine_handle<TaskPromise>::from_promise(*this)};
+}
+
+// 立即开始、结束后自动销毁的协程，用于 WhenAll/SyncWait/StartDetached 的内部包装
+struct EagerTask
+{
+    struct promise_type
+    {
+        EagerTask get_return_object() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never initial_suspend() const noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never final_suspend() const noexcept
+        {
+            return {};
+        }
+
+        void return_void() noexcept
+        {
+        }
+
+        // 包装协程内部已捕获所有异常
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+
+        static void* operator new(Size size)
+        {
+            return AllocateCoroutineFrame(size);
+        }
+
+        static void operator delete(void* ptr, Size size) noexcept
+        {
+            FreeCoroutineFrame(ptr, size);
+        }
+    };
+};
+
+// WhenAll 的汇合点：count 初始为子任务数 + 1，最后到达的一方恢复等待者
+class WhenAllLatch
+{
+public:
+    explicit WhenAllLatch(Size count) noexcept :
+        _count(count + 1)
+    {
+    }
+
+    void arrive(std::exception_ptr error = nullptr) noexcept
+    {
+        if (error)
+        {
+            bool expected = false;
+            if (_hasError.compare_exchange_strong(expected, true, std::memory_order_relaxed))
+                _error = std::move(error);
+        }
+        if (_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            _awaiting.resume();
+    }
+
+    void rethrowIfFailed() const
+    {
+        if (_error)
+            std::rethrow_exception(_error);
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    bool await_suspend(std::coroutine_handle<> awaiting) noexcept
+    {
+        _awaiting = awaiting;
+        return _count.fetch_sub(1, std::memory_order_acq_rel) > 1;
+    }
+
+    void await_resume() const noexcept
+    {
+    }
+
+private:
+    std::atomic<Size> _count;
+    std::atomic<bool> _hasError{false};
+    std::exception_ptr _error;
+    std::coroutine_handle<> _awaiting = nullptr;
+};
+
+template <typename T>
+EagerTask RunWhenAllItem(Task<T>& task, WhenAllLatch& latch, std::optional<TaskValue<T>>& slot)
+{
+    std::exception_ptr error;
+    try
+    {
+        if constexpr (std::is_void_v<T>)
+        {
+            co_await task;
+            slot.emplace();
+        }
+        else
+        {
+            slot.emplace(co_await std::move(task));
+        }
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+    latch.arrive(std::move(error));
+}
+
+template <typename T>
+EagerTask RunSyncWait(Task<T>& task, std::atomic<bool>& done)
+{
+    co_await task.whenReady();
+    done.store(true, std::memory_order_release);
+}
+
+inline EagerTask RunDetached(Task<void> task)
+{
+    try
+    {
+        co_await std::move(task);
+    }
+    catch (const std::exception& e)
+    {
+        XIHE_CORE_ERROR("分离的协程任务抛出异常：{}", e.what());
+    }
+    catch (...)
+    {
+        XIHE_CORE_ERROR("分离的协程任务抛出未知异常");
+    }
+}
+} // namespace details
+
+/**
+ * @brief 把协程的后续部分提交到 JobSystem 执行
+ */
+inline auto ScheduleOn(JobSystem& jobs) noexcept
+{
+    struct Awaiter
+    {
+        JobSystem& jobs;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            jobs.run([handle] { handle.resume(); });
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+    };
+    return Awaiter{jobs};
+}
+
+/**
+ * @brief 把协程的后续部分提交到执行器，例如在主线程每帧调用 runPending() 的 ManualExecutor
+ */
+inline auto ScheduleOn(ICoroutineExecutor& executor) noexcept
+{
+    struct Awaiter
+    {
+        ICoroutineExecutor& executor;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            executor.post(handle);
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+    };
+    return Awaiter{executor};
+}
+
+/**
+ * @brief 并发等待多个任务，结果按参数顺序组成 tuple，void 任务对应 std::monostate
+ *
+ * 子任务依次在当前线程上开始，各自在第一次挂起（如 co_await ScheduleOn）后并发执行。
+ * 所有子任务结束后才返回；有子任务抛出异常时重新抛出其中一个。
+ */
+template <typename... Ts>
+Task<std::tuple<details::TaskValue<Ts>...>> WhenAll(Task<Ts>... tasks)
+{
+    details::WhenAllLatch latch(sizeof...(Ts));
+    std::tuple<std::optional<details::TaskValue<Ts>>...> slots;
+
+    auto taskRefs = std::forward_as_tuple(tasks...);
+    [&]<Size... I>(std::index_sequence<I...>)
+    {
+        (details::RunWhenAllItem(std::get<I>(taskRefs), latch, std::get<I>(slots)), ...);
+    }(std::index_sequence_for<Ts...>{});
+
+    co_await latch;
+    latch.rethrowIfFailed();
+
+    co_return std::apply([](auto&... slot) { return std::tuple{std::move(*slot)...}; }, slots);
+}
+
+template <typename T>
+Task<std::vector<details::TaskValue<T>>> WhenAll(std::vector<Task<T>> tasks)
+{
+    details::WhenAllLatch latch(tasks.size());
+    std::vector<std::optional<details::TaskValue<T>>> slots(tasks.size());
+
+    for (Size i = 0; i < tasks.size(); ++i)
+        details::RunWhenAllItem(tasks[i], latch, slots[i]);
+
+    co_await latch;
+    latch.rethrowIfFailed();
+
+    std::vector<details::TaskValue<T>> results;
+    results.reserve(slots.size());
+    for (auto& slot : slots)
+        results.push_back(std::move(*slot));
+    co_return results;
+}
+
+/**
+ * @brief 在当前线程上执行任务直到完成，等待期间执行 JobSystem 中的其他任务
+ *
+ * 用于主线程或工具入口等同步代码与协程的边界，不要在协程内调用。
+ */
+template <typename T>
+decltype(auto) SyncWait(JobSystem& jobs, Task<T>& task)
+{
+    std::atomic<bool> done{false};
+    details::RunSyncWait(task, done);
+
+    while (!done.load(std::memory_order_acquire))
+    {
+        if (!jobs.runOne())
+            std::this_thread::yield();
+    }
+    return task.result();
+}
+
+template <typename T>
+std::conditional_t<std::is_void_v<T>, void, T> SyncWait(JobSystem& jobs, Task<T>&& task)
+{
+    auto owned = std::move(task);
+    if constexpr (std::is_void_v<T>)
+        SyncWait(jobs, owned);
+    else
+        return std::move(SyncWait(jobs, owned));
+}
+
+/**
+ * @brief 立即开始执行任务且不等待结果，任务结束后自动释放，异常记录到日志
+ */
+inline void StartDetached(Task<void> task)
+{
+    details::RunDetached(std::move(task));
+}
+} // namespace xihe
@@ -0,0 +1,326 @@
+/**
+ * @File TaskGraph.cpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/9/28
+ * @Brief This file is part of Xihe.
+ */
+
+#include "TaskGraph.hpp"
+#include "JobSystem.hpp"
+#include "Core/Base/Concepts.hpp"
+#include "Core/Base/Error.hpp"
+#include "Core/Utils/Logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <unordered_map>
+
+using namespace xihe;
+
+class TaskGraph::Impl
+{
+public:
+    struct Node
+    {
+        NodeDesc desc;
+        std::vector<NodeId> edges; // 显式后继
+    };
+
+    std::vector<Node> nodes;
+    bool compiled = false;
+
+    // 编译结果：后继以 CSR 存储，并按优先级从高到低排列
+    std::vector<u32> successorOffsets;
+    std::vector<NodeId> successors;
+    std::vector<u32> predecessorCounts;
+    std::vector<u64> priorities;
+    std::vector<NodeId> roots;
+    std::vector<NodeId> order;
+
+    // 执行状态
+    std::unique_ptr<std::atomic<u32>[]> remaining;
+    JobSystem* jobs = nullptr;
+    JobCounter counter;
+
+    void checkNode(NodeId node) const
+    {
+        if (node >= nodes.size())
+            XIHE_THROW("TaskGraph 节点 {} 不存在", node);
+    }
+
+    void checkCompiled() const
+    {
+        if (!compiled)
+            XIHE_THROW("TaskGraph 尚未编译");
+    }
+
+    std::vector<std::vector<NodeId>> collectEdges() const
+    {
+        const Size count = nodes.size();
+        std::vector<std::vector<NodeId>> edges(count);
+        for (Size i = 0; i < count; ++i)
+            edges[i] = nodes[i].edges;
+
+        struct ResourceState
+        {
+            NodeId writer = kInvalidNode;
+            std::vector<NodeId> readers;
+        };
+
+        std::unordered_map<ResourceId, ResourceState> resources;
+        for (NodeId i = 0; i < count; ++i)
+        {
+            const auto& desc = nodes[i].desc;
+            for (const auto resource : desc.reads)
+            {
+                auto& state = resources[resource];
+                if (state.writer != kInvalidNode)
+                    edges[state.writer].push_back(i);
+                state.readers.push_back(i);
+            }
+            for (const auto resource : desc.writes)
+            {
+                auto& state = resources[resource];
+                if (state.writer != kInvalidNode)
+                    edges[state.writer].push_back(i);
+                for (const auto reader : state.readers)
+                    edges[reader].push_back(i);
+                state.writer = i;
+                state.readers.clear();
+            }
+        }
+
+        for (NodeId i = 0; i < count; ++i)
+        {
+            auto& list = edges[i];
+            std::erase(list, i);
+            std::ranges::sort(list);
+            list.erase(std::ranges::unique(list).begin(), list.end());
+        }
+        return edges;
+    }
+
+    void compile()
+    {
+        const Size count = nodes.size();
+        auto edges       = collectEdges();
+
+        predecessorCounts.assign(count, 0);
+        for (const auto& list : edges)
+        {
+            for (const auto next : list)
+                ++predecessorCounts[next];
+        }
+
+        // Kahn 拓扑排序
+        order.clear();
+        order.reserve(count);
+        std::vector<u32> indegree = predecessorCounts;
+        for (NodeId i = 0; i < count; ++i)
+        {
+            if (indegree[i] == 0)
+                order.push_back(i);
+        }
+        for (Size head = 0; head < order.size(); ++head)
+        {
+            for (const auto next : edges[order[head]])
+            {
+                if (--indegree[next] == 0)
+                    order.push_back(next);
+            }
+        }
+        if (order.size() != count)
+            XIHE_THROW("TaskGraph 存在环，{} 个节点无法调度", count - order.size());
+
+        // 优先级为节点到终点的最长路径耗时
+        priorities.assign(count, 0);
+        for (auto it = order.rbegin(); it != order.rend(); ++it)
+        {
+            u64 longest = 0;
+            for (const auto next : edges[*it])
+                longest = std::max(longest, priorities[next]);
+            priorities[*it] = longest + nodes[*it].desc.cost;
+        }
+
+        auto byPriority = [this](NodeId a, NodeId b)
+        {
+            return priorities[a] != priorities[b] ? priorities[a] > priorities[b] : a < b;
+        };
+
+        successorOffsets.assign(count + 1, 0);
+        successors.clear();
+        successors.reserve(count);
+        for (NodeId i = 0; i < count; ++i)
+        {
+            std::ranges::sort(edges[i], byPriority);
+            successors.insert(successors.end(), edges[i].begin(), edges[i].end());
+            successorOffsets[i + 1] = As<u32>(successors.size());
+        }
+
+        roots.clear();
+        for (NodeId i = 0; i < count; ++i)
+        {
+            if (predecessorCounts[i] == 0)
+                roots.push_back(i);
+        }
+        std::ranges::sort(roots, byPriority);
+
+        remaining = std::make_unique<std::atomic<u32>[]>(count);
+        compiled  = true;
+    }
+
+    void execute(NodeId node) const
+    {
+        const auto& desc = nodes[node].desc;
+        if (!desc.func)
+            return;
+
+        try
+        {
+            desc.func();
+        }
+        catch (const std::exception& e)
+        {
+            XIHE_CORE_ERROR("任务图节点 '{}' 抛出异常：{}", desc.name, e.what());
+        }
+        catch (...)
+        {
+            XIHE_CORE_ERROR("任务图节点 '{}' 抛出未知异常", desc.name);
+        }
+    }
+
+    // 执行节点后释放后继：优先级最高的就绪后继在当前线程继续执行，其余提交
+    void runChain(NodeId node)
+    {
+        while (node != kInvalidNode)
+        {
+            execute(node);
+
+            NodeId next = kInvalidNode;
+            for (u32 i = successorOffsets[node]; i < successorOffsets[node + 1]; ++i)
+            {
+                const NodeId successor = successors[i];
+                if (remaining[successor].fetch_sub(1, std::memory_order_acq_rel) != 1)
+                    continue;
+
+                if (next == kInvalidNode)
+                    next = successor;
+                else
+                    submit(successor);
+            }
+            node = next;
+        }
+    }
+
+    void submit(NodeId node)
+    {
+        jobs->run([this, node] { runChain(node); }, &counter);
+    }
+
+    void run(JobSystem& inJobs)
+    {
+        if (!compiled)
+            compile();
+        if (nodes.empty())
+            return;
+
+        for (Size i = 0; i < nodes.size(); ++i)
+            remaining[i].store(predecessorCounts[i], std::memory_order_relaxed);
+        jobs = &inJobs;
+
+        // 先提交的根节点先被窃取，优先级最高的根节点由当前线程执行
+        for (Size i = 1; i < roots.size(); ++i)
+            submit(roots[i]);
+        runChain(roots.front());
+
+        jobs->wait(counter);
+        jobs = nullptr;
+    }
+};
+
+// ======================================
+
+TaskGraph::TaskGraph() :
+    _pImpl(std::make_unique<Impl>())
+{
+}
+
+TaskGraph::~TaskGraph() = default;
+
+TaskGraph::TaskGraph(TaskGraph&&) noexcept = default;
+
+TaskGraph& TaskGraph::operator=(TaskGraph&&) noexcept = default;
+
+TaskGraph::NodeId TaskGraph::addNode(NodeDesc desc)
+{
+    const auto id = As<NodeId>(_pImpl->nodes.size());
+    _pImpl->nodes.push_back({std::move(desc), {}});
+    _pImpl->compiled = false;
+    return id;
+}
+
+TaskGraph::NodeId TaskGraph::addNode(std::string name, std::function<void()> func)
+{
+    return addNode(NodeDesc{.name = std::move(name), .func = std::move(func)});
+}
+
+void TaskGraph::addEdge(NodeId before, NodeId after)
+{
+    _pImpl->checkNode(before);
+    _pImpl->checkNode(after);
+    if (before == after)
+        XIHE_THROW("TaskGraph 节点 {} 不能依赖自身", before);
+
+    _pImpl->nodes[before].edges.push_back(after);
+    _pImpl->compiled = false;
+}
+
+void TaskGraph::clear()
+{
+    _pImpl = std::make_unique<Impl>();
+}
+
+void TaskGraph::compile()
+{
+    _pImpl->compile();
+}
+
+void TaskGraph::run(JobSystem& jobs)
+{
+    _pImpl->run(jobs);
+}
+
+bool TaskGraph::isCompiled() const
+{
+    return _pImpl->compiled;
+}
+
+bool TaskGraph::empty() const
+{
+    return _pImpl->nodes.empty();
+}
+
+Size TaskGraph::getNodeCount() const
+{
+    return _pImpl->nodes.size();
+}
+
+const std::vector<TaskGraph::NodeId>& TaskGraph::getTopologicalOrder() const
+{
+    _pImpl->checkCompiled();
+    return _pImpl->order;
+}
+
+std::vector<TaskGraph::NodeId> TaskGraph::getSuccessors(NodeId node) const
+{
+    _pImpl->checkCompiled();
+    _pImpl->checkNode(node);
+    return {_pImpl->successors.begin() + _pImpl->successorOffsets[node],
+            _pImpl->successors.begin() + _pImpl->successorOffsets[node + 1]};
+}
+
+u64 TaskGraph::getCriticalPathCost() const
+{
+    _pImpl->checkCompiled();
+    return _pImpl->roots.empty() ? 0 : _pImpl->priorities[_pImpl->roots.front()];
+}
@@ -0,0 +1,102 @@
+/**
+ * @File TaskGraph.hpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/9/28
+ * @Brief This file is part of Xihe.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Core/Base/Defines.hpp"
+
+namespace xihe {
+class JobSystem;
+
+/**
+ * @brief 有依赖关系的任务图
+ *
+ * 节点通过读写资源集合或显式边声明依赖，资源依赖按节点的添加顺序推导：
+ * - 读节点依赖该资源上一个写节点；
+ * - 写节点依赖上一个写节点以及其后的所有读节点。
+ *
+ * 图编译一次得到拓扑调度，之后可以反复执行，每次执行只需重置各节点的剩余依赖数。
+ * 编译时按节点估计耗时计算到终点的最长路径，执行时关键路径上的节点优先：
+ * 就绪节点中优先级最高的在当前线程直接执行，其余提交到 JobSystem。
+ *
+ * 节点抛出的异常会被记录到日志，后续节点照常执行。同一个图不能同时执行多次。
+ */
+class XIHE_API TaskGraph
+{
+public:
+    using NodeId     = u32;
+    using ResourceId = u64;
+
+    static constexpr NodeId kInvalidNode = numeric_limits<NodeId>::max();
+
+    struct NodeDesc
+    {
+        std::string name;
+        std::function<void()> func;
+        std::vector<ResourceId> reads;
+        std::vector<ResourceId> writes;
+
+        // 估计耗时，只用于比较关键路径，单位自定
+        u32 cost = 1;
+    };
+
+    // 由名称得到资源标识（FNV-1a）
+    static constexpr ResourceId MakeResource(std::string_view name)
+    {
+        u64 hash = 0xCBF29CE484222325ull;
+        for (const char c : name)
+        {
+            hash ^= static_cast<u8>(c);
+            hash *= 0x100000001B3ull;
+        }
+        return hash;
+    }
+
+    TaskGraph();
+    ~TaskGraph();
+
+    TaskGraph(TaskGraph&&) noexcept;
+    TaskGraph& operator=(TaskGraph&&) noexcept;
+
+    TaskGraph(const TaskGraph&)            = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+
+    // 添加或修改节点后需要重新编译，run() 会自动完成
+    NodeId addNode(NodeDesc desc);
+    NodeId addNode(std::string name, std::function<void()> func);
+
+    // before 完成后才执行 after
+    void addEdge(NodeId before, NodeId after);
+
+    void clear();
+
+    // 推导依赖并生成调度，存在环时抛出异常
+    void compile();
+
+    // 执行所有节点并等待完成，当前线程参与执行
+    void run(JobSystem& jobs);
+
+    XIHE_NODISCARD bool isCompiled() const;
+    XIHE_NODISCARD bool empty() const;
+    XIHE_NODISCARD Size getNodeCount() const;
+
+    // 以下需要先编译
+    XIHE_NODISCARD const std::vector<NodeId>& getTopologicalOrder() const;
+    XIHE_NODISCARD std::vector<NodeId> getSuccessors(NodeId node) const;
+    XIHE_NODISCARD u64 getCriticalPathCost() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> _pImpl;
+};
+} // namespace xihe
@@ -0,0 +1,167 @@
+/**
+ * @File Threads.cpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/10/2
+ * @Brief This file is part of Xihe.
+ */
+
+#include "Threads.hpp"
+#include "Core/Base/Concepts.hpp"
+
+#include <array>
+#include <mutex>
+#include <unordered_map>
+
+#ifndef XIHE_ON_WINDOWS
+#  include <pthread.h>
+#  include <unistd.h>
+#endif
+
+#ifdef XIHE_ON_LINUX
+#  include <sched.h>
+#  include <sys/resource.h>
+#  include <sys/syscall.h>
+#endif
+
+using namespace xihe;
+
+namespace {
+// 系统线程 id 到名称的映射，供异步日志在后台线程中格式化时查询
+struct ThreadNameRegistry
+{
+    std::mutex mutex;
+    std::unordered_map<u64, std::string> names;
+};
+
+ThreadNameRegistry& Registry()
+{
+    static ThreadNameRegistry registry;
+    return registry;
+}
+
+// 线程退出时移除登记，避免系统复用线程 id 后显示旧名称
+struct ThreadNameEntry
+{
+    std::string name;
+    bool registered = false;
+
+    ~ThreadNameEntry()
+    {
+        if (!registered)
+            return;
+        auto& registry = Registry();
+        std::lock_guard lock(registry.mutex);
+        registry.names.erase(GetCurrentOsThreadId());
+    }
+};
+
+thread_local ThreadNameEntry tThreadName;
+
+#ifdef XIHE_ON_LINUX
+// 与 Windows 的 THREAD_PRIORITY_* 档位对应的 nice 值
+constexpr std::array<int, 5> kNiceValues = {10, 5, 0, -5, -10};
+#endif
+} // namespace
+
+u64 xihe::GetCurrentOsThreadId()
+{
+#ifdef XIHE_ON_WINDOWS
+    return GetCurrentThreadId();
+#elif defined(XIHE_ON_LINUX)
+    thread_local const u64 id = As<u64>(syscall(SYS_gettid));
+    return id;
+#elif defined(XIHE_ON_MAC)
+    u64 id = 0;
+    pthread_threadid_np(nullptr, &id);
+    return id;
+#else
+    return 0;
+#endif
+}
+
+void xihe::SetCurrentThreadName(std::string_view name)
+{
+    tThreadName.name = name;
+
+#ifdef XIHE_ON_WINDOWS
+    const int length = MultiByteToWideChar(CP_UTF8, 0, name.data(), As<int>(name.size()), nullptr, 0);
+    std::wstring wide(As<Size>(length), L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, name.data(), As<int>(name.size()), wide.data(), length);
+    SetThreadDescription(GetCurrentThread(), wide.c_str());
+#elif defined(XIHE_ON_LINUX)
+    // 内核限制 16 字节（含结尾 0）
+    const std::string truncated(name.substr(0, 15));
+    pthread_setname_np(pthread_self(), truncated.c_str());
+#elif defined(XIHE_ON_MAC)
+    pthread_setname_np(tThreadName.name.c_str());
+#endif
+
+    auto& registry = Registry();
+    std::lock_guard lock(registry.mutex);
+    if (name.empty())
+        registry.names.erase(GetCurrentOsThreadId());
+    else
+        registry.names[GetCurrentOsThreadId()] = tThreadName.name;
+    tThreadName.registered = !name.empty();
+}
+
+std::string xihe::GetCurrentThreadName()
+{
+    return tThreadName.name;
+}
+
+std::string xihe::GetThreadName(u64 osThreadId)
+{
+    auto& registry = Registry();
+    std::lock_guard lock(registry.mutex);
+    const auto it = registry.names.find(osThreadId);
+    return it != registry.names.end() ? it->second : std::string{};
+}
+
+bool xihe::SetCurrentThreadAffinity(u64 mask)
+{
+    if (mask == 0)
+        return true;
+
+#ifdef XIHE_ON_WINDOWS
+    return SetThreadAffinityMask(GetCurrentThread(), As<DWORD_PTR>(mask)) != 0;
+#elif defined(XIHE_ON_LINUX)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu = 0; cpu < 64; ++cpu)
+    {
+        if (mask & (u64{1} << cpu))
+            CPU_SET(cpu, &set);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    // macOS 只提供亲和性提示，不支持绑定到指定核心
+    return false;
+#endif
+}
+
+bool xihe::SetCurrentThreadPriority(ThreadPriority priority)
+{
+#ifdef XIHE_ON_WINDOWS
+    constexpr std::array<int, 5> kPriorities = {THREAD_PRIORITY_LOWEST, THREAD_PRIORITY_BELOW_NORMAL,
+                                                THREAD_PRIORITY_NORMAL, THREAD_PRIORITY_ABOVE_NORMAL,
+                                                THREAD_PRIORITY_HIGHEST};
+    return SetThreadPriority(GetCurrentThread(), kPriorities[static_cast<Size>(priority)]) != 0;
+#elif defined(XIHE_ON_LINUX)
+    // Linux 下 nice 值按线程生效；SCHED_FIFO 等实时策略容易饿死其他线程，这里不使用
+    const auto tid = As<id_t>(GetCurrentOsThreadId());
+    return setpriority(PRIO_PROCESS, tid, kNiceValues[static_cast<Size>(priority)]) == 0;
+#else
+    return priority == ThreadPriority::Normal;
+#endif
+}
+
+bool xihe::ApplyThreadOptions(const ThreadOptions& options)
+{
+    if (!options.name.empty())
+        SetCurrentThreadName(options.name);
+
+    const bool affinity = SetCurrentThreadAffinity(options.affinityMask);
+    const bool priority = options.priority == ThreadPriority::Normal || SetCurrentThreadPriority(options.priority);
+    return affinity && priority;
+}
@@ -6,3 +6,60 @@
  */
 
 #pragma once
+
+#include <string>
+#include <string_view>
+#include "Core/Base/Defines.hpp"
+
+namespace xihe {
+enum class ThreadPriority : u8
+{
+    Lowest,
+    Low,
+    Normal,
+    High,
+    Highest,
+};
+
+/**
+ * @brief 线程属性，由线程在启动后对自身应用
+ *
+ * 名称用于日志与调试器/性能分析工具中的线程列表，Linux 下最多保留 15 个字符。
+ * 亲和性掩码的第 i 位对应第 i 个逻辑核心，为 0 时不修改。
+ * 提高优先级通常需要额外权限，失败时保持原优先级。
+ */
+struct ThreadOptions
+{
+    std::string name;
+    u64 affinityMask        = 0;
+    ThreadPriority priority = ThreadPriority::Normal;
+};
+
+// 设置当前线程名称，同时登记到日志使用的线程名称表
+XIHE_API void SetCurrentThreadName(std::string_view name);
+
+// 当前线程名称，未设置时为空
+XIHE_API std::string GetCurrentThreadName();
+
+// 按系统线程 id（与日志记录的线程 id 一致）查询名称，未登记时为空
+XIHE_API std::string GetThreadName(u64 osThreadId);
+
+// 当前线程的系统线程 id
+XIHE_API u64 GetCurrentOsThreadId();
+
+// 成功返回 true，平台不支持或权限不足时返回 false
+XIHE_API bool SetCurrentThreadAffinity(u64 mask);
+XIHE_API bool SetCurrentThreadPriority(ThreadPriority priority);
+
+// 依次应用名称、亲和性与优先级，返回亲和性与优先级是否都设置成功
+XIHE_API bool ApplyThreadOptions(const ThreadOptions& options);
+
+// 线程池中第 index 个线程的属性：名称追加 "-index"
+inline ThreadOptions MakeWorkerThreadOptions(const ThreadOptions& options, Size index)
+{
+    ThreadOptions worker = options;
+    if (!worker.name.empty())
+        worker.name += "-" + std::to_string(index);
+    return worker;
+}
+} // namespace xihe
@@ -0,0 +1,163 @@
+/**
+ * @File WorkStealingDeque.hpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/9/27
+ * @Brief This file is part of Xihe.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <vector>
+
+#include "Core/Base/Concepts.hpp"
+#include "Core/Base/Defines.hpp"
+
+namespace xihe {
+/**
+ * @brief Chase-Lev 工作窃取双端队列
+ *
+ * - 所有者线程在底部 push/pop（后进先出，缓存局部性好），其他线程从顶部 steal（先进先出）；
+ * - 只有所有者与窃取者争夺最后一个元素时才需要 CAS；
+ * - 容量不足时所有者将数组扩容一倍，旧数组保留到队列析构，窃取者可能仍在读取。
+ *
+ * 参考 Lê, Pop, Cohen, Zappa Nardelli, "Correct and Efficient Work-Stealing for Weak Memory Models"。
+ * 元素以 release/acquire 读写，元素指向的对象无需额外同步。
+ */
+template <typename T>
+    requires std::is_pointer_v<T>
+class WorkStealingDeque
+{
+public:
+    explicit WorkStealingDeque(Size capacity = 1024)
+    {
+        auto array = std::make_unique<Array>(std::bit_ceil(std::max<Size>(capacity, 2)));
+        _array.store(array.get(), std::memory_order_relaxed);
+        _arrays.push_back(std::move(array));
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&)            = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // 只能由所有者线程调用
+    void push(T item)
+    {
+        const i64 bottom = _bottom.load(std::memory_order_relaxed);
+        const i64 top    = _top.load(std::memory_order_acquire);
+        auto* array      = _array.load(std::memory_order_relaxed);
+
+        if (bottom - top >= As<i64>(array->capacity))
+            array = grow(array, top, bottom);
+
+        array->store(bottom, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    // 只能由所有者线程调用，队列为空时返回 nullptr
+    T pop()
+    {
+        const i64 bottom = _bottom.load(std::memory_order_relaxed) - 1;
+        auto* array      = _array.load(std::memory_order_relaxed);
+        _bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        i64 top = _top.load(std::memory_order_relaxed);
+
+        if (top > bottom)
+        {
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        T item = array->load(bottom);
+        if (top == bottom)
+        {
+            // 最后一个元素，与窃取者竞争
+            if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                item = nullptr;
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    // 任意线程调用，队列为空或与其他线程竞争失败时返回 nullptr
+    T steal()
+    {
+        i64 top = _top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const i64 bottom = _bottom.load(std::memory_order_acquire);
+
+        if (top >= bottom)
+            return nullptr;
+
+        auto* array = _array.load(std::memory_order_acquire);
+        T item      = array->load(top);
+        if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;
+        return item;
+    }
+
+    // 近似值，只用于统计与调度提示
+    XIHE_NODISCARD Size size() const
+    {
+        const i64 bottom = _bottom.load(std::memory_order_relaxed);
+        const i64 top    = _top.load(std::memory_order_relaxed);
+        return bottom > top ? As<Size>(bottom - top) : 0;
+    }
+
+    XIHE_NODISCARD bool empty() const
+    {
+        return size() == 0;
+    }
+
+    XIHE_NODISCARD Size capacity() const
+    {
+        return _array.load(std::memory_order_relaxed)->capacity;
+    }
+
+private:
+    struct Array
+    {
+        explicit Array(Size size) :
+            capacity(size)
+          , mask(size - 1)
+          , items(std::make_unique<std::atomic<T>[]>(size))
+        {
+        }
+
+        T load(i64 index) const
+        {
+            return items[As<Size>(index) & mask].load(std::memory_order_acquire);
+        }
+
+        void store(i64 index, T item)
+        {
+            items[As<Size>(index) & mask].store(item, std::memory_order_release);
+        }
+
+        Size capacity;
+        Size mask;
+        std::unique_ptr<std::atomic<T>[]> items;
+    };
+
+    Array* grow(Array* array, i64 top, i64 bottom)
+    {
+        auto bigger = std::make_unique<Array>(array->capacity * 2);
+        for (i64 i = top; i < bottom; ++i)
+            bigger->store(i, array->load(i));
+
+        auto* result = bigger.get();
+        _arrays.push_back(std::move(bigger));
+        _array.store(result, std::memory_order_release);
+        return result;
+    }
+
+    alignas(64) std::atomic<i64> _top{0};
+    alignas(64) std::atomic<i64> _bottom{0};
+    alignas(64) std::atomic<Array*> _array{nullptr};
+    std::vector<std::unique_ptr<Array>> _arrays; // 只由所有者修改
+};
+} // namespace xihe
@@ -6,6 +6,7 @@
  */
 
 #include "Logger.hpp"
+#include "Core/Threading/Threads.hpp"
 #include <vector>
 #include <array>
 #include <algorithm>
@@ -30,6 +31,7 @@ XIHE_CLANG_DISABLE_WARNING("-Wcovered-switch-default")
 XIHE_CLANG_DISABLE_WARNING("-Wundefined-func-template")
 #include <spdlog/spdlog.h>
 #include <spdlog/async.h>
+#include <spdlog/pattern_formatter.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/basic_file_sink.h>
 XIHE_POP_WARNING
@@ -39,6 +41,28 @@ using namespace xihe;
 namespace {
 std::shared_ptr<spdlog::logger> sCoreLogger   = nullptr;
 std::shared_ptr<spdlog::logger> sClientLogger = nullptr;
+
+// %N：线程名称，未命名的线程输出线程 id。异步日志在后台线程格式化，因此按记录的线程 id 查询
+class ThreadNameFlag final : public spdlog::custom_flag_formatter
+{
+public:
+    void format(const spdlog::details::log_msg& msg, const std::tm&, spdlog::memory_buf_t& dest) override
+    {
+        auto name = GetThreadName(msg.thread_id);
+        if (name.empty())
+            name = std::to_string(msg.thread_id);
+        dest.append(name.data(), name.data() + name.size());
+    }
+
+    std::unique_ptr<custom_flag_formatter> clone() const override { return std::make_unique<ThreadNameFlag>(); }
+};
+
+std::unique_ptr<spdlog::formatter> MakeFormatter(const std::string& pattern)
+{
+    auto formatter = std::make_unique<spdlog::pattern_formatter>();
+    formatter->add_flag<ThreadNameFlag>('N').set_pattern(pattern);
+    return formatter;
+}
 } // namespace
 
 void LogIndenter::Increase()
@@ -80,19 +104,18 @@ void Logger::startup()
     SetConsoleOutputCP(CP_UTF8);
 #endif
 
-    spdlog::init_thread_pool(8192, 1);
+    spdlog::init_thread_pool(8192, 1, [] { SetCurrentThreadName("XiheLog"); });
 
     auto console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
     auto file_sink    = std::make_shared<spdlog::sinks::basic_file_sink_mt>("Xihe.log", true);
 
     XIHE_PUSH_WARNING
     XIHE_CLANG_DISABLE_WARNING("-Wundefined-func-template")
-    // TODO: 将线程 id 改为可读的线程名称
-    // 控制台格式: [时间] [线程ID] [Logger名]: 消息
-    console_sink->set_pattern("%^[%T] [%t] %4n: %v%$");
+    // 控制台格式: [时间] [线程名] [Logger名]: 消息
+    console_sink->set_formatter(MakeFormatter("%^[%T] [%N] %4n: %v%$"));
 
-    // 文件格式: [日期 时间.毫秒] [级别] [Logger名] [线程ID] 消息
-    file_sink->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%8l] [%4n] [thread %t] %v");
+    // 文件格式: [日期 时间.毫秒] [级别] [Logger名] [线程名] 消息
+    file_sink->set_formatter(MakeFormatter("[%Y-%m-%d %H:%M:%S.%e] [%8l] [%4n] [thread %N] %v"));
     XIHE_POP_WARNING
 
 #ifdef XIHE_DEBUG
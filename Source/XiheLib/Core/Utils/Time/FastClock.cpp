@@ -0,0 +1,235 @@
+/**
+ * @File FastClock.cpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/9/26
+ * @Brief This file is part of Xihe.
+ */
+
+#include "FastClock.hpp"
+#include "Core/Base/Concepts.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#  define XIHE_FAST_CLOCK_TSC 1
+#  if XIHE_COMPILER_MSVC
+#    include <intrin.h>
+#  else
+#    include <cpuid.h>
+#    include <x86intrin.h>
+#  endif
+#else
+#  define XIHE_FAST_CLOCK_TSC 0
+#endif
+
+using namespace xihe;
+
+#if XIHE_FAST_CLOCK_TSC
+namespace {
+// 初次校准的采样时长与最长校准间隔
+constexpr i64 kInitialCalibrationNs = 50'000;
+constexpr i64 kMaxCalibrationNs     = 1'000'000'000;
+
+u64 ReadTsc() noexcept
+{
+    return __rdtsc();
+}
+
+// CPUID 0x80000007 EDX 第 8 位：TSC 频率恒定，不随变频与休眠状态变化
+bool HasInvariantTsc()
+{
+#  if XIHE_COMPILER_MSVC
+    int info[4]{};
+    __cpuid(info, 0x80000000);
+    if (As<u32>(info[0]) < 0x80000007)
+        return false;
+    __cpuid(info, 0x80000007);
+    return (info[3] & (1 << 8)) != 0;
+#  else
+    unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (__get_cpuid_max(0x80000000, nullptr) < 0x80000007)
+        return false;
+    __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+    return (edx & (1u << 8)) != 0;
+#  endif
+}
+
+i64 SteadyNs() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+/**
+ * 换算参数：ns = baseNs + (tsc - baseTsc) * mult / 2^32。
+ * 参数由顺序锁保护，读者在写者更新期间重试；写者只有一个（tryLock 失败的线程沿用旧参数）。
+ * 新参数的直线从旧直线在切换点的读数出发，再在一个校准间隔内收敛到 Clock，因此读数单调不减。
+ */
+class TscCalibration
+{
+public:
+    static TscCalibration& Get()
+    {
+        static TscCalibration calibration;
+        return calibration;
+    }
+
+    bool usable() const noexcept
+    {
+        return _usable;
+    }
+
+    i64 now() noexcept
+    {
+        for (;;)
+        {
+            const u32 seq = _sequence.load(std::memory_order_acquire);
+            if (seq & 1)
+                continue;
+
+            const u64 baseTsc = _baseTsc.load(std::memory_order_relaxed);
+            const i64 baseNs  = _baseNs.load(std::memory_order_relaxed);
+            const u64 mult    = _mult.load(std::memory_order_relaxed);
+            const u64 next    = _nextTsc.load(std::memory_order_relaxed);
+            // 计数在校验序号前读取：用旧参数换算的计数都早于切换点
+            const u64 tsc = ReadTsc();
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (_sequence.load(std::memory_order_relaxed) != seq)
+                continue;
+
+            if (tsc >= next && recalibrate())
+                continue;
+
+            return Convert(tsc, baseTsc, baseNs, mult);
+        }
+    }
+
+    void forceRecalibrate() noexcept
+    {
+        std::lock_guard lock(_mutex);
+        update();
+    }
+
+private:
+    TscCalibration()
+    {
+        if (!HasInvariantTsc())
+            return;
+
+        _firstNs  = SteadyNs();
+        _firstTsc = ReadTsc();
+        while (SteadyNs() - _firstNs < kInitialCalibrationNs)
+            std::this_thread::yield();
+
+        _usable = update();
+    }
+
+    static i64 Convert(u64 tsc, u64 baseTsc, i64 baseNs, u64 mult) noexcept
+    {
+        // 其他线程刚完成校准时读到的计数可能略早于新基准
+        const u64 delta = tsc > baseTsc ? tsc - baseTsc : 0;
+        return baseNs + As<i64>((delta >> 32) * mult + ((delta & 0xFFFF'FFFF) * mult >> 32));
+    }
+
+    bool recalibrate() noexcept
+    {
+        std::unique_lock lock(_mutex, std::try_to_lock);
+        if (!lock.owns_lock())
+            return false;
+
+        // 其他线程已经完成了本轮校准
+        if (ReadTsc() < _nextTsc.load(std::memory_order_relaxed))
+            return true;
+
+        // 校准失败时沿用旧参数
+        return update();
+    }
+
+    // 以首次采样到当前的整段区间计算频率，区间越长误差越小。
+    // 先让读者进入重试再采样切换点，切换点之后的计数只会用新参数换算
+    bool update() noexcept
+    {
+        _sequence.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const i64 nowNs  = SteadyNs();
+        const u64 nowTsc = ReadTsc();
+
+        const bool updated = store(nowNs, nowTsc);
+        _sequence.fetch_add(1, std::memory_order_release);
+        return updated;
+    }
+
+    bool store(i64 nowNs, u64 nowTsc) noexcept
+    {
+        const auto elapsedNs    = nowNs - _firstNs;
+        const auto elapsedTicks = nowTsc - _firstTsc;
+        if (elapsedNs <= 0 || elapsedTicks == 0)
+            return false;
+
+        // 频率低于 1 GHz 时 32.32 定点乘法会溢出，退回 Clock
+        const f64 nsPerTick = As<f64>(elapsedNs) / As<f64>(elapsedTicks);
+        if (nsPerTick >= 1.0)
+            return false;
+
+        const auto interval = std::min(elapsedNs, kMaxCalibrationNs);
+        const f64 ticks     = As<f64>(interval) / nsPerTick;
+
+        // 旧直线落后于 Clock 时直接追上；领先时从旧读数出发放慢斜率，一个间隔后与 Clock 重合。
+        // 斜率不超过 nsPerTick，最多放慢一半
+        i64 startNs = nowNs;
+        f64 slope   = nsPerTick;
+        if (const u64 mult = _mult.load(std::memory_order_relaxed); mult != 0)
+        {
+            startNs = std::max(nowNs, Convert(nowTsc, _baseTsc.load(std::memory_order_relaxed),
+                                              _baseNs.load(std::memory_order_relaxed), mult));
+            slope   = std::max(As<f64>(nowNs + interval - startNs) / ticks, nsPerTick * 0.5);
+        }
+
+        _baseTsc.store(nowTsc, std::memory_order_relaxed);
+        _baseNs.store(startNs, std::memory_order_relaxed);
+        _mult.store(As<u64>(slope * 4294967296.0), std::memory_order_relaxed);
+        _nextTsc.store(nowTsc + As<u64>(ticks), std::memory_order_relaxed);
+        return true;
+    }
+
+    bool _usable  = false;
+    i64 _firstNs  = 0;
+    u64 _firstTsc = 0;
+    std::mutex _mutex;
+
+    std::atomic<u32> _sequence{0};
+    std::atomic<u64> _baseTsc{0};
+    std::atomic<i64> _baseNs{0};
+    std::atomic<u64> _mult{0};
+    std::atomic<u64> _nextTsc{0};
+};
+} // namespace
+#endif
+
+TimePoint FastClock::now() noexcept
+{
+#if XIHE_FAST_CLOCK_TSC
+    if (auto& calibration = TscCalibration::Get(); calibration.usable())
+        return TimePoint(std::chrono::duration_cast<Duration>(std::chrono::nanoseconds(calibration.now())));
+#endif
+    return Clock::now();
+}
+
+void FastClock::Recalibrate() noexcept
+{
+#if XIHE_FAST_CLOCK_TSC
+    if (auto& calibration = TscCalibration::Get(); calibration.usable())
+        calibration.forceRecalibrate();
+#endif
+}
+
+bool FastClock::IsTscBased() noexcept
+{
+#if XIHE_FAST_CLOCK_TSC
+    return TscCalibration::Get().usable();
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,41 @@
+/**
+ * @File FastClock.hpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/9/26
+ * @Brief This file is part of Xihe.
+ */
+
+#pragma once
+
+#include "Core/Base/Defines.hpp"
+#include "Core/Utils/Time/Clock.hpp"
+
+namespace xihe {
+/**
+ * @brief 读取开销更低的时钟，用于事件时间戳等高频路径
+ *
+ * x86-64 上支持恒定频率 TSC 时直接读取时间戳计数器，按与 Clock 对比校准出的频率换算；
+ * 校准间隔从首次使用起逐步加倍（上限 1 秒），每次校准后与 Clock 的偏差回到亚微秒级。
+ * 不支持 TSC 的平台直接使用 Clock::now()。
+ *
+ * 与 Clock 使用同一时间点类型，两者的结果可以直接比较与相减。
+ * 校准时新的换算从旧换算在切换点的读数出发、逐步收敛到 Clock，读数单调不减。
+ */
+struct XIHE_API FastClock
+{
+    using rep        = Clock::rep;
+    using period     = Clock::period;
+    using duration   = Clock::duration;
+    using time_point = TimePoint;
+
+    static constexpr bool is_steady = true;
+
+    static TimePoint now() noexcept;
+
+    // 立即重新校准，正常使用时由 now() 按间隔自动进行
+    static void Recalibrate() noexcept;
+
+    // 当前是否使用时间戳计数器
+    static bool IsTscBased() noexcept;
+};
+} // namespace xihe
@@ -7,16 +7,20 @@
 
 #pragma once
 
-#include <queue>
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
 #include <functional>
-#include <unordered_set>
+#include <iostream>
+#include <optional>
+#include <thread>
+#include <vector>
 
 #include "Core/Base/Defines.hpp"
 #include "Core/Utils/Time/Clock.hpp"
+#include "Core/Utils/Time/TimingWheel.hpp"
 #include "Core/Base/Error.hpp"
+#include "Core/Threading/Threads.hpp"
 
 namespace xihe {
 struct TimerHandle
@@ -24,12 +28,34 @@ struct TimerHandle
     u64 id{0};
 };
 
+/**
+ * @brief 定时器队列
+ *
+ * 定时器存放在分层时间轮中，注册与取消都是 O(1)，取消时立即移除。
+ * 到期时间向上取整到 resolution，同一刻度内的定时器在一次唤醒中一起触发，不会提前触发。
+ */
 class TimerQueue
 {
 public:
     using Callback = std::function<void()>;
 
-    TimerQueue() : _running(true), _thread([this] { run(); }) {}
+    struct Config
+    {
+        // 时间轮刻度，也是定时器合并的粒度；越大唤醒越少，触发的延迟上限也越大
+        Duration resolution = std::chrono::milliseconds(1);
+
+        // 定时线程启动后应用，延迟敏感的场景可以提高优先级或绑定核心
+        ThreadOptions thread{.name = "XiheTimer"};
+    };
+
+    TimerQueue() : TimerQueue(Config{}) {}
+
+    explicit TimerQueue(const Config& config) :
+        _origin(Clock::now()), _resolution(config.resolution), _running(true)
+    {
+        XIHE_CHECK(_resolution.count() > 0, "TimerQueue: resolution must be positive");
+        _thread = std::thread([this, options = config.thread] { ApplyThreadOptions(options); run(); });
+    }
 
     ~TimerQueue()
     {
@@ -42,85 +68,110 @@ public:
             _thread.join();
     }
 
-    TimerHandle scheduleOnce(TimePoint when, Callback cb) { return scheduleImpl(when, Seconds{0}, std::move(cb)); }
+    TimerHandle scheduleOnce(TimePoint when, Callback cb) { return scheduleImpl(when, Duration::zero(), std::move(cb)); }
 
     TimerHandle scheduleEvery(Seconds interval, Callback cb, TimePoint startAt = Clock::now())
     {
         XIHE_CHECK(interval.count() > 0.0, "scheduleEvery: interval must be positive");
-        return scheduleImpl(startAt, interval, std::move(cb));
+        const auto period = std::max(Duration{1}, std::chrono::duration_cast<Duration>(interval));
+        return scheduleImpl(startAt, period, std::move(cb));
     }
 
+    // 定时器尚未触发（周期定时器尚未停止）时移除并返回 true；正在执行的回调不受影响
     bool cancel(const TimerHandle& h)
     {
         std::lock_guard<std::mutex> lk(_mtx);
-        return _cancelled.insert(h.id).second; // 标记取消，实际剔除在消费端惰性执行
+        return _wheel.cancel(h.id);
+    }
+
+    Size pendingCount() const
+    {
+        std::lock_guard<std::mutex> lk(_mtx);
+        return _wheel.size();
     }
 
 private:
     struct Item
     {
         TimePoint deadline{};
-        Seconds interval{0}; // 0 表示一次性
-        u64 id{0};
+        Duration interval{0}; // 0 表示一次性
         Callback cb{};
-        bool operator>(const Item& other) const { return deadline > other.deadline; }
     };
 
-    TimerHandle scheduleImpl(TimePoint when, Seconds interval, Callback cb)
+    // 向上取整，保证不早于 when 触发
+    u64 tickAt(TimePoint when) const
+    {
+        if (when <= _origin)
+            return 0;
+        return static_cast<u64>((when - _origin + _resolution - Duration{1}) / _resolution);
+    }
+
+    TimePoint timeOf(u64 tick) const { return _origin + _resolution * static_cast<Duration::rep>(tick); }
+
+    TimerHandle scheduleImpl(TimePoint when, Duration interval, Callback cb)
     {
         std::lock_guard<std::mutex> lk(_mtx);
-        const u64 id = ++_nextId;
-        _queue.push(Item{when, interval, id, std::move(cb)});
-        _cv.notify_one();
+        const u64 tick   = tickAt(when);
+        const auto first = _wheel.nextTick();
+        const u64 id     = _wheel.schedule(tick, Item{when, interval, std::move(cb)});
+
+        // 只有新定时器早于定时线程正在等待的刻度时才需要唤醒
+        if (!first || tick < *first)
+            _cv.notify_one();
         return TimerHandle{id};
     }
 
     void run()
     {
+        std::vector<Callback> ready;
         std::unique_lock<std::mutex> lk(_mtx);
         while (_running.load(std::memory_order_acquire)) {
-            if (_queue.empty()) {
-                _cv.wait(lk, [&] { return !_running.load(std::memory_order_acquire) || !_queue.empty(); });
-                if (!_running.load(std::memory_order_acquire))
-                    break;
-            }
-
-            auto item = _queue.top();
-            const auto now = Clock::now();
-            if (item.deadline > now) {
-                _cv.wait_until(lk, item.deadline);
+            const auto next = _wheel.nextTick();
+            if (!next) {
+                _cv.wait(lk, [&] { return !_running.load(std::memory_order_acquire) || !_wheel.empty(); });
                 continue;
             }
 
-            _queue.pop();
-
-            if (_cancelled.contains(item.id)) {
-                _cancelled.erase(item.id);
+            const auto wakeAt = timeOf(*next);
+            auto now          = Clock::now();
+            if (wakeAt > now) {
+                _cv.wait_until(lk, wakeAt);
                 continue;
             }
 
+            now = Clock::now();
+            _wheel.advance(static_cast<u64>((now - _origin) / _resolution), [&](u64, Item& item) -> std::optional<u64>
+            {
+                if (item.interval == Duration::zero()) {
+                    ready.push_back(std::move(item.cb));
+                    return std::nullopt;
+                }
+
+                // 周期任务：基于理论下一次时间推进，减少漂移；错过的周期合并为一次触发
+                ready.push_back(item.cb);
+                item.deadline += item.interval;
+                if (item.deadline <= now)
+                    item.deadline += item.interval * ((now - item.deadline) / item.interval + 1);
+                return tickAt(item.deadline);
+            });
+
             // 执行回调时释放锁，避免阻塞注册/取消与其他定时触发
             lk.unlock();
-
-            try { item.cb(); } catch (const std::exception& e) { std::cerr << "TimerQueue callback exception: " << e.what() << std::endl; }
-            catch (...) { std::cerr << "TimerQueue callback unknown exception" << std::endl; }
-            lk.lock();
-
-            // 周期任务：基于理论下一次时间推进，减少漂移
-            if (item.interval.count() > 0.0) {
-                item.deadline += std::chrono::duration_cast<std::chrono::steady_clock::duration>(item.interval);
-                if (!_cancelled.contains(item.id)) { _queue.push(item); }
-                else { _cancelled.erase(item.id); }
+            for (auto& cb : ready) {
+                try { cb(); } catch (const std::exception& e) { std::cerr << "TimerQueue callback exception: " << e.what() << std::endl; }
+                catch (...) { std::cerr << "TimerQueue callback unknown exception" << std::endl; }
             }
+            ready.clear();
+            lk.lock();
         }
     }
 
-    std::priority_queue<Item, std::vector<Item>, std::greater<>> _queue;
-    std::mutex _mtx;
+    const TimePoint _origin;
+    const Duration _resolution;
+    TimingWheel<Item> _wheel;
+    mutable std::mutex _mtx;
     std::condition_variable _cv;
     std::atomic<bool> _running{false};
     std::thread _thread;
-    u64 _nextId{0};
-    std::unordered_set<u64> _cancelled;
 };
-} // namespace xihe
\ No newline at end of file
+} // namespace xihe
@@ -0,0 +1,307 @@
+/**
+ * @File TimingWheel.hpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/10/6
+ * @Brief This file is part of Xihe.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "Core/Base/Defines.hpp"
+
+namespace xihe {
+/**
+ * @brief 分层时间轮
+ *
+ * 时间以整数刻度表示，每层 64 个槽，第 L 层的一个槽覆盖 64^L 个刻度。
+ * 定时器按剩余刻度放入能容纳它的最低层，低层转过一圈时把上一层的当前槽下放（cascade）。
+ *
+ * - schedule / reschedule / cancel 都是 O(1)，取消时立即从槽中摘除，不留惰性标记；
+ * - 节点放在连续数组中按下标链接，释放的节点复用；句柄带代数，过期句柄不会误取消新定时器；
+ * - 同一刻度的定时器一起到期，调用者通过刻度粒度控制合并程度；
+ * - 非线程安全，由调用者加锁。
+ */
+template <typename T>
+class TimingWheel
+{
+public:
+    using Id = u64;
+
+    static constexpr u32 kSlotBits  = 6;
+    static constexpr u32 kSlots     = 1u << kSlotBits;
+    static constexpr u32 kLevels    = 6;
+    static constexpr u64 kMaxDelta  = (1ull << (kSlotBits * kLevels)) - 1;
+    static constexpr Id kInvalidId  = 0;
+
+    explicit TimingWheel(u64 startTick = 0) :
+        _current(startTick)
+    {
+        for (auto& level : _heads)
+            level.fill(kNil);
+    }
+
+    // 在 tick 到期，早于当前刻度的定时器在下一次 advance 时到期
+    Id schedule(u64 tick, T value)
+    {
+        const u32 index = allocateNode();
+        auto& node      = _nodes[index];
+        node.tick       = tick;
+        node.value.emplace(std::move(value));
+        link(index);
+        ++_size;
+        return MakeId(index, node.generation);
+    }
+
+    // 修改到期刻度，保留句柄与数据
+    bool reschedule(Id id, u64 tick)
+    {
+        const u32 index = find(id);
+        if (index == kNil)
+            return false;
+
+        unlink(index);
+        _nodes[index].tick = tick;
+        link(index);
+        return true;
+    }
+
+    bool cancel(Id id)
+    {
+        const u32 index = find(id);
+        if (index == kNil)
+            return false;
+
+        unlink(index);
+        freeNode(index);
+        --_size;
+        return true;
+    }
+
+    T* get(Id id)
+    {
+        const u32 index = find(id);
+        return index == kNil ? nullptr : &*_nodes[index].value;
+    }
+
+    /**
+     * @brief 推进到 tick（含），依次处理到期的定时器
+     *
+     * fn(Id, T&) 返回新的到期刻度时重新挂入，句柄不变；返回 std::nullopt 时释放。
+     * 没有事件的刻度直接跳过，长时间未推进也不会逐刻度空转。fn 内不能访问本时间轮。
+     */
+    template <typename Fn>
+    Size advance(u64 tick, Fn&& fn)
+    {
+        Size expired = 0;
+        while (_current <= tick)
+        {
+            const auto next = nextTick();
+            if (!next || *next > tick)
+            {
+                _current = tick + 1;
+                break;
+            }
+
+            _current = *next;
+            cascade();
+
+            // 先摘下整个槽再推进刻度，回调中重新挂入的过期定时器落到下一个刻度
+            u32 index                = detach(0, slotOf(_current, 0));
+            const u64 processingTick = _current++;
+            while (index != kNil)
+            {
+                const u32 nextIndex = _nodes[index].next;
+                auto& node          = _nodes[index];
+                if (node.tick > processingTick)
+                {
+                    // 超出最大跨度的定时器被截断放入顶层，未到期时重新挂入
+                    link(index);
+                }
+                else if (const auto rearm = fn(MakeId(index, node.generation), *node.value))
+                {
+                    node.tick = *rearm;
+                    link(index);
+                    ++expired;
+                }
+                else
+                {
+                    freeNode(index);
+                    --_size;
+                    ++expired;
+                }
+                index = nextIndex;
+            }
+        }
+        return expired;
+    }
+
+    /**
+     * @brief 下一个需要处理的刻度
+     *
+     * 对底层是最早的到期刻度，对上层是最早的非空槽下放的刻度，因此是下一次到期的下界：
+     * 在此之前不会有定时器到期，调用者可以安全地睡眠到该刻度。
+     */
+    std::optional<u64> nextTick() const
+    {
+        if (_size == 0)
+            return std::nullopt;
+
+        u64 best = std::numeric_limits<u64>::max();
+        for (u32 level = 0; level < kLevels; ++level)
+        {
+            if (_occupied[level] == 0)
+                continue;
+
+            // 该层下一个将被处理的位置，以及从它开始第一个非空槽
+            const u32 shift = level * kSlotBits;
+            const u64 base  = (_current + ((1ull << shift) - 1)) >> shift;
+            const u32 first = std::countr_zero(std::rotr(_occupied[level], static_cast<int>(base & (kSlots - 1))));
+            best            = std::min(best, (base + first) << shift);
+        }
+        return best;
+    }
+
+    // 下一个尚未处理的刻度
+    u64 currentTick() const noexcept { return _current; }
+
+    Size size() const noexcept { return _size; }
+
+    bool empty() const noexcept { return _size == 0; }
+
+private:
+    static constexpr u32 kNil = std::numeric_limits<u32>::max();
+
+    struct Node
+    {
+        u64 tick       = 0;
+        u32 generation = 1;
+        u32 prev       = kNil;
+        u32 next       = kNil;
+        u16 level      = 0;
+        u16 slot       = 0;
+        std::optional<T> value;
+    };
+
+    static Id MakeId(u32 index, u32 generation) { return (u64(generation) << 32) | index; }
+
+    static u32 slotOf(u64 tick, u32 level) { return static_cast<u32>(tick >> (level * kSlotBits)) & (kSlots - 1); }
+
+    u32 find(Id id) const
+    {
+        const u32 index = static_cast<u32>(id);
+        if (id == kInvalidId || index >= _nodes.size())
+            return kNil;
+
+        const auto& node = _nodes[index];
+        return node.value && node.generation == static_cast<u32>(id >> 32) ? index : kNil;
+    }
+
+    u32 allocateNode()
+    {
+        if (_freeHead != kNil)
+        {
+            const u32 index = _freeHead;
+            _freeHead       = _nodes[index].next;
+            return index;
+        }
+        _nodes.emplace_back();
+        return static_cast<u32>(_nodes.size() - 1);
+    }
+
+    void freeNode(u32 index)
+    {
+        auto& node = _nodes[index];
+        node.value.reset();
+        ++node.generation;
+        if (node.generation == 0)
+            node.generation = 1;
+        node.next = _freeHead;
+        _freeHead = index;
+    }
+
+    // 按剩余刻度选择层与槽
+    void link(u32 index)
+    {
+        auto& node = _nodes[index];
+        u64 tick   = std::max(node.tick, _current);
+        u32 level  = 0;
+        if (tick - _current > kMaxDelta)
+        {
+            tick  = _current + kMaxDelta;
+            level = kLevels - 1;
+        }
+        else
+        {
+            const u64 delta = tick - _current;
+            while (level + 1 < kLevels && delta >= (1ull << ((level + 1) * kSlotBits)))
+                ++level;
+        }
+
+        const u32 slot = slotOf(tick, level);
+        node.level     = static_cast<u16>(level);
+        node.slot      = static_cast<u16>(slot);
+        node.prev      = kNil;
+        node.next      = _heads[level][slot];
+        if (node.next != kNil)
+            _nodes[node.next].prev = index;
+        _heads[level][slot] = index;
+        _occupied[level] |= 1ull << slot;
+    }
+
+    void unlink(u32 index)
+    {
+        auto& node = _nodes[index];
+        if (node.prev != kNil)
+            _nodes[node.prev].next = node.next;
+        else
+            _heads[node.level][node.slot] = node.next;
+        if (node.next != kNil)
+            _nodes[node.next].prev = node.prev;
+
+        if (_heads[node.level][node.slot] == kNil)
+            _occupied[node.level] &= ~(1ull << node.slot);
+    }
+
+    // 摘下整个槽，返回链表头
+    u32 detach(u32 level, u32 slot)
+    {
+        const u32 head      = _heads[level][slot];
+        _heads[level][slot] = kNil;
+        _occupied[level] &= ~(1ull << slot);
+        return head;
+    }
+
+    // 低层回到 0 号槽时，把上一层的当前槽重新分配到低层
+    void cascade()
+    {
+        for (u32 level = 1; level < kLevels; ++level)
+        {
+            if (slotOf(_current, level - 1) != 0)
+                break;
+
+            for (u32 index = detach(level, slotOf(_current, level)); index != kNil;)
+            {
+                const u32 next = _nodes[index].next;
+                link(index);
+                index = next;
+            }
+        }
+    }
+
+    std::vector<Node> _nodes;
+    u32 _freeHead = kNil;
+    Size _size    = 0;
+    u64 _current;
+
+    std::array<std::array<u32, kSlots>, kLevels> _heads{};
+    std::array<u64, kLevels> _occupied{};
+};
+} // namespace xihe
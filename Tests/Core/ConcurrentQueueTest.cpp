@@ -0,0 +1,256 @@
+/**
+ * @File ConcurrentQueueTest.cpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/10/4
+ * @Brief 无锁队列的单元测试
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "Core/Threading/MpmcQueue.hpp"
+#include "Core/Threading/SpscQueue.hpp"
+
+using namespace xihe;
+
+TEST(MpmcQueueTest, BoundedFifoOnSingleThread)
+{
+    MpmcQueue<int> queue(5);
+    EXPECT_EQ(queue.capacity(), 8u);
+
+    for (int i = 0; i < 8; ++i)
+        EXPECT_TRUE(queue.tryPush(i));
+    EXPECT_FALSE(queue.tryPush(8));
+    EXPECT_EQ(queue.sizeApprox(), 8u);
+
+    int value = -1;
+    for (int i = 0; i < 8; ++i)
+    {
+        ASSERT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.tryPop(value));
+}
+
+TEST(MpmcQueueTest, BatchOperationsArePartialWhenFullOrEmpty)
+{
+    MpmcQueue<int> queue(8);
+    std::array<int, 6> input{0, 1, 2, 3, 4, 5};
+    EXPECT_EQ(queue.tryPushBatch(input), 6u);
+    EXPECT_EQ(queue.tryPushBatch(input), 2u);
+
+    std::array<int, 5> output{};
+    EXPECT_EQ(queue.tryPopBatch(output), 5u);
+    EXPECT_EQ(output, (std::array<int, 5>{0, 1, 2, 3, 4}));
+    EXPECT_EQ(queue.tryPopBatch(output), 3u);
+    EXPECT_EQ(output[0], 5);
+    EXPECT_EQ(output[1], 0);
+    EXPECT_EQ(output[2], 1);
+    EXPECT_EQ(queue.tryPopBatch(output), 0u);
+}
+
+TEST(MpmcQueueTest, DestroysRemainingItems)
+{
+    auto tracker = std::make_shared<int>(0);
+    {
+        MpmcQueue<std::shared_ptr<int>> queue(4);
+        queue.tryPush(tracker);
+        queue.tryPush(tracker);
+        EXPECT_EQ(tracker.use_count(), 3);
+    }
+    EXPECT_EQ(tracker.use_count(), 1);
+}
+
+TEST(MpmcQueueTest, ThrowingConstructionLeavesQueueUsable)
+{
+    // 拷贝构造可能抛出，移动构造不抛出
+    struct Fragile
+    {
+        int value     = 0;
+        bool throwing = false;
+
+        explicit Fragile(int v, bool t = false) :
+            value(v), throwing(t)
+        {
+        }
+
+        Fragile(const Fragile& other) :
+            value(other.value), throwing(other.throwing)
+        {
+            if (throwing)
+                throw std::runtime_error("copy");
+        }
+
+        Fragile(Fragile&&) noexcept            = default;
+        Fragile& operator=(const Fragile&)     = default;
+        Fragile& operator=(Fragile&&) noexcept = default;
+    };
+
+    MpmcQueue<Fragile> queue(2);
+    const Fragile bad(1, true);
+    EXPECT_THROW(queue.tryPush(bad), std::runtime_error);
+    EXPECT_EQ(queue.sizeApprox(), 0u);
+
+    // 抛出后没有槽位被占用，后续的入队与出队正常进行
+    EXPECT_TRUE(queue.tryPush(Fragile(2)));
+    EXPECT_TRUE(queue.tryEmplace(3));
+    EXPECT_FALSE(queue.tryPush(Fragile(4)));
+
+    Fragile out(0);
+    ASSERT_TRUE(queue.tryPop(out));
+    EXPECT_EQ(out.value, 2);
+    ASSERT_TRUE(queue.tryPop(out));
+    EXPECT_EQ(out.value, 3);
+    EXPECT_FALSE(queue.tryPop(out));
+}
+
+TEST(MpmcQueueTest, StressManyProducersManyConsumers)
+{
+    constexpr int kProducers = 4;
+    constexpr int kConsumers = 4;
+    constexpr int kPerThread = 20'000;
+
+    // 容量很小，频繁触发满/空的边界
+    MpmcQueue<u64> queue(64);
+    std::atomic<u64> sum{0};
+    std::atomic<int> consumed{0};
+    std::vector<std::atomic<int>> seen(kProducers * kPerThread);
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < kProducers; ++p)
+    {
+        threads.emplace_back([&, p]
+        {
+            std::array<u64, 8> batch{};
+            for (int i = 0; i < kPerThread;)
+            {
+                // 交替使用单个与批量入队
+                int pushed = 0;
+                if (i % 3 == 0)
+                {
+                    pushed = queue.tryPush(u64(p) * kPerThread + i) ? 1 : 0;
+                }
+                else
+                {
+                    const int count = std::min<int>(batch.size(), kPerThread - i);
+                    for (int k = 0; k < count; ++k)
+                        batch[k] = u64(p) * kPerThread + i + k;
+                    pushed = static_cast<int>(queue.tryPushBatch(std::span(batch.data(), count)));
+                }
+
+                // 线程数可能多于核心数，队列满时让出，避免空转整个时间片
+                if (pushed == 0)
+                    std::this_thread::yield();
+                i += pushed;
+            }
+        });
+    }
+    for (int c = 0; c < kConsumers; ++c)
+    {
+        threads.emplace_back([&, c]
+        {
+            std::array<u64, 8> batch{};
+            while (consumed.load(std::memory_order_relaxed) < kProducers * kPerThread)
+            {
+                Size count = 0;
+                if (c % 2 == 0)
+                    count = queue.tryPop(batch[0]) ? 1 : 0;
+                else
+                    count = queue.tryPopBatch(batch);
+                if (count == 0)
+                    std::this_thread::yield();
+
+                for (Size k = 0; k < count; ++k)
+                {
+                    seen[batch[k]].fetch_add(1, std::memory_order_relaxed);
+                    sum.fetch_add(batch[k], std::memory_order_relaxed);
+                }
+                consumed.fetch_add(static_cast<int>(count), std::memory_order_relaxed);
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    constexpr u64 total = u64(kProducers) * kPerThread;
+    EXPECT_EQ(sum.load(), total * (total - 1) / 2);
+    for (Size i = 0; i < seen.size(); ++i)
+        ASSERT_EQ(seen[i].load(), 1) << i;
+}
+
+TEST(SpscQueueTest, BoundedFifoWithFront)
+{
+    SpscQueue<std::unique_ptr<int>> queue(4);
+    for (int i = 0; i < 4; ++i)
+        EXPECT_TRUE(queue.tryEmplace(std::make_unique<int>(i)));
+    EXPECT_FALSE(queue.tryPush(std::make_unique<int>(4)));
+
+    ASSERT_NE(queue.front(), nullptr);
+    EXPECT_EQ(**queue.front(), 0);
+
+    std::unique_ptr<int> value;
+    for (int i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(*value, i);
+    }
+    EXPECT_EQ(queue.front(), nullptr);
+    EXPECT_FALSE(queue.tryPop(value));
+}
+
+TEST(SpscQueueTest, StressPreservesOrder)
+{
+    constexpr u64 kCount = 200'000;
+    SpscQueue<u64> queue(128);
+
+    std::thread producer([&]
+    {
+        std::array<u64, 16> batch{};
+        for (u64 next = 0; next < kCount;)
+        {
+            Size pushed = 0;
+            if (next % 5 == 0)
+            {
+                pushed = queue.tryPush(next) ? 1 : 0;
+            }
+            else
+            {
+                const Size count = std::min<u64>(batch.size(), kCount - next);
+                for (Size k = 0; k < count; ++k)
+                    batch[k] = next + k;
+                pushed = queue.tryPushBatch(std::span(batch.data(), count));
+            }
+            if (pushed == 0)
+                std::this_thread::yield();
+            next += pushed;
+        }
+    });
+
+    u64 expected = 0;
+    bool ordered = true;
+    std::array<u64, 16> batch{};
+    while (expected < kCount)
+    {
+        Size count = 0;
+        if (expected % 7 == 0)
+            count = queue.tryPop(batch[0]) ? 1 : 0;
+        else
+            count = queue.tryPopBatch(batch);
+        if (count == 0)
+            std::this_thread::yield();
+        for (Size k = 0; k < count; ++k)
+            ordered = ordered && batch[k] == expected++;
+    }
+    producer.join();
+
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(queue.sizeApprox(), 0u);
+}
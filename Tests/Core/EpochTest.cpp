@@ -0,0 +1,349 @@
+/**
+ * @File EpochTest.cpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/10/5
+ * @Brief 纪元回收的单元测试
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "Core/Threading/Epoch.hpp"
+
+using namespace xihe;
+
+namespace {
+struct Tracked
+{
+    static inline std::atomic<int> alive{0};
+
+    explicit Tracked(int v) :
+        value(v)
+    {
+        alive.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    ~Tracked()
+    {
+        value = -1;
+        alive.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    int value;
+};
+
+class CountingAllocator final : public IAllocator
+{
+public:
+    AllocationHandle allocate(Size size, Size alignment) override
+    {
+        AllocationHandle handle;
+        handle.cpuPtr    = std::malloc(size);
+        handle.size      = size;
+        handle.alignment = alignment;
+        ++live;
+        return handle;
+    }
+
+    void deallocate(const AllocationHandle& h) override
+    {
+        std::free(h.cpuPtr);
+        --live;
+    }
+
+    const AllocationStatistics& stats() const override { return _stats; }
+
+    int live = 0;
+
+private:
+    AllocationStatistics _stats;
+};
+} // namespace
+
+TEST(EpochTest, GuardBlocksAdvanceUntilReleased)
+{
+    Epoch::Drain();
+
+    const u64 start = Epoch::Current();
+    std::atomic<bool> entered{false};
+    std::atomic<bool> leave{false};
+    std::thread reader([&]
+    {
+        EpochGuard outer;
+        {
+            EpochGuard inner; // 嵌套不会重新发布纪元
+        }
+        entered = true;
+        while (!leave.load())
+            std::this_thread::yield();
+    });
+    while (!entered.load())
+        std::this_thread::yield();
+
+    // 读者停留在 start，纪元最多再推进一次
+    for (int i = 0; i < 8; ++i)
+        Epoch::TryAdvance();
+    EXPECT_LE(Epoch::Current(), start + 1);
+
+    leave = true;
+    reader.join();
+    Epoch::Synchronize();
+    EXPECT_GE(Epoch::Current(), start + 2);
+}
+
+TEST(EpochTest, RetiredObjectOutlivesGuard)
+{
+    Epoch::Drain();
+    const int base = Tracked::alive.load();
+
+    std::atomic<Tracked*> shared{new Tracked(1)};
+    std::atomic<bool> pinned{false};
+    std::atomic<bool> leave{false};
+    std::atomic<int> observed{0};
+    std::thread reader([&]
+    {
+        EpochGuard guard;
+        const Tracked* current = shared.load(std::memory_order_acquire);
+        pinned = true;
+        while (!leave.load())
+            std::this_thread::yield();
+        observed = current->value;
+    });
+    while (!pinned.load())
+        std::this_thread::yield();
+
+    Epoch::Retire(shared.exchange(new Tracked(2)));
+    EXPECT_EQ(Epoch::Collect(), 0u);
+    EXPECT_EQ(Tracked::alive.load(), base + 2);
+
+    leave = true;
+    reader.join();
+    EXPECT_EQ(observed.load(), 1);
+
+    Epoch::Synchronize();
+    EXPECT_EQ(Epoch::Collect(), 1u);
+    EXPECT_EQ(Tracked::alive.load(), base + 1);
+
+    delete shared.load();
+}
+
+TEST(EpochTest, BatchCollectsAutomatically)
+{
+    Epoch::Drain();
+    const int base = Tracked::alive.load();
+
+    for (Size i = 0; i < Epoch::kRetireBatch * 4; ++i)
+    {
+        Epoch::Retire(new Tracked(static_cast<int>(i)));
+        EXPECT_LE(Epoch::GetPendingCount(), Epoch::kRetireBatch);
+    }
+
+    Epoch::Drain();
+    EXPECT_EQ(Epoch::GetPendingCount(), 0u);
+    EXPECT_EQ(Tracked::alive.load(), base);
+}
+
+TEST(EpochTest, RetireReturnsMemoryToAllocator)
+{
+    Epoch::Drain();
+
+    CountingAllocator allocator;
+    auto handle = allocator.allocate(128, 16);
+    Epoch::Retire(allocator, handle);
+    Epoch::Retire(allocator, AllocationHandle{}); // 空句柄被忽略
+    EXPECT_EQ(allocator.live, 1);
+
+    Epoch::Drain();
+    EXPECT_EQ(allocator.live, 0);
+}
+
+TEST(EpochTest, ExitingThreadHandsOverPendingObjects)
+{
+    Epoch::Drain();
+    const int base = Tracked::alive.load();
+
+    std::atomic<bool> pinned{false};
+    std::atomic<bool> leave{false};
+    std::thread reader([&]
+    {
+        EpochGuard guard;
+        pinned = true;
+        while (!leave.load())
+            std::this_thread::yield();
+    });
+    while (!pinned.load())
+        std::this_thread::yield();
+
+    // 读者未离开，退出线程的对象无法当场释放
+    std::thread writer([]
+    {
+        Epoch::RegisterThread();
+        for (int i = 0; i < 3; ++i)
+            Epoch::Retire(new Tracked(i));
+    });
+    writer.join();
+    EXPECT_EQ(Tracked::alive.load(), base + 3);
+    EXPECT_EQ(Epoch::GetPendingCount(), 3u);
+
+    leave = true;
+    reader.join();
+    Epoch::Drain();
+    EXPECT_EQ(Epoch::GetPendingCount(), 0u);
+    EXPECT_EQ(Tracked::alive.load(), base);
+}
+
+TEST(EpochTest, RetireListFreesAfterGrace)
+{
+    Epoch::Drain();
+    const int base = Tracked::alive.load();
+
+    RetireList list;
+    list.retire(new Tracked(0));
+    {
+        EpochGuard guard;
+        list.collect();
+        EXPECT_EQ(list.size(), 1u);
+    }
+
+    Epoch::Synchronize();
+    list.collect();
+    EXPECT_EQ(list.size(), 0u);
+
+    // 析构时释放剩余对象
+    {
+        RetireList pending;
+        pending.retire(new Tracked(1));
+    }
+    EXPECT_EQ(Tracked::alive.load(), base);
+}
+
+TEST(EpochTest, StressReadersNeverSeeFreedObject)
+{
+    constexpr int kReaders = 3;
+    constexpr int kWrites  = 5'000;
+
+    Epoch::Drain();
+    const int base = Tracked::alive.load();
+
+    std::atomic<Tracked*> shared{new Tracked(0)};
+    std::atomic<bool> stop{false};
+    std::atomic<int> broken{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < kReaders; ++r)
+    {
+        readers.emplace_back([&]
+        {
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                EpochGuard guard;
+                const Tracked* current = shared.load(std::memory_order_acquire);
+                if (current->value < 0)
+                    broken.fetch_add(1, std::memory_order_relaxed);
+                std::this_thread::yield();
+            }
+        });
+    }
+
+    std::thread writer([&]
+    {
+        for (int i = 1; i <= kWrites; ++i)
+        {
+            Epoch::Retire(shared.exchange(new Tracked(i), std::memory_order_acq_rel));
+            if (i % 64 == 0)
+                std::this_thread::yield();
+        }
+        stop = true;
+    });
+
+    writer.join();
+    for (auto& reader : readers)
+        reader.join();
+
+    EXPECT_EQ(broken.load(), 0);
+    delete shared.load();
+    Epoch::Drain();
+    EXPECT_EQ(Tracked::alive.load(), base);
+}
+
+TEST(EpochTest, RetireListChurnAgainstPinnedReaders)
+{
+    constexpr int kReaders = 3;
+    constexpr int kWrites  = 5'000;
+
+    Epoch::Drain();
+    const int base = Tracked::alive.load();
+
+    // 模拟订阅/退订：写者复制当前表、增删一个元素后发布，旧表挂到 RetireList
+    struct Table
+    {
+        std::vector<Tracked*> items;
+    };
+
+    std::atomic<Table*> shared{new Table()};
+    std::atomic<bool> stop{false};
+    std::atomic<int> broken{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < kReaders; ++r)
+    {
+        readers.emplace_back([&]
+        {
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                EpochGuard guard;
+                const Table* table = shared.load(std::memory_order_acquire);
+                for (const auto* item : table->items)
+                {
+                    if (item->value < 0)
+                        broken.fetch_add(1, std::memory_order_relaxed);
+                }
+                std::this_thread::yield();
+            }
+        });
+    }
+
+    std::thread writer([&]
+    {
+        RetireList retired;
+        for (int i = 1; i <= kWrites; ++i)
+        {
+            const Table* old = shared.load(std::memory_order_relaxed);
+            auto* next       = new Table(*old);
+            if (i % 3 == 0 && !next->items.empty())
+            {
+                retired.retire(next->items.front());
+                next->items.erase(next->items.begin());
+            }
+            else
+            {
+                next->items.push_back(new Tracked(i));
+            }
+
+            shared.store(next, std::memory_order_release);
+            retired.retire(old);
+            retired.collect();
+            if (i % 64 == 0)
+                std::this_thread::yield();
+        }
+        stop = true;
+
+        for (auto& reader : readers)
+            reader.join();
+        Epoch::Synchronize();
+        retired.collect();
+        EXPECT_EQ(retired.size(), 0u);
+    });
+    writer.join();
+
+    EXPECT_EQ(broken.load(), 0);
+    const Table* last = shared.load();
+    for (const auto* item : last->items)
+        delete item;
+    delete last;
+    EXPECT_EQ(Tracked::alive.load(), base);
+}
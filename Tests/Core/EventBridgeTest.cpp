@@ -0,0 +1,250 @@
+/**
+ * @File EventBridgeTest.cpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/9/25
+ * @Brief 共享内存事件桥的单元测试
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Core/Events/EventBridge.hpp"
+#include "Core/Events/SharedEventRing.hpp"
+#include "Core/Platform/Events/PlatformEvents.hpp"
+
+using namespace xihe;
+
+namespace {
+std::string UniqueName(std::string_view test)
+{
+    return std::format("xihe-test-{}-{}", test, std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+std::vector<u8> Bytes(std::string_view text)
+{
+    return {text.begin(), text.end()};
+}
+} // namespace
+
+TEST(SharedEventRingTest, WriteAndPoll)
+{
+    const auto name = UniqueName("ring");
+    SharedEventRingWriter writer(name, 4096);
+    const auto typeA = writer.registerType("A");
+    const auto typeB = writer.registerType("B");
+    EXPECT_EQ(writer.registerType("A"), typeA);
+
+    SharedEventReader reader(name);
+    EXPECT_EQ(reader.poll([](const SharedEventView&) {}), 0u);
+
+    ASSERT_TRUE(writer.write(typeA, EventPriority::High, false, 100, Bytes("hello")));
+    ASSERT_TRUE(writer.write(typeB, EventPriority::Low, true, 200, {}));
+
+    std::vector<std::string> seen;
+    const auto count = reader.poll([&](const SharedEventView& view)
+    {
+        seen.push_back(std::format("{}:{}:{}:{}:{}", view.typeName, static_cast<u32>(view.priority), view.queued,
+                                   view.timestampNs,
+                                   std::string_view(reinterpret_cast<const char*>(view.payload.data()), view.payload.size())));
+    });
+
+    EXPECT_EQ(count, 2u);
+    EXPECT_EQ(seen, (std::vector<std::string>{"A:2:false:100:hello", "B:0:true:200:"}));
+}
+
+TEST(SharedEventRingTest, WrapsAroundAndDropsWhenFull)
+{
+    const auto name = UniqueName("wrap");
+    SharedEventRingWriter writer(name, 4096);
+    const auto type = writer.registerType("T");
+    SharedEventReader reader(name);
+
+    const std::vector<u8> payload(100, 7);
+
+    // 未被读取时写满后丢弃
+    Size written = 0;
+    while (writer.write(type, EventPriority::Normal, false, written, payload))
+        ++written;
+    EXPECT_GT(written, 0u);
+    EXPECT_EQ(writer.getDroppedCount(), 1u);
+    EXPECT_EQ(reader.getDroppedCount(), 1u);
+
+    // 读者释放空间后继续写入，多次绕回缓冲区末尾
+    std::vector<u64> sequences;
+    auto collect = [&](const SharedEventView& view)
+    {
+        EXPECT_EQ(view.payload.size(), payload.size());
+        sequences.push_back(view.sequence);
+    };
+    for (int round = 0; round < 20; ++round)
+    {
+        reader.poll(collect);
+        for (int i = 0; i < 10; ++i)
+            EXPECT_TRUE(writer.write(type, EventPriority::Normal, false, i, payload));
+    }
+    reader.poll(collect);
+
+    ASSERT_EQ(sequences.size(), written + 200);
+
+    // 被丢弃的记录表现为序号跳跃
+    Size gaps = 0;
+    for (Size i = 1; i < sequences.size(); ++i)
+        gaps += sequences[i] != sequences[i - 1] + 1;
+    EXPECT_EQ(gaps, 1u);
+}
+
+TEST(SharedEventRingTest, ConcurrentReader)
+{
+    const auto name = UniqueName("spsc");
+    SharedEventRingWriter writer(name, 8192);
+    const auto type = writer.registerType("Counter");
+    SharedEventReader reader(name);
+
+    constexpr u64 kCount = 20000;
+    std::thread producer([&]
+    {
+        for (u64 i = 0; i < kCount;)
+        {
+            EventWriter payload;
+            payload.write(i);
+            if (writer.write(type, EventPriority::Normal, false, i, payload.data()))
+                ++i;
+            else
+                std::this_thread::yield();
+        }
+    });
+
+    u64 next = 0;
+    while (next < kCount)
+    {
+        reader.poll([&](const SharedEventView& view)
+        {
+            EventReader payload(view.payload);
+            EXPECT_EQ(payload.read<u64>(), next);
+            ++next;
+        });
+    }
+    producer.join();
+    EXPECT_EQ(next, kCount);
+}
+
+TEST(SharedEventRingTest, MalformedRecordStopsReader)
+{
+    // 通过已读记录的负载指针定位到下一条记录的头部，模拟其他进程改写共享内存
+    const auto corruptions = std::vector<void (*)(SharedEventRecordHeader&)>{
+        [](SharedEventRecordHeader& record) { record.size = 0; },
+        [](SharedEventRecordHeader& record) { record.size = kSharedEventAlignment + 8; },
+        [](SharedEventRecordHeader& record) { record.size = 1u << 20; },
+        [](SharedEventRecordHeader& record) { record.size = 3 * kSharedEventAlignment; },
+        [](SharedEventRecordHeader& record) { record.payloadSize = record.size; },
+    };
+
+    for (Size i = 0; i < corruptions.size(); ++i)
+    {
+        const auto name = UniqueName(std::format("corrupt{}", i));
+        SharedEventRingWriter writer(name, 4096);
+        const auto type = writer.registerType("T");
+        SharedEventReader reader(name);
+
+        ASSERT_TRUE(writer.write(type, EventPriority::Normal, false, 0, Bytes("first")));
+        ASSERT_TRUE(writer.write(type, EventPriority::Normal, false, 1, Bytes("second")));
+
+        const u8* payload = nullptr;
+        EXPECT_EQ(reader.poll([&](const SharedEventView& view) { payload = view.payload.data(); }, 1), 1u);
+        ASSERT_NE(payload, nullptr);
+
+        const auto* first = reinterpret_cast<const SharedEventRecordHeader*>(payload) - 1;
+        auto* second      = reinterpret_cast<SharedEventRecordHeader*>(const_cast<u8*>(payload) - sizeof(*first) + first->size);
+        corruptions[i](*second);
+
+        EXPECT_EQ(reader.poll([](const SharedEventView&) { FAIL() << "不应读出损坏的记录"; }), 0u) << i;
+        EXPECT_TRUE(reader.isCorrupt()) << i;
+
+        // 损坏后不再读取，写者继续写入也不会被读出
+        ASSERT_TRUE(writer.write(type, EventPriority::Normal, false, 2, Bytes("third")));
+        EXPECT_EQ(reader.poll([](const SharedEventView&) {}), 0u) << i;
+    }
+}
+
+TEST(SharedEventRingTest, OpenMissingThrows)
+{
+    EXPECT_THROW(SharedEventReader(UniqueName("missing")), RuntimeError);
+}
+
+TEST(EventSharedMemoryBridgeTest, MirrorsSelectedTypes)
+{
+    const auto name = UniqueName("bridge");
+    EventBus bus(EventBus::Config{.queueWorkers = 0});
+    EventSharedMemoryBridge bridge(bus, name);
+    bridge.mirror<KeyboardEvent>("KeyboardEvent");
+    bridge.mirror<WindowResizeEvent>("WindowResizeEvent");
+
+    SharedEventReader reader(name);
+
+    bus.dispatch(std::make_shared<KeyboardEvent>(KeyCode::B, true, false, 48));
+    bus.dispatch(std::make_shared<MouseMotionEvent>(1, 2, 3, 4)); // 未镜像
+    bus.enqueue(std::make_shared<WindowResizeEvent>(1, 640, 480), EventPriority::Critical);
+    bus.processQueue();
+
+    EXPECT_EQ(bridge.getPublishedCount(), 2u);
+
+    std::vector<std::string> decoded;
+    reader.poll([&](const SharedEventView& view)
+    {
+        if (view.typeName == "KeyboardEvent")
+        {
+            const auto event = view.decode<KeyboardEvent>();
+            EXPECT_FALSE(view.queued);
+            EXPECT_EQ(view.priority, EventPriority::High);
+            decoded.push_back(std::format("key {} {}", static_cast<u32>(event.key), event.scancode));
+        }
+        else if (view.typeName == "WindowResizeEvent")
+        {
+            const auto event = view.decode<WindowResizeEvent>();
+            EXPECT_TRUE(view.queued);
+            EXPECT_EQ(view.priority, EventPriority::Critical);
+            decoded.push_back(std::format("resize {}x{}", event.width, event.height));
+        }
+    });
+
+    EXPECT_EQ(decoded, (std::vector<std::string>{std::format("key {} 48", static_cast<u32>(KeyCode::B)), "resize 640x480"}));
+}
+
+TEST(EventSharedMemoryBridgeTest, DestroyWhileOtherThreadsPublish)
+{
+    EventBus bus(EventBus::Config{.queueWorkers = 2});
+    std::atomic<bool> stop{false};
+    std::atomic<u64> sent{0};
+
+    std::thread producer([&]
+    {
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            bus.dispatch(std::make_shared<KeyboardEvent>(KeyCode::A, true, false, 30));
+            bus.enqueue(std::make_shared<KeyboardEvent>(KeyCode::A, false, false, 30));
+            sent.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    // 反复创建与销毁桥，析构时其他线程的同步分发与队列处理可能正在镜像
+    for (int i = 0; i < 20; ++i)
+    {
+        auto bridge = std::make_unique<EventSharedMemoryBridge>(bus, UniqueName("teardown"), 64_KiB);
+        bridge->mirror<KeyboardEvent>("KeyboardEvent");
+
+        const u64 target = sent.load() + 50;
+        while (sent.load() < target)
+            std::this_thread::yield();
+        bridge.reset();
+    }
+
+    stop = true;
+    producer.join();
+    bus.processQueue();
+    EXPECT_EQ(bus.getSubscriberCount(), 0u);
+}
@@ -0,0 +1,206 @@
+/**
+ * @File EventRecorderTest.cpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/9/22
+ * @Brief 事件录制与回放的单元测试
+ */
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Core/Events/EventBus.hpp"
+#include "Core/Events/EventRecorder.hpp"
+#include "Core/Events/EventSerialization.hpp"
+#include "Core/Platform/Events/PlatformEvents.hpp"
+
+using namespace xihe;
+
+namespace {
+// 未注册序列化方式的事件
+class UnrecordedEvent : public EventBase<UnrecordedEvent>
+{
+};
+
+// 记录总线收到的调用序列
+class CallLog final : public IEventObserver
+{
+public:
+    struct Entry
+    {
+        bool queued;
+        std::string text;
+        EventPriority priority;
+        std::optional<u64> orderKey;
+    };
+
+    void onDispatch(const EventPtr& event) override
+    {
+        entries.push_back({false, event->toString(), event->getPriority(), std::nullopt});
+    }
+
+    void onEnqueue(const EventPtr& event, EventPriority priority, std::optional<u64> orderKey) override
+    {
+        entries.push_back({true, event->toString(), priority, orderKey});
+    }
+
+    std::vector<Entry> entries;
+};
+} // namespace
+
+class EventRecorderTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        RegisterPlatformEventCodecs();
+    }
+
+    // 录制一组固定的调用
+    static void RecordSample(EventBus& bus)
+    {
+        bus.dispatch(std::make_shared<KeyboardEvent>(KeyCode::A, true, false, 30));
+        bus.enqueue(std::make_shared<MouseMotionEvent>(10, 20, 1, -1), EventPriority::Low);
+        bus.enqueue(std::make_shared<TextInputEvent>("你好"), EventPriority::Critical, 7);
+        bus.dispatch(std::make_shared<UnrecordedEvent>());
+        bus.enqueue(std::make_shared<WindowResizeEvent>(1, 800, 600), EventPriority::High, 1ull << 40);
+    }
+};
+
+TEST_F(EventRecorderTest, WriterReaderRoundTrip)
+{
+    EventWriter writer;
+    writer.writeVarint(0);
+    writer.writeVarint(300);
+    writer.writeVarint(numeric_limits<u64>::max());
+    writer.writeString("事件");
+    writer.write(-1.5f);
+
+    EventReader reader(writer.data());
+    EXPECT_EQ(reader.readVarint(), 0u);
+    EXPECT_EQ(reader.readVarint(), 300u);
+    EXPECT_EQ(reader.readVarint(), numeric_limits<u64>::max());
+    EXPECT_EQ(reader.readString(), "事件");
+    EXPECT_EQ(reader.read<f32>(), -1.5f);
+    EXPECT_TRUE(reader.atEnd());
+    EXPECT_THROW(reader.read<u8>(), RuntimeError);
+}
+
+TEST_F(EventRecorderTest, ReplayReproducesCallSequence)
+{
+    std::stringstream stream;
+    CallLog original;
+    {
+        EventBus bus(EventBus::Config{.queueWorkers = 0});
+        EventRecorder recorder(stream);
+        recorder.attach(bus);
+        RecordSample(bus);
+
+        EXPECT_EQ(recorder.getRecordedCount(), 4u);
+        EXPECT_EQ(recorder.getSkippedCount(), 1u);
+
+        recorder.detach();
+        EXPECT_EQ(bus.getObserver(), nullptr);
+
+        // 分离后不再录制
+        bus.dispatch(std::make_shared<AppQuitEvent>());
+        EXPECT_EQ(recorder.getRecordedCount(), 4u);
+
+        bus.setObserver(&original);
+        RecordSample(bus);
+        bus.setObserver(nullptr);
+    }
+    // 未注册类型在回放中不存在
+    std::erase_if(original.entries, [](const CallLog::Entry& entry) { return entry.text.find("UnrecordedEvent") != std::string::npos; });
+
+    EventReplayer replayer(stream);
+    ASSERT_EQ(replayer.getRecords().size(), 4u);
+    EXPECT_EQ(replayer.getSkippedCount(), 0u);
+
+    CallLog replayed;
+    EventBus target(EventBus::Config{.queueWorkers = 0});
+    target.setObserver(&replayed);
+    EXPECT_EQ(replayer.replay(target, EventReplayer::Speed::Maximum), 4u);
+    target.setObserver(nullptr);
+
+    ASSERT_EQ(replayed.entries.size(), original.entries.size());
+    for (Size i = 0; i < replayed.entries.size(); ++i)
+    {
+        EXPECT_EQ(replayed.entries[i].queued, original.entries[i].queued) << i;
+        EXPECT_EQ(replayed.entries[i].text, original.entries[i].text) << i;
+        EXPECT_EQ(replayed.entries[i].priority, original.entries[i].priority) << i;
+        EXPECT_EQ(replayed.entries[i].orderKey, original.entries[i].orderKey) << i;
+    }
+    EXPECT_EQ(target.getDispatchedCount(), 1u);
+    EXPECT_EQ(target.getQueuedCount(), 3u);
+}
+
+TEST_F(EventRecorderTest, ReplayDeliversToListenersRepeatedly)
+{
+    std::stringstream stream;
+    {
+        EventBus bus(EventBus::Config{.queueWorkers = 0});
+        EventRecorder recorder(stream);
+        recorder.attach(bus);
+        for (i32 i = 0; i < 3; ++i)
+            bus.enqueue(std::make_shared<MouseMotionEvent>(i, i, 1, 2));
+    }
+
+    EventReplayer replayer(stream);
+    EventBus target(EventBus::Config{.queueWorkers = 0});
+    i32 totalDeltaX = 0;
+    target.subscribeAsync<MouseMotionEvent>([&](const MouseMotionEvent& event) { totalDeltaX += event.deltaX; });
+
+    // 回放时事件在队列中合并，每次回放都重新解码，不受上一次合并的影响
+    for (int round = 0; round < 2; ++round)
+    {
+        replayer.replay(target);
+        target.processQueue();
+    }
+    EXPECT_EQ(totalDeltaX, 6);
+}
+
+TEST_F(EventRecorderTest, OriginalSpeedKeepsRecordedSpacing)
+{
+    std::stringstream stream;
+    {
+        EventBus bus(EventBus::Config{.queueWorkers = 0});
+        EventRecorder recorder(stream);
+        recorder.attach(bus);
+        bus.dispatch(std::make_shared<AppQuitEvent>());
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        bus.dispatch(std::make_shared<AppQuitEvent>());
+    }
+
+    EventReplayer replayer(stream);
+    ASSERT_EQ(replayer.getRecords().size(), 2u);
+    const auto gap = replayer.getRecords()[1].offset - replayer.getRecords()[0].offset;
+    EXPECT_GE(gap, std::chrono::milliseconds(30));
+
+    EventBus target(EventBus::Config{.queueWorkers = 0});
+    const auto start = Clock::now();
+    replayer.replay(target, EventReplayer::Speed::Original);
+    EXPECT_GE(Clock::now() - start, std::chrono::milliseconds(30));
+}
+
+TEST_F(EventRecorderTest, RejectsMalformedStream)
+{
+    std::stringstream notRecording("not a recording");
+    EXPECT_THROW(EventReplayer{notRecording}, RuntimeError);
+
+    std::stringstream stream;
+    {
+        EventBus bus(EventBus::Config{.queueWorkers = 0});
+        EventRecorder recorder(stream);
+        recorder.attach(bus);
+        bus.dispatch(std::make_shared<WindowResizeEvent>(1, 2, 3));
+    }
+    auto data = stream.str();
+    data.pop_back();
+
+    std::stringstream truncated(data);
+    EXPECT_THROW(EventReplayer{truncated}, RuntimeError);
+}
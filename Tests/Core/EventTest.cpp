@@ -12,9 +12,14 @@
 #include <vector>
 #include <memory>
 #include <atomic>
+#include <array>
+#include <format>
+#include <mutex>
+#include <utility>
 
 #include "Core/Events/Event.hpp"
 #include "Core/Events/EventBus.hpp"
+#include "Core/Platform/Events/PlatformEvents.hpp"
 
 using namespace xihe;
 
@@ -352,6 +357,25 @@ TEST_F(FiltersTest, CombinedFilters)
 
 // ======================================
 
+TEST(EventTypeIndexTest, DenseAndStable)
+{
+    const auto testIndex = EventTypeIndexOf<TestEvent>();
+    const auto highIndex = EventTypeIndexOf<HighPriorityEvent>();
+
+    EXPECT_NE(testIndex, highIndex);
+    EXPECT_EQ(testIndex, EventTypeIndexOf<TestEvent>());
+
+    // 稠密索引：都小于已注册的类型数
+    EXPECT_LT(testIndex, RegisteredEventTypeCount());
+    EXPECT_LT(highIndex, RegisteredEventTypeCount());
+
+    // 通过虚函数与注册表查询得到相同的索引
+    TestEvent event;
+    const IEvent& base = event;
+    EXPECT_EQ(base.typeIndex(), testIndex);
+    EXPECT_EQ(RegisterEventType(EventTypeId<TestEvent>()), testIndex);
+}
+
 class EventBusTest : public ::testing::Test
 {
 protected:
@@ -640,11 +664,91 @@ TEST_F(EventBusTest, EventFiltering)
     EXPECT_EQ(received2->getValue(), 100);
 }
 
+TEST_F(EventBusTest, DeclarativeMaskFiltering)
+{
+    std::vector<int> userValues;
+    std::vector<int> highValues;
+    std::vector<int> combinedValues;
+
+    eventBus->subscribe<TestEvent>([&](const TestEvent& event)
+    {
+        userValues.push_back(event.getValue());
+    }, filters::category(EventCategory::User));
+
+    eventBus->subscribe<TestEvent>([&](const TestEvent& event)
+    {
+        highValues.push_back(event.getValue());
+    }, filters::minPriority(EventPriority::High));
+
+    // 位掩码通过后再执行谓词
+    int predicateCalls = 0;
+    eventBus->subscribe<TestEvent>([&](const TestEvent& event)
+    {
+        combinedValues.push_back(event.getValue());
+    }, EventMask{.categories = EventCategory::App | EventCategory::User, .minPriority = EventPriority::Normal},
+    [&](const TestEvent& event)
+    {
+        ++predicateCalls;
+        return event.getValue() % 2 == 0;
+    });
+
+    auto makeEvent = [](int value, EventCategory category, EventPriority priority)
+    {
+        auto event = std::make_shared<TestEvent>(value);
+        event->setCategory(category);
+        event->setPriority(priority);
+        return event;
+    };
+
+    eventBus->dispatch(makeEvent(1, EventCategory::User, EventPriority::Low));
+    eventBus->dispatch(makeEvent(2, EventCategory::User, EventPriority::Normal));
+    eventBus->dispatch(makeEvent(3, EventCategory::Input, EventPriority::Critical));
+    eventBus->dispatch(makeEvent(4, EventCategory::App, EventPriority::High));
+    eventBus->dispatch(makeEvent(5, EventCategory::None, EventPriority::High));
+
+    EXPECT_EQ(userValues, (std::vector<int>{1, 2}));
+    EXPECT_EQ(highValues, (std::vector<int>{3, 4, 5}));
+    EXPECT_EQ(combinedValues, (std::vector<int>{2, 4}));
+
+    // 事件 1（Low）、3（Input）、5（无分类）在位掩码测试中被跳过
+    EXPECT_EQ(predicateCalls, 2);
+}
+
+TEST_F(EventBusTest, DeclarativeMaskInBatchAndQueue)
+{
+    eventBus = std::make_unique<EventBus>(EventBus::Config{.queueWorkers = 0});
+
+    int batchCount = 0;
+    int queueCount = 0;
+    eventBus->subscribe<TestEvent>([&](const TestEvent&) { ++batchCount; }, filters::minPriority(EventPriority::High));
+    eventBus->subscribeAsync<TestEvent>([&](const TestEvent&) { ++queueCount; }, filters::category(EventCategory::App));
+
+    std::vector<EventPtr> batch;
+    for (int i = 0; i < 8; ++i)
+    {
+        auto event = std::make_shared<TestEvent>(i);
+        event->setPriority(i % 2 == 0 ? EventPriority::High : EventPriority::Low);
+        event->setCategory(i < 4 ? EventCategory::App : EventCategory::User);
+        batch.push_back(event);
+    }
+
+    eventBus->processBatch(batch);
+    EXPECT_EQ(batchCount, 4);
+
+    for (auto& event : batch)
+        eventBus->enqueue(event, event->getPriority());
+    eventBus->processQueue();
+    EXPECT_EQ(queueCount, 4);
+}
+
 TEST_F(EventBusTest, EventPriority)
 {
     std::vector<int> processingOrder;
     std::mutex orderMutex;
 
+    // 不启动工作线程，由测试线程手动处理队列，避免后台线程抢先处理先入队的低优先级事件
+    eventBus = std::make_unique<EventBus>(EventBus::Config{.queueWorkers = 0});
+
     // 订阅同步事件处理器，避免异步处理的复杂性
     auto handle = eventBus->subscribeAsync<TestEvent>([&](const TestEvent& event)
     {
@@ -813,6 +917,43 @@ TEST_F(EventBusTest, EventCancellation)
     EXPECT_EQ(processed->getData(), "normal");
 }
 
+TEST_F(EventBusTest, CancelQueuedEventFromAnotherThread)
+{
+    EventBus bus(EventBus::Config{.queueWorkers = 0});
+
+    std::atomic<int> received{0};
+    bus.subscribeAsync<TestEvent>([&](const TestEvent&) { received.fetch_add(1); });
+
+    constexpr int kEventCount = 1000;
+    std::vector<std::shared_ptr<TestEvent>> events;
+    for (int i = 0; i < kEventCount; ++i)
+    {
+        events.push_back(std::make_shared<TestEvent>(i));
+        bus.enqueue(events.back());
+    }
+
+    // 其他线程取消偶数事件的同时在当前线程处理队列
+    std::thread canceller([&]
+    {
+        for (int i = 0; i < kEventCount; i += 2)
+            events[i]->cancel();
+    });
+    bus.processQueue();
+    canceller.join();
+
+    Size cancelled = 0;
+    for (const auto& event : events)
+        cancelled += event->isCancelled() ? 1 : 0;
+    EXPECT_EQ(cancelled, kEventCount / 2);
+    EXPECT_GE(received.load(), kEventCount / 2);
+    EXPECT_LE(received.load(), kEventCount);
+
+    // 复制的事件保留取消状态
+    TestEvent copy = *events[0];
+    EXPECT_TRUE(copy.isCancelled());
+    EXPECT_EQ(copy.getTimestamp(), events[0]->getTimestamp());
+}
+
 TEST_F(EventBusTest, MemoryManagement)
 {
     std::weak_ptr<TestEvent> weakEvent;
@@ -841,3 +982,1442 @@ TEST_F(EventBusTest, MemoryManagement)
     // 再次验证没有内存泄漏
     EXPECT_TRUE(weakEvent.expired());
 }
+
+TEST_F(EventBusTest, SubscribeDuringDispatch)
+{
+    int outerCount = 0;
+    int innerCount = 0;
+    EventBus::Handle innerHandle = EventBus::InvalidHandle;
+
+    eventBus->subscribe<TestEvent>([&](const TestEvent&)
+    {
+        ++outerCount;
+        if (innerHandle == EventBus::InvalidHandle)
+        {
+            innerHandle = eventBus->subscribe<TestEvent>([&](const TestEvent&)
+            {
+                ++innerCount;
+            });
+        }
+    });
+
+    auto event = std::make_shared<TestEvent>(1, "reentrant");
+
+    // 分发期间新增的监听器从下一次分发开始生效
+    eventBus->dispatch(event);
+    EXPECT_EQ(outerCount, 1);
+    EXPECT_EQ(innerCount, 0);
+
+    eventBus->dispatch(event);
+    EXPECT_EQ(outerCount, 2);
+    EXPECT_EQ(innerCount, 1);
+}
+
+TEST_F(EventBusTest, UnsubscribeDuringDispatch)
+{
+    int firstCount  = 0;
+    int secondCount = 0;
+    EventBus::Handle secondHandle = EventBus::InvalidHandle;
+
+    auto firstHandle = eventBus->subscribe<TestEvent>([&](const TestEvent&)
+    {
+        ++firstCount;
+        // 取消订阅后即使当前分发已取得旧快照也不会再调用
+        eventBus->unsubscribe(secondHandle);
+    });
+
+    secondHandle = eventBus->subscribe<TestEvent>([&](const TestEvent&)
+    {
+        ++secondCount;
+    });
+
+    eventBus->dispatch(std::make_shared<TestEvent>(1, "first"));
+    EXPECT_EQ(firstCount, 1);
+    EXPECT_EQ(secondCount, 0);
+    EXPECT_EQ(eventBus->getSubscriberCount(), 1);
+
+    EXPECT_TRUE(eventBus->unsubscribe(firstHandle));
+    EXPECT_EQ(eventBus->getSubscriberCount(), 0);
+}
+
+TEST_F(EventBusTest, ProcessBatchGroupsByType)
+{
+    std::vector<std::string> trace;
+    eventBus->subscribe<TestEvent>([&](const TestEvent& event)
+    {
+        trace.push_back("A" + std::to_string(event.getValue()));
+    });
+    eventBus->subscribe<TestEvent>([&](const TestEvent& event)
+    {
+        trace.push_back("B" + std::to_string(event.getValue()));
+    });
+    eventBus->subscribe<HighPriorityEvent>([&](const HighPriorityEvent& event)
+    {
+        trace.push_back("H" + event.getMessage());
+    });
+
+    auto cancelled = std::make_shared<TestEvent>(9);
+    cancelled->cancel();
+
+    std::vector<EventPtr> batch = {
+        std::make_shared<TestEvent>(1),
+        std::make_shared<HighPriorityEvent>("x"),
+        nullptr,
+        std::make_shared<TestEvent>(2),
+        cancelled,
+        std::make_shared<TimedEvent>(Clock::now()),
+        std::make_shared<HighPriorityEvent>("y"),
+        std::make_shared<TestEvent>(3),
+    };
+    eventBus->processBatch(batch);
+
+    // 每个监听器连续处理同类型的全部事件，同类型事件保持输入顺序
+    auto indexOf = [&](const std::string& item)
+    {
+        return std::ranges::find(trace, item) - trace.begin();
+    };
+
+    ASSERT_EQ(trace.size(), 8);
+    EXPECT_LT(indexOf("A1"), indexOf("A2"));
+    EXPECT_LT(indexOf("A2"), indexOf("A3"));
+    EXPECT_LT(indexOf("A3"), indexOf("B1"));
+    EXPECT_LT(indexOf("B1"), indexOf("B2"));
+    EXPECT_LT(indexOf("B2"), indexOf("B3"));
+    EXPECT_LT(indexOf("Hx"), indexOf("Hy"));
+
+    EXPECT_EQ(eventBus->getDispatchedCount(), 6);
+}
+
+TEST_F(EventBusTest, ProcessBatchResolvesEachTypeOnce)
+{
+    // 其他线程并发订阅时，交错批次中的同一类型仍只查找一次，不会被拆成两组
+    constexpr int kBatches = 500;
+    constexpr int kPairs   = 256;
+    std::string trace;
+    eventBus->subscribe<TestEvent>([&](const TestEvent&) { trace.push_back('T'); });
+    eventBus->subscribe<HighPriorityEvent>([&](const HighPriorityEvent&) { trace.push_back('H'); });
+
+    std::atomic<bool> stop{false};
+    std::thread churn([&]
+    {
+        while (!stop.load())
+        {
+            auto handle = eventBus->subscribe<TestEvent>([](const TestEvent&)
+            {
+            });
+            eventBus->unsubscribe(handle);
+        }
+    });
+
+    std::vector<EventPtr> batch;
+    for (int i = 0; i < kPairs; ++i)
+    {
+        batch.push_back(std::make_shared<TestEvent>(i));
+        batch.push_back(std::make_shared<HighPriorityEvent>());
+    }
+    const std::string expected = std::string(kPairs, 'T') + std::string(kPairs, 'H');
+
+    int split = 0;
+    for (int i = 0; i < kBatches; ++i)
+    {
+        trace.clear();
+        eventBus->processBatch(batch);
+        if (trace != expected)
+            ++split;
+    }
+    stop = true;
+    churn.join();
+
+    EXPECT_EQ(split, 0);
+}
+
+TEST_F(EventBusTest, NestedDispatch)
+{
+    std::vector<int> order;
+
+    eventBus->subscribe<HighPriorityEvent>([&](const HighPriorityEvent&)
+    {
+        order.push_back(2);
+    });
+
+    eventBus->subscribe<TestEvent>([&](const TestEvent&)
+    {
+        order.push_back(1);
+        eventBus->dispatch(std::make_shared<HighPriorityEvent>("nested"));
+        order.push_back(3);
+    });
+
+    eventBus->dispatch(std::make_shared<TestEvent>(1, "outer"));
+    EXPECT_EQ(order, (std::vector<int>{1, 2, 3}));
+}
+
+TEST_F(EventBusTest, DispatchWhileChurning)
+{
+    constexpr int kDispatchThreads = 4;
+    constexpr int kDispatchCount   = 2000;
+    std::atomic<bool> stop{false};
+    std::atomic<u64> calls{0};
+
+    // 常驻监听器，分发期间始终可见
+    eventBus->subscribe<TestEvent>([&](const TestEvent&)
+    {
+        calls.fetch_add(1, std::memory_order_relaxed);
+    });
+
+    std::thread churn([&]
+    {
+        while (!stop.load())
+        {
+            auto handle = eventBus->subscribe<TestEvent>([](const TestEvent&)
+            {
+            });
+            eventBus->unsubscribe(handle);
+        }
+    });
+
+    std::vector<std::thread> dispatchers;
+    for (int i = 0; i < kDispatchThreads; ++i)
+    {
+        dispatchers.emplace_back([&]
+        {
+            auto event = std::make_shared<TestEvent>(1, "churn");
+            for (int j = 0; j < kDispatchCount; ++j)
+                eventBus->dispatch(event);
+        });
+    }
+
+    for (auto& thread : dispatchers)
+        thread.join();
+    stop = true;
+    churn.join();
+
+    EXPECT_EQ(calls.load(), As<u64>(kDispatchThreads * kDispatchCount));
+    EXPECT_EQ(eventBus->getSubscriberCount(), 1);
+}
+
+TEST_F(EventBusTest, UnsubscribedListenerNotFreedUnderDispatch)
+{
+    constexpr int kDispatchThreads = 3;
+    constexpr int kDispatchCount   = 3000;
+
+    // 监听器捕获的对象在节点释放时被标记，分发中看到标记说明节点在读者仍持有快照时被释放
+    struct Probe
+    {
+        std::atomic<int>* broken;
+        int alive = 1;
+
+        explicit Probe(std::atomic<int>* b) :
+            broken(b)
+        {
+        }
+
+        Probe(const Probe&) = default;
+
+        ~Probe() { alive = 0; }
+    };
+
+    std::atomic<bool> stop{false};
+    std::atomic<int> broken{0};
+
+    std::thread churn([&]
+    {
+        std::vector<EventBus::Handle> handles;
+        for (int i = 0; !stop.load(); ++i)
+        {
+            handles.push_back(eventBus->subscribe<TestEvent>([probe = Probe(&broken)](const TestEvent&)
+            {
+                if (probe.alive != 1)
+                    probe.broken->fetch_add(1, std::memory_order_relaxed);
+            }));
+            if (handles.size() > 4)
+            {
+                eventBus->unsubscribe(handles.front());
+                handles.erase(handles.begin());
+            }
+            if (i % 32 == 0)
+                std::this_thread::yield();
+        }
+        for (auto handle : handles)
+            eventBus->unsubscribe(handle);
+    });
+
+    std::vector<std::thread> dispatchers;
+    for (int i = 0; i < kDispatchThreads; ++i)
+    {
+        dispatchers.emplace_back([&]
+        {
+            auto event = std::make_shared<TestEvent>(1, "churn");
+            for (int j = 0; j < kDispatchCount; ++j)
+                eventBus->dispatch(event);
+        });
+    }
+
+    for (auto& thread : dispatchers)
+        thread.join();
+    stop = true;
+    churn.join();
+
+    EXPECT_EQ(broken.load(), 0);
+    EXPECT_EQ(eventBus->getSubscriberCount(), 0);
+}
+
+// ======================================
+
+class EventBusPoolTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        EventBus::Config config;
+        config.queueWorkers = 4;
+        eventBus            = std::make_unique<EventBus>(config);
+    }
+
+    void TearDown() override
+    {
+        eventBus.reset();
+    }
+
+    template <typename Pred>
+    static bool waitUntil(Pred pred, std::chrono::milliseconds timeout = std::chrono::seconds(5))
+    {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (!pred())
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+                return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    std::unique_ptr<EventBus> eventBus;
+};
+
+TEST_F(EventBusPoolTest, WorkerCount)
+{
+    EXPECT_EQ(eventBus->getQueueWorkerCount(), 4);
+
+    EventBus defaultBus;
+    EXPECT_EQ(defaultBus.getQueueWorkerCount(), 1);
+}
+
+TEST_F(EventBusPoolTest, ManualProcessingWithoutWorkers)
+{
+    EventBus manualBus(EventBus::Config{.queueWorkers = 0});
+    EXPECT_EQ(manualBus.getQueueWorkerCount(), 0);
+
+    int count = 0;
+    manualBus.subscribeAsync<TestEvent>([&](const TestEvent&)
+    {
+        ++count;
+    });
+
+    for (int i = 0; i < 10; ++i)
+        manualBus.enqueue(std::make_shared<TestEvent>(i));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(count, 0);
+
+    manualBus.processQueue();
+    EXPECT_EQ(count, 10);
+}
+
+TEST_F(EventBusPoolTest, SameTypeKeepsOrder)
+{
+    constexpr int kEventCount = 2000;
+    std::vector<int> order;
+    std::mutex orderMutex;
+    std::atomic<int> concurrent{0};
+    std::atomic<bool> overlapped{false};
+
+    eventBus->subscribeAsync<TestEvent>([&](const TestEvent& event)
+    {
+        if (concurrent.fetch_add(1) != 0)
+            overlapped = true;
+        {
+            std::lock_guard lock(orderMutex);
+            order.push_back(event.getValue());
+        }
+        concurrent.fetch_sub(1);
+    });
+
+    for (int i = 0; i < kEventCount; ++i)
+        eventBus->dispatchAsync(std::make_shared<TestEvent>(i));
+
+    ASSERT_TRUE(waitUntil([&]
+    {
+        std::lock_guard lock(orderMutex);
+        return order.size() == kEventCount;
+    }));
+
+    // 同类型事件不会并发执行，且保持入队顺序
+    EXPECT_FALSE(overlapped.load());
+    for (int i = 0; i < kEventCount; ++i)
+        EXPECT_EQ(order[i], i);
+}
+
+TEST_F(EventBusPoolTest, SlowTypeDoesNotBlockOthers)
+{
+    std::atomic<bool> releaseSlow{false};
+    std::atomic<bool> slowStarted{false};
+    std::atomic<int> fastCount{0};
+
+    eventBus->subscribeAsync<HighPriorityEvent>([&](const HighPriorityEvent&)
+    {
+        slowStarted = true;
+        while (!releaseSlow.load())
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    });
+
+    eventBus->subscribeAsync<TestEvent>([&](const TestEvent&)
+    {
+        fastCount.fetch_add(1);
+    });
+
+    eventBus->dispatchAsync(std::make_shared<HighPriorityEvent>("slow"));
+    ASSERT_TRUE(waitUntil([&] { return slowStarted.load(); }));
+
+    for (int i = 0; i < 10; ++i)
+        eventBus->dispatchAsync(std::make_shared<TestEvent>(i));
+
+    // 慢处理器仍在运行时，其他类型的事件应由其他工作线程处理完
+    EXPECT_TRUE(waitUntil([&] { return fastCount.load() == 10; }));
+    releaseSlow = true;
+
+    // 处理器引用了局部变量，需在离开作用域前停止工作线程
+    eventBus.reset();
+}
+
+TEST_F(EventBusPoolTest, OrderKeyAcrossTypes)
+{
+    constexpr u64 kKey = 42;
+    std::vector<std::string> order;
+    std::mutex orderMutex;
+
+    eventBus->subscribeAsync<TestEvent>([&](const TestEvent& event)
+    {
+        std::lock_guard lock(orderMutex);
+        order.push_back("test" + std::to_string(event.getValue()));
+    });
+
+    eventBus->subscribeAsync<HighPriorityEvent>([&](const HighPriorityEvent& event)
+    {
+        std::lock_guard lock(orderMutex);
+        order.push_back(event.getMessage());
+    });
+
+    for (int i = 0; i < 50; ++i)
+    {
+        eventBus->dispatchAsync(std::make_shared<TestEvent>(i), EventPriority::Normal, kKey);
+        eventBus->dispatchAsync(std::make_shared<HighPriorityEvent>("high" + std::to_string(i)), EventPriority::Normal, kKey);
+    }
+
+    ASSERT_TRUE(waitUntil([&]
+    {
+        std::lock_guard lock(orderMutex);
+        return order.size() == 100;
+    }));
+
+    for (int i = 0; i < 50; ++i)
+    {
+        EXPECT_EQ(order[2 * i], "test" + std::to_string(i));
+        EXPECT_EQ(order[2 * i + 1], "high" + std::to_string(i));
+    }
+}
+
+TEST_F(EventBusPoolTest, ProcessQueueOnCallerThread)
+{
+    std::atomic<int> count{0};
+    eventBus->subscribeAsync<TestEvent>([&](const TestEvent&)
+    {
+        count.fetch_add(1);
+    });
+
+    for (int i = 0; i < 100; ++i)
+        eventBus->enqueue(std::make_shared<TestEvent>(i));
+
+    eventBus->processQueue();
+    EXPECT_TRUE(waitUntil([&] { return count.load() == 100; }));
+}
+
+// ======================================
+// 分片测试
+
+namespace {
+template <int N>
+class ShardEvent : public EventBase<ShardEvent<N>>
+{
+public:
+    explicit ShardEvent(int value = 0) :
+        value(value)
+    {
+    }
+
+    int value;
+};
+
+constexpr int kShardThreads = 16;
+
+template <typename F>
+void ForEachShardEvent(F&& func)
+{
+    [&]<int... Ns>(std::integer_sequence<int, Ns...>)
+    {
+        (func.template operator()<Ns>(), ...);
+    }(std::make_integer_sequence<int, kShardThreads>{});
+}
+} // namespace
+
+TEST_F(EventBusPoolTest, ShardCountIsIndependentOfWorkers)
+{
+    EXPECT_EQ(eventBus->getShardCount(), 1);
+    EXPECT_EQ(EventBus(EventBus::Config{.queueWorkers = 0, .shardCount = 16}).getShardCount(), 16);
+    EXPECT_EQ(EventBus(EventBus::Config{.queueWorkers = 4, .shardCount = 16}).getShardCount(), 16);
+    EXPECT_EQ(EventBus(EventBus::Config{.shardCount = 8}).getShardCount(), 8);
+    EXPECT_EQ(EventBus(EventBus::Config{.queueWorkers = 2, .shardCount = 0}).getShardCount(), 1);
+}
+
+TEST_F(EventBusPoolTest, ShardedSubscribeAndDispatchAcrossThreads)
+{
+    EventBus bus(EventBus::Config{.queueWorkers = 0, .shardCount = 8});
+
+    constexpr int kRounds = 500;
+    std::array<std::atomic<int>, kShardThreads> persistent{};
+    std::array<std::atomic<int>, kShardThreads> transient{};
+
+    // 每个线程只订阅、分发、入队自己的事件类型，常驻监听器应收到全部同步与队列事件
+    std::vector<std::thread> threads;
+    ForEachShardEvent([&]<int N>
+    {
+        threads.emplace_back([&]
+        {
+            bus.subscribe<ShardEvent<N>>([&](const ShardEvent<N>&) { persistent[N].fetch_add(1); });
+            bus.subscribeAsync<ShardEvent<N>>([&](const ShardEvent<N>&) { persistent[N].fetch_add(1); });
+            auto event = std::make_shared<ShardEvent<N>>(N);
+            for (int i = 0; i < kRounds; ++i)
+            {
+                const auto handle = bus.subscribe<ShardEvent<N>>([&](const ShardEvent<N>&) { transient[N].fetch_add(1); });
+                bus.dispatch(event);
+                EXPECT_TRUE(bus.unsubscribe(handle));
+                bus.enqueue(std::make_shared<ShardEvent<N>>(i));
+            }
+        });
+    });
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(bus.getSubscriberCount(), kShardThreads * 2);
+    EXPECT_EQ(bus.getDispatchedCount(), As<u64>(kShardThreads * kRounds));
+    EXPECT_EQ(bus.getPendingCount(), As<Size>(kShardThreads * kRounds));
+
+    bus.processQueue();
+    EXPECT_EQ(bus.getPendingCount(), 0);
+    for (int n = 0; n < kShardThreads; ++n)
+    {
+        EXPECT_EQ(persistent[n].load(), kRounds * 2);
+        EXPECT_EQ(transient[n].load(), kRounds);
+    }
+
+    bus.unsubscribeAll();
+    EXPECT_EQ(bus.getSubscriberCount(), 0);
+}
+
+TEST_F(EventBusPoolTest, ShardedQueueKeepsPerTypeOrder)
+{
+    auto check = [](const EventBus::Config& config)
+    {
+        EventBus bus(config);
+        ASSERT_EQ(bus.getShardCount(), config.shardCount);
+
+        constexpr int kEventCount = 1000;
+        std::array<std::vector<int>, kShardThreads> orders;
+        std::atomic<int> processed{0};
+        ForEachShardEvent([&]<int N>
+        {
+            // 同一类型总在同一分片的同一 lane 中串行处理，处理器内无需加锁
+            bus.subscribeAsync<ShardEvent<N>>([&](const ShardEvent<N>& event)
+            {
+                orders[N].push_back(event.value);
+                processed.fetch_add(1);
+            });
+        });
+
+        std::vector<std::thread> producers;
+        ForEachShardEvent([&]<int N>
+        {
+            producers.emplace_back([&]
+            {
+                for (int i = 0; i < kEventCount; ++i)
+                    bus.enqueue(std::make_shared<ShardEvent<N>>(i));
+            });
+        });
+        for (auto& thread : producers)
+            thread.join();
+
+        ASSERT_TRUE(waitUntil([&] { return processed.load() == kShardThreads * kEventCount; }));
+        for (const auto& order : orders)
+        {
+            ASSERT_EQ(order.size(), kEventCount);
+            for (int i = 0; i < kEventCount; ++i)
+                EXPECT_EQ(order[i], i);
+        }
+        EXPECT_EQ(bus.getQueuedCount(), As<u64>(kShardThreads * kEventCount));
+    };
+
+    // 分片数等于、多于、少于工作线程数
+    for (const auto& [workers, shardCount] : {std::pair<Size, Size>{4, 4}, {1, 8}, {3, 16}, {4, 2}})
+    {
+        SCOPED_TRACE(std::format("workers={} shards={}", workers, shardCount));
+        check(EventBus::Config{.queueWorkers = workers, .shardCount = shardCount});
+    }
+}
+
+TEST_F(EventBusPoolTest, ShardedCapacityIsSplit)
+{
+    EventBus bus(EventBus::Config{.queueWorkers = 0,
+                                  .queueCapacity = 8,
+                                  .shardCount = 2,
+                                  .overflowPolicy = EventBus::OverflowPolicy::DropNewest});
+
+    ForEachShardEvent([&]<int N>
+    {
+        for (int i = 0; i < 8; ++i)
+            bus.enqueue(std::make_shared<ShardEvent<N>>(i));
+    });
+
+    // 每个分片最多容纳 4 个事件
+    EXPECT_EQ(bus.getPendingCount(), 8);
+    EXPECT_EQ(bus.getDroppedCount(), As<u64>(kShardThreads * 8 - 8));
+}
+
+// ======================================
+// 事件合并测试
+
+class EventBusCoalesceTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // 手动处理队列，保证入队期间事件不会被工作线程取走
+        eventBus = std::make_unique<EventBus>(EventBus::Config{.queueWorkers = 0});
+    }
+
+    void TearDown() override
+    {
+        eventBus.reset();
+    }
+
+    std::unique_ptr<EventBus> eventBus;
+};
+
+TEST_F(EventBusCoalesceTest, AccumulateMergesDeltas)
+{
+    std::vector<MouseMotionEvent> received;
+    eventBus->subscribeAsync<MouseMotionEvent>([&](const MouseMotionEvent& event)
+    {
+        received.push_back(event);
+    });
+
+    for (int i = 1; i <= 100; ++i)
+        eventBus->enqueue(std::make_shared<MouseMotionEvent>(i, 2 * i, 1, -2));
+
+    eventBus->processQueue();
+
+    ASSERT_EQ(received.size(), 1);
+    EXPECT_EQ(received[0].x, 100);
+    EXPECT_EQ(received[0].y, 200);
+    EXPECT_EQ(received[0].deltaX, 100);
+    EXPECT_EQ(received[0].deltaY, -200);
+
+    EXPECT_EQ(eventBus->getQueuedCount(), 100);
+    EXPECT_EQ(eventBus->getCoalescedCount(), 99);
+}
+
+TEST_F(EventBusCoalesceTest, LatestWinsPerWindow)
+{
+    std::vector<WindowResizeEvent> received;
+    eventBus->subscribeAsync<WindowResizeEvent>([&](const WindowResizeEvent& event)
+    {
+        received.push_back(event);
+    });
+
+    for (u32 i = 1; i <= 10; ++i)
+        eventBus->enqueue(std::make_shared<WindowResizeEvent>(1, 100 * i, 50 * i));
+
+    // 不同窗口的事件不会合并
+    eventBus->enqueue(std::make_shared<WindowResizeEvent>(2, 640, 480));
+
+    eventBus->processQueue();
+
+    ASSERT_EQ(received.size(), 2);
+    EXPECT_EQ(received[0].windowId, 1);
+    EXPECT_EQ(received[0].width, 1000);
+    EXPECT_EQ(received[0].height, 500);
+    EXPECT_EQ(received[1].windowId, 2);
+    EXPECT_EQ(received[1].width, 640);
+}
+
+TEST_F(EventBusCoalesceTest, ProcessedEventsAreNotMergedInto)
+{
+    std::vector<int> deltas;
+    eventBus->subscribeAsync<MouseMotionEvent>([&](const MouseMotionEvent& event)
+    {
+        deltas.push_back(event.deltaX);
+    });
+
+    eventBus->enqueue(std::make_shared<MouseMotionEvent>(0, 0, 1, 0));
+    eventBus->enqueue(std::make_shared<MouseMotionEvent>(0, 0, 2, 0));
+    eventBus->processQueue();
+
+    eventBus->enqueue(std::make_shared<MouseMotionEvent>(0, 0, 4, 0));
+    eventBus->processQueue();
+
+    EXPECT_EQ(deltas, (std::vector<int>{3, 4}));
+}
+
+TEST_F(EventBusCoalesceTest, NonCoalescableTypesAreUntouched)
+{
+    int count = 0;
+    eventBus->subscribeAsync<TestEvent>([&](const TestEvent&)
+    {
+        ++count;
+    });
+
+    for (int i = 0; i < 10; ++i)
+        eventBus->enqueue(std::make_shared<TestEvent>(i));
+
+    eventBus->processQueue();
+
+    EXPECT_EQ(count, 10);
+    EXPECT_EQ(eventBus->getCoalescedCount(), 0);
+}
+
+TEST_F(EventBusCoalesceTest, CancelledPendingEventIsReplaced)
+{
+    std::vector<int> deltas;
+    eventBus->subscribeAsync<MouseMotionEvent>([&](const MouseMotionEvent& event)
+    {
+        deltas.push_back(event.deltaX);
+    });
+
+    auto first = std::make_shared<MouseMotionEvent>(0, 0, 1, 0);
+    eventBus->enqueue(first);
+    first->cancel();
+
+    eventBus->enqueue(std::make_shared<MouseMotionEvent>(0, 0, 5, 0));
+    eventBus->processQueue();
+
+    EXPECT_EQ(deltas, (std::vector<int>{5}));
+}
+
+// ======================================
+// 有界队列测试
+
+class EventBusOverflowTest : public ::testing::Test
+{
+protected:
+    static std::unique_ptr<EventBus> makeBus(Size capacity, EventBus::OverflowPolicy policy)
+    {
+        EventBus::Config config;
+        config.queueWorkers   = 0;
+        config.queueCapacity  = capacity;
+        config.overflowPolicy = policy;
+        return std::make_unique<EventBus>(config);
+    }
+};
+
+TEST_F(EventBusOverflowTest, DropNewest)
+{
+    auto bus = makeBus(4, EventBus::OverflowPolicy::DropNewest);
+
+    std::vector<int> values;
+    bus->subscribeAsync<TestEvent>([&](const TestEvent& event)
+    {
+        values.push_back(event.getValue());
+    });
+
+    for (int i = 0; i < 10; ++i)
+        bus->enqueue(std::make_shared<TestEvent>(i));
+
+    EXPECT_EQ(bus->getPendingCount(), 4);
+    bus->processQueue();
+
+    EXPECT_EQ(values, (std::vector<int>{0, 1, 2, 3}));
+
+    auto stats = bus->getStatistics();
+    EXPECT_EQ(stats.droppedNewest, 6);
+    EXPECT_EQ(stats.droppedEvicted, 0);
+    EXPECT_EQ(stats.pendingCount, 0);
+    EXPECT_EQ(bus->getDroppedCount(), 6);
+}
+
+TEST_F(EventBusOverflowTest, DropOldestOfLowestPriority)
+{
+    auto bus = makeBus(3, EventBus::OverflowPolicy::DropOldestLowestPriority);
+
+    std::vector<int> values;
+    bus->subscribeAsync<TestEvent>([&](const TestEvent& event)
+    {
+        values.push_back(event.getValue());
+    });
+
+    bus->enqueue(std::make_shared<TestEvent>(1), EventPriority::Low);
+    bus->enqueue(std::make_shared<TestEvent>(2), EventPriority::Low);
+    bus->enqueue(std::make_shared<TestEvent>(3), EventPriority::High);
+
+    // 驱逐最早的 Low 事件 1
+    bus->enqueue(std::make_shared<TestEvent>(4), EventPriority::Normal);
+    // 驱逐剩下的 Low 事件 2
+    bus->enqueue(std::make_shared<TestEvent>(5), EventPriority::High);
+    // 队列中没有不高于 Low 的事件，丢弃新事件
+    bus->enqueue(std::make_shared<TestEvent>(6), EventPriority::Low);
+
+    bus->processQueue();
+
+    EXPECT_EQ(values, (std::vector<int>{3, 5, 4}));
+
+    auto stats = bus->getStatistics();
+    EXPECT_EQ(stats.droppedEvicted, 2);
+    EXPECT_EQ(stats.droppedNewest, 1);
+}
+
+TEST_F(EventBusOverflowTest, DropOldestByEnqueueOrderAcrossLanes)
+{
+    EventBus::Config config;
+    config.queueWorkers   = 2;
+    config.shardCount     = 1;
+    config.queueCapacity  = 16;
+    config.overflowPolicy = EventBus::OverflowPolicy::DropOldestLowestPriority;
+    auto bus              = std::make_unique<EventBus>(config);
+
+    // 高优先级的闸门事件分散到多个 lane，占住两个工作线程，其余闸门留在队列中
+    constexpr int kGates = 16;
+    std::atomic<int> entered{0};
+    std::atomic<bool> release{false};
+    bus->subscribeAsync<HighPriorityEvent>([&](const HighPriorityEvent&)
+    {
+        entered.fetch_add(1);
+        while (!release.load())
+            std::this_thread::yield();
+    });
+
+    std::mutex mutex;
+    std::vector<int> values;
+    std::atomic<int> timed{0};
+    bus->subscribeAsync<TestEvent>([&](const TestEvent& event)
+    {
+        std::lock_guard lock(mutex);
+        values.push_back(event.getValue());
+    });
+    bus->subscribeAsync<TimedEvent>([&](const TimedEvent&) { timed.fetch_add(1); });
+
+    for (int i = 0; i < kGates; ++i)
+        bus->enqueue(std::make_shared<HighPriorityEvent>("gate"), EventPriority::High, As<u64>(i));
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (entered.load() < 2 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::yield();
+    ASSERT_EQ(entered.load(), 2);
+
+    // 创建时间最早的事件最后入队，驱逐时应按入队先后而不是创建时间选择
+    auto early = std::make_shared<TimedEvent>(FastClock::now() - std::chrono::hours(1));
+    bus->enqueue(std::make_shared<TestEvent>(1));
+    bus->enqueue(early);
+    bus->enqueue(std::make_shared<TestEvent>(2));
+
+    release = true;
+    const auto done = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (bus->getPendingCount() > 0 && std::chrono::steady_clock::now() < done)
+        std::this_thread::yield();
+    bus.reset();
+
+    EXPECT_EQ(values, (std::vector<int>{2}));
+    EXPECT_EQ(timed.load(), 1);
+}
+
+TEST_F(EventBusOverflowTest, CoalesceWhenFull)
+{
+    auto bus = makeBus(2, EventBus::OverflowPolicy::Coalesce);
+
+    std::vector<int> deltas;
+    bus->subscribeAsync<MouseMotionEvent>([&](const MouseMotionEvent& event)
+    {
+        deltas.push_back(event.deltaX);
+    });
+
+    bus->enqueue(std::make_shared<MouseMotionEvent>(0, 0, 1, 0));
+    bus->enqueue(std::make_shared<MouseMotionEvent>(0, 0, 10, 0), EventPriority::High);
+    // 队列已满，与同优先级的同类型事件合并
+    bus->enqueue(std::make_shared<MouseMotionEvent>(0, 0, 2, 0));
+
+    bus->processQueue();
+
+    EXPECT_EQ(deltas, (std::vector<int>{10, 3}));
+
+    auto stats = bus->getStatistics();
+    EXPECT_EQ(stats.coalescedCount, 1);
+    EXPECT_EQ(stats.droppedNewest, 0);
+}
+
+TEST_F(EventBusOverflowTest, CoalesceDropsTypesWithoutPolicy)
+{
+    auto bus = makeBus(2, EventBus::OverflowPolicy::Coalesce);
+
+    std::vector<int> values;
+    int highCount = 0;
+    bus->subscribeAsync<TestEvent>([&](const TestEvent& event)
+    {
+        values.push_back(event.getValue());
+    });
+    bus->subscribeAsync<HighPriorityEvent>([&](const HighPriorityEvent&)
+    {
+        ++highCount;
+    });
+
+    bus->enqueue(std::make_shared<TestEvent>(1));
+    bus->enqueue(std::make_shared<TestEvent>(2));
+    // 未声明合并策略，不会覆盖已入队的事件，而是丢弃并计数
+    bus->enqueue(std::make_shared<TestEvent>(3));
+    // 没有可合并的同类型事件，丢弃
+    bus->enqueue(std::make_shared<HighPriorityEvent>("dropped"), EventPriority::High);
+
+    bus->processQueue();
+
+    EXPECT_EQ(values, (std::vector<int>{1, 2}));
+    EXPECT_EQ(highCount, 0);
+
+    auto stats = bus->getStatistics();
+    EXPECT_EQ(stats.coalescedCount, 0);
+    EXPECT_EQ(stats.droppedNewest, 2);
+}
+
+TEST_F(EventBusOverflowTest, ClearQueueReleasesCapacity)
+{
+    auto bus = makeBus(2, EventBus::OverflowPolicy::DropNewest);
+
+    bus->enqueue(std::make_shared<TestEvent>(1));
+    bus->enqueue(std::make_shared<TestEvent>(2));
+    EXPECT_EQ(bus->getPendingCount(), 2);
+
+    bus->clearQueue();
+    EXPECT_EQ(bus->getPendingCount(), 0);
+
+    bus->enqueue(std::make_shared<TestEvent>(3));
+    EXPECT_EQ(bus->getPendingCount(), 1);
+    EXPECT_EQ(bus->getDroppedCount(), 0);
+}
+
+TEST_F(EventBusPoolTest, BlockUntilSpaceAvailable)
+{
+    EventBus::Config config;
+    config.queueWorkers   = 1;
+    config.queueCapacity  = 2;
+    config.overflowPolicy = EventBus::OverflowPolicy::Block;
+    auto bus              = std::make_unique<EventBus>(config);
+
+    std::atomic<bool> release{false};
+    std::atomic<int> processed{0};
+    std::atomic<int> produced{0};
+    bus->subscribeAsync<TestEvent>([&](const TestEvent&)
+    {
+        while (!release.load())
+            std::this_thread::yield();
+        ++processed;
+    });
+
+    std::thread producer([&]
+    {
+        for (int i = 0; i < 10; ++i)
+        {
+            bus->enqueue(std::make_shared<TestEvent>(i));
+            ++produced;
+        }
+    });
+
+    // 工作线程被阻塞时，生产者最多放入 1 个处理中的事件与 2 个待处理事件
+    EXPECT_TRUE(waitUntil([&] { return produced.load() == 3; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(produced.load(), 3);
+    EXPECT_LE(bus->getPendingCount(), 2);
+
+    release = true;
+    producer.join();
+
+    EXPECT_TRUE(waitUntil([&] { return processed.load() == 10; }));
+    EXPECT_EQ(bus->getDroppedCount(), 0);
+    bus.reset();
+}
+
+TEST_F(EventBusPoolTest, BlockDoesNotDeadlockInsideHandler)
+{
+    EventBus::Config config;
+    config.queueWorkers   = 1;
+    config.queueCapacity  = 1;
+    config.overflowPolicy = EventBus::OverflowPolicy::Block;
+    auto bus              = std::make_unique<EventBus>(config);
+
+    std::atomic<int> count{0};
+    bus->subscribeAsync<TestEvent>([&](const TestEvent& event)
+    {
+        ++count;
+        if (event.getValue() == 0)
+        {
+            // 处理器中连续入队超过容量，不应阻塞工作线程
+            bus->enqueue(std::make_shared<TestEvent>(1));
+            bus->enqueue(std::make_shared<TestEvent>(2));
+        }
+    });
+
+    bus->enqueue(std::make_shared<TestEvent>(0));
+    EXPECT_TRUE(waitUntil([&] { return count.load() == 3; }));
+    bus.reset();
+}
+
+// ======================================
+// 耗时统计测试
+
+TEST_F(EventBusTest, MetricsDisabledByDefault)
+{
+    eventBus->subscribe<TestEvent>([](const TestEvent&) {});
+    eventBus->dispatch(std::make_shared<TestEvent>(1));
+
+    EXPECT_FALSE(eventBus->isMetricsEnabled());
+
+    auto snapshot = eventBus->getMetricsSnapshot();
+    EXPECT_TRUE(snapshot.types.empty());
+    EXPECT_TRUE(snapshot.listeners.empty());
+}
+
+TEST_F(EventBusTest, MetricsPerTypeAndListener)
+{
+    EventBus::Config config;
+    config.queueWorkers  = 0;
+    config.enableMetrics = true;
+    eventBus             = std::make_unique<EventBus>(config);
+
+    auto slow = eventBus->subscribe<TestEvent>([](const TestEvent&)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    });
+    auto fast   = eventBus->subscribe<TestEvent>([](const TestEvent&) {});
+    auto queued = eventBus->subscribeAsync<TestEvent>([](const TestEvent&) {});
+
+    for (int i = 0; i < 5; ++i)
+        eventBus->dispatch(std::make_shared<TestEvent>(i));
+    for (int i = 0; i < 3; ++i)
+        eventBus->enqueue(std::make_shared<TestEvent>(i));
+    eventBus->processQueue();
+
+    auto snapshot = eventBus->getMetricsSnapshot();
+    ASSERT_EQ(snapshot.types.size(), 1);
+
+    const auto& type = snapshot.types[0];
+    EXPECT_EQ(type.typeIndex, EventTypeIndexOf<TestEvent>());
+    EXPECT_FALSE(type.typeName.empty());
+    EXPECT_EQ(type.dispatchCount, 5);
+    EXPECT_EQ(type.queuedCount, 3);
+    EXPECT_EQ(type.queueWait.count, 3);
+    EXPECT_EQ(type.handlerTime.count, 8);
+    EXPECT_GE(type.handlerTime.maxNs, 1'000'000);
+
+    ASSERT_EQ(snapshot.listeners.size(), 3);
+    auto findListener = [&](Handle handle) -> const ListenerMetrics&
+    {
+        return *std::ranges::find(snapshot.listeners, handle, &ListenerMetrics::handle);
+    };
+    EXPECT_EQ(findListener(slow).executionTime.count, 5);
+    EXPECT_GE(findListener(slow).executionTime.percentileNs(0.5), 500'000);
+    EXPECT_EQ(findListener(fast).executionTime.count, 5);
+    EXPECT_EQ(findListener(queued).executionTime.count, 3);
+    EXPECT_LT(findListener(fast).executionTime.maxNs, findListener(slow).executionTime.maxNs);
+
+    EXPECT_FALSE(snapshot.toString().empty());
+
+    eventBus->resetMetrics();
+    EXPECT_TRUE(eventBus->getMetricsSnapshot().types.empty());
+}
+
+TEST_F(EventBusTest, MetricsAcrossThreads)
+{
+    eventBus->setMetricsEnabled(true);
+    eventBus->subscribe<TestEvent>([](const TestEvent&) {});
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([this]
+        {
+            for (int i = 0; i < 100; ++i)
+                eventBus->dispatch(std::make_shared<TestEvent>(i));
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    auto snapshot = eventBus->getMetricsSnapshot();
+    ASSERT_EQ(snapshot.types.size(), 1);
+    EXPECT_EQ(snapshot.types[0].dispatchCount, 400);
+    ASSERT_EQ(snapshot.listeners.size(), 1);
+    EXPECT_EQ(snapshot.listeners[0].executionTime.count, 400);
+}
+
+TEST_F(EventBusTest, MetricsKeptWhenThreadsExitOrRotateBuses)
+{
+    // 多于线程本地缓存容量的总线轮流使用，缓存被挤出后仍找回同一个缓冲区
+    std::vector<std::unique_ptr<EventBus>> buses;
+    for (int i = 0; i < 12; ++i)
+    {
+        auto& bus = buses.emplace_back(std::make_unique<EventBus>());
+        bus->setMetricsEnabled(true);
+        bus->subscribe<TestEvent>([](const TestEvent&) {});
+    }
+    for (int round = 0; round < 3; ++round)
+    {
+        for (auto& bus : buses)
+        {
+            bus->dispatch(std::make_shared<TestEvent>(round));
+            bus->postToFrame(std::make_shared<TestEvent>(round));
+        }
+    }
+
+    // 短生命周期线程退出后归还缓冲区，数据由后来的线程继续累加
+    for (int t = 0; t < 16; ++t)
+    {
+        std::thread([&] { buses.front()->dispatch(std::make_shared<TestEvent>(t)); }).join();
+    }
+
+    for (auto& bus : buses)
+    {
+        const auto expected = bus == buses.front() ? 19u : 3u;
+        auto snapshot       = bus->getMetricsSnapshot();
+        ASSERT_EQ(snapshot.types.size(), 1);
+        EXPECT_EQ(snapshot.types[0].dispatchCount, expected);
+
+        bus->swapFrameBuffers();
+        EXPECT_EQ(bus->getFrameEvents().size(), 3u);
+    }
+}
+
+TEST_F(EventBusTest, MetricsPeriodicDump)
+{
+    std::atomic<int> dumps{0};
+    std::atomic<u64> lastCount{0};
+
+    EventBus::Config config;
+    config.queueWorkers        = 0;
+    config.enableMetrics       = true;
+    config.metricsDumpInterval = std::chrono::milliseconds(5);
+    config.metricsDumpCallback = [&](const EventMetricsSnapshot& snapshot)
+    {
+        if (!snapshot.types.empty())
+            lastCount = snapshot.types[0].dispatchCount;
+        ++dumps;
+    };
+    eventBus = std::make_unique<EventBus>(config);
+
+    eventBus->subscribe<TestEvent>([](const TestEvent&) {});
+    eventBus->dispatch(std::make_shared<TestEvent>(1));
+
+    const auto deadline = Clock::now() + std::chrono::seconds(5);
+    while ((dumps.load() < 2 || lastCount.load() != 1) && Clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    EXPECT_GE(dumps.load(), 2);
+    EXPECT_EQ(lastCount.load(), 1);
+    eventBus.reset();
+}
+
+TEST(LatencyHistogramTest, BucketsAndPercentiles)
+{
+    LatencyHistogram histogram;
+    for (int i = 0; i < 99; ++i)
+        histogram.record(100);
+    histogram.record(1'000'000);
+
+    EXPECT_EQ(histogram.count, 100);
+    EXPECT_EQ(histogram.maxNs, 1'000'000);
+    EXPECT_DOUBLE_EQ(histogram.meanNs(), (99.0 * 100 + 1'000'000) / 100);
+
+    // 100ns 落在 [64, 128) 桶中
+    EXPECT_EQ(histogram.buckets[7], 99);
+    EXPECT_EQ(histogram.percentileNs(0.5), 127);
+    EXPECT_EQ(histogram.percentileNs(1.0), 1'000'000);
+
+    LatencyHistogram other;
+    other.record(0);
+    histogram.merge(other);
+    EXPECT_EQ(histogram.count, 101);
+    EXPECT_EQ(histogram.buckets[0], 1);
+}
+
+// ======================================
+
+namespace {
+EventTask AwaitValues(const EventBus& bus, std::vector<int>& received, int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        auto event = co_await bus.next<TestEvent>();
+        received.push_back(event->getValue());
+    }
+}
+
+EventTask AwaitMatching(const EventBus& bus, int value, ICoroutineExecutor* executor, std::atomic<int>& resumed)
+{
+    auto event = co_await bus.next<TestEvent>([value](const TestEvent& e) { return e.getValue() == value; }, executor);
+    if (event && event->getValue() == value)
+        resumed.fetch_add(1);
+}
+
+EventTask AwaitSequence(const EventBus& bus, std::vector<std::string>& steps)
+{
+    auto message = co_await bus.next<HighPriorityEvent>();
+    steps.push_back(message->getMessage());
+
+    auto value = co_await bus.next<TestEvent>([](const TestEvent& e) { return e.getValue() > 10; });
+    steps.push_back(std::to_string(value->getValue()));
+}
+
+// 恢复后再次处理队列、修改观察者，需要总线已释放处理锁并离开纪元临界区
+EventTask AwaitThenReenter(EventBus& bus, std::vector<int>& received)
+{
+    auto event = co_await bus.next<TestEvent>();
+    received.push_back(event->getValue());
+    bus.processQueue();
+    bus.setObserver(nullptr);
+}
+
+EventTask AwaitUntilShutdown(const EventBus& bus, bool& resumedWithNull)
+{
+    auto event      = co_await bus.next<TestEvent>();
+    resumedWithNull = event == nullptr;
+}
+} // namespace
+
+TEST_F(EventBusTest, CoroutineResumesOnDispatch)
+{
+    std::vector<int> received;
+    AwaitValues(*eventBus, received, 2);
+    EXPECT_TRUE(received.empty());
+
+    eventBus->dispatch(std::make_shared<TestEvent>(1));
+    eventBus->dispatch(std::make_shared<HighPriorityEvent>("ignored"));
+    eventBus->dispatch(std::make_shared<TestEvent>(2));
+    eventBus->dispatch(std::make_shared<TestEvent>(3));
+
+    // 协程结束后不再留在等待表中
+    EXPECT_EQ(received, (std::vector<int>{1, 2}));
+}
+
+TEST_F(EventBusTest, CoroutineSequentialFilteredWaits)
+{
+    std::vector<std::string> steps;
+    AwaitSequence(*eventBus, steps);
+
+    eventBus->dispatch(std::make_shared<TestEvent>(50));
+    eventBus->dispatch(std::make_shared<HighPriorityEvent>("start"));
+    eventBus->dispatch(std::make_shared<TestEvent>(5));
+    eventBus->dispatch(std::make_shared<TestEvent>(42));
+
+    EXPECT_EQ(steps, (std::vector<std::string>{"start", "42"}));
+}
+
+TEST_F(EventBusTest, CoroutineCancelledEventDoesNotResume)
+{
+    std::vector<int> received;
+    AwaitValues(*eventBus, received, 1);
+
+    eventBus->subscribe<TestEvent>([](const TestEvent& event)
+    {
+        if (event.getValue() < 0)
+            const_cast<TestEvent&>(event).cancel();
+    });
+
+    eventBus->dispatch(std::make_shared<TestEvent>(-1));
+    EXPECT_TRUE(received.empty());
+    eventBus->dispatch(std::make_shared<TestEvent>(7));
+    EXPECT_EQ(received, (std::vector<int>{7}));
+}
+
+TEST_F(EventBusTest, CoroutineResumesOnExecutor)
+{
+    ManualExecutor executor;
+    std::atomic<int> resumed{0};
+    AwaitMatching(*eventBus, 3, &executor, resumed);
+
+    eventBus->dispatch(std::make_shared<TestEvent>(3));
+    EXPECT_EQ(resumed.load(), 0);
+    EXPECT_EQ(executor.pendingCount(), 1u);
+
+    EXPECT_EQ(executor.runPending(), 1u);
+    EXPECT_EQ(resumed.load(), 1);
+}
+
+TEST_F(EventBusTest, CoroutineResumedWithNullOnShutdown)
+{
+    bool resumedWithNull = false;
+    AwaitUntilShutdown(*eventBus, resumedWithNull);
+    eventBus.reset();
+    EXPECT_TRUE(resumedWithNull);
+}
+
+TEST_F(EventBusPoolTest, CoroutineResumesWhenQueuedEventIsProcessed)
+{
+    EventBus bus(EventBus::Config{.queueWorkers = 0});
+    std::vector<int> received;
+    AwaitValues(bus, received, 1);
+
+    bus.enqueue(std::make_shared<TestEvent>(9));
+    EXPECT_TRUE(received.empty());
+
+    bus.processQueue();
+    EXPECT_EQ(received, (std::vector<int>{9}));
+}
+
+TEST_F(EventBusPoolTest, CoroutineResumesOutsideBusLocks)
+{
+    struct NullObserver : IEventObserver
+    {
+        void onDispatch(const EventPtr&) override {}
+        void onEnqueue(const EventPtr&, EventPriority, std::optional<u64>) override {}
+    } observer;
+
+    EventBus bus(EventBus::Config{.queueWorkers = 0});
+    std::vector<int> received;
+    bus.subscribeAsync<TestEvent>([&](const TestEvent& event) { received.push_back(event.getValue() * 10); });
+
+    // 队列路径：协程在处理过程中恢复，并继续处理剩余事件
+    bus.setObserver(&observer);
+    AwaitThenReenter(bus, received);
+    bus.enqueue(std::make_shared<TestEvent>(1));
+    bus.enqueue(std::make_shared<TestEvent>(2));
+    bus.processQueue();
+    EXPECT_EQ(received, (std::vector<int>{10, 1, 20}));
+    EXPECT_EQ(bus.getObserver(), nullptr);
+
+    // 同步分发路径
+    received.clear();
+    bus.setObserver(&observer);
+    AwaitThenReenter(bus, received);
+    bus.enqueue(std::make_shared<TestEvent>(3));
+    bus.dispatch(std::make_shared<TestEvent>(4));
+    EXPECT_EQ(received, (std::vector<int>{4, 30}));
+    EXPECT_EQ(bus.getObserver(), nullptr);
+}
+
+TEST_F(EventBusPoolTest, CoroutinesAcrossWorkers)
+{
+    constexpr int kWaiters = 200;
+    std::atomic<int> resumed{0};
+    for (int i = 0; i < kWaiters; ++i)
+        AwaitMatching(*eventBus, i, nullptr, resumed);
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 4; ++t)
+    {
+        producers.emplace_back([&, t]
+        {
+            for (int i = t; i < kWaiters; i += 4)
+                eventBus->enqueue(std::make_shared<TestEvent>(i), EventPriority::Normal, As<u64>(i));
+        });
+    }
+    for (auto& producer : producers)
+        producer.join();
+
+    EXPECT_TRUE(waitUntil([&] { return resumed.load() == kWaiters; }));
+}
+
+TEST(CoroutineFramePoolTest, ReusesFramesOfSameSizeClass)
+{
+    void* first = AllocateCoroutineFrame(100);
+    FreeCoroutineFrame(first, 100);
+
+    // 同一分级（65~128 字节）的帧复用缓存
+    void* second = AllocateCoroutineFrame(120);
+    EXPECT_EQ(first, second);
+    FreeCoroutineFrame(second, 120);
+
+    void* large = AllocateCoroutineFrame(kMaxPooledFrameSize + 1);
+    EXPECT_NE(large, nullptr);
+    FreeCoroutineFrame(large, kMaxPooledFrameSize + 1);
+}
+
+// ======================================
+
+TEST_F(EventBusTest, FrameEventsVisibleAfterSwap)
+{
+    eventBus->postToFrame(std::make_shared<TestEvent>(1));
+    eventBus->postToFrame(std::make_shared<HighPriorityEvent>("a"));
+    eventBus->postToFrame(std::make_shared<TestEvent>(2));
+
+    auto cancelled = std::make_shared<TestEvent>(3);
+    eventBus->postToFrame(cancelled);
+    cancelled->cancel();
+
+    EXPECT_TRUE(eventBus->getFrameEvents().empty());
+
+    eventBus->swapFrameBuffers();
+    const auto& frame = eventBus->getFrameEvents();
+    EXPECT_EQ(frame.frameIndex(), 1u);
+    EXPECT_EQ(frame.size(), 3u);
+
+    // 同类型事件连续存放并保持投递顺序
+    std::vector<int> values;
+    frame.forEach<TestEvent>([&](const TestEvent& event) { values.push_back(event.getValue()); });
+    EXPECT_EQ(values, (std::vector<int>{1, 2}));
+    ASSERT_EQ(frame.ofType<HighPriorityEvent>().size(), 1u);
+    EXPECT_TRUE(frame.ofType<TimedEvent>().empty());
+
+    // 交换后投递的事件属于下一帧
+    eventBus->postToFrame(std::make_shared<HighPriorityEvent>("b"));
+    EXPECT_EQ(frame.size(), 3u);
+
+    eventBus->swapFrameBuffers();
+    EXPECT_EQ(frame.frameIndex(), 2u);
+    EXPECT_TRUE(frame.ofType<TestEvent>().empty());
+    ASSERT_EQ(frame.ofType<HighPriorityEvent>().size(), 1u);
+
+    eventBus->swapFrameBuffers();
+    EXPECT_TRUE(frame.empty());
+}
+
+TEST_F(EventBusTest, FrameEventsFromManyThreads)
+{
+    constexpr int kThreads   = 4;
+    constexpr int kPerThread = 1000;
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; ++t)
+    {
+        producers.emplace_back([&, t]
+        {
+            for (int i = 0; i < kPerThread; ++i)
+            {
+                if (i % 2 == 0)
+                    eventBus->postToFrame(std::make_shared<TestEvent>(t * kPerThread + i));
+                else
+                    eventBus->postToFrame(std::make_shared<HighPriorityEvent>(std::to_string(t)));
+            }
+        });
+    }
+
+    // 生产者运行期间交换，事件不会丢失也不会重复
+    Size total     = 0;
+    Size testCount = 0;
+    auto consume   = [&]
+    {
+        eventBus->swapFrameBuffers();
+        const auto& frame = eventBus->getFrameEvents();
+        total += frame.size();
+        testCount += frame.ofType<TestEvent>().size();
+        EXPECT_EQ(frame.ofType<TestEvent>().size() + frame.ofType<HighPriorityEvent>().size(), frame.size());
+    };
+    for (int i = 0; i < 10; ++i)
+        consume();
+    for (auto& producer : producers)
+        producer.join();
+    consume();
+
+    EXPECT_EQ(total, As<Size>(kThreads * kPerThread));
+    EXPECT_EQ(testCount, As<Size>(kThreads * kPerThread / 2));
+}
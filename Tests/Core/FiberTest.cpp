@@ -0,0 +1,258 @@
+/**
+ * @File FiberTest.cpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/9/30
+ * @Brief 纤程与纤程栈池的单元测试
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <cstring>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "Core/Threading/Fiber.hpp"
+#include "Core/Threading/JobSystem.hpp"
+
+using namespace xihe;
+
+namespace {
+struct PingPong
+{
+    Fiber* main  = nullptr;
+    Fiber* child = nullptr;
+    std::vector<int> trace;
+};
+
+void PingPongEntry(void* arg)
+{
+    auto& state = *static_cast<PingPong*>(arg);
+    for (int i = 0;; ++i)
+    {
+        state.trace.push_back(i * 2 + 1);
+        state.child->switchTo(*state.main);
+    }
+}
+} // namespace
+
+TEST(FiberStackPoolTest, ReusesReleasedStacks)
+{
+    FiberStackPool pool(10'000);
+
+    // 按页向上取整
+    EXPECT_EQ(pool.getStackSize() % FiberStackPool::PageSize(), 0u);
+    EXPECT_GE(pool.getStackSize(), 10'000u);
+
+    auto first = pool.acquire();
+    ASSERT_TRUE(first);
+    std::memset(first.base, 0xCD, first.size); // 整个可用区间可写
+
+    auto second = pool.acquire();
+    EXPECT_NE(first.base, second.base);
+
+    pool.release(first);
+    EXPECT_EQ(pool.getCachedCount(), 1u);
+    EXPECT_EQ(pool.acquire().base, first.base);
+
+    pool.release(first);
+    pool.release(second);
+    EXPECT_EQ(pool.getCachedCount(), 2u);
+}
+
+#ifdef XIHE_ON_LINUX
+TEST(FiberStackPoolDeathTest, GuardPageCatchesOverflow)
+{
+    FiberStackPool pool;
+    auto stack = pool.acquire();
+    EXPECT_DEATH({ *(static_cast<volatile std::byte*>(stack.base) - 1) = std::byte{1}; }, "");
+    pool.release(stack);
+}
+#endif
+
+TEST(FiberTest, SwitchesBackAndForth)
+{
+    if (!Fiber::IsSupported())
+        GTEST_SKIP() << "当前平台不支持纤程";
+
+    FiberStackPool pool;
+    PingPong state;
+    Fiber main;
+    Fiber child(pool.acquire(), &PingPongEntry, &state);
+    state.main  = &main;
+    state.child = &child;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        state.trace.push_back(i * 2);
+        main.switchTo(child);
+    }
+    EXPECT_EQ(state.trace, (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7}));
+
+    pool.release(child.getStack());
+}
+
+TEST(FiberTest, KeepsFloatingPointStateAcrossSwitches)
+{
+    if (!Fiber::IsSupported())
+        GTEST_SKIP() << "当前平台不支持纤程";
+
+    struct State
+    {
+        Fiber* main  = nullptr;
+        Fiber* child = nullptr;
+        double sum   = 0.0;
+    } state;
+
+    FiberStackPool pool;
+    Fiber main;
+    Fiber child(pool.acquire(), [](void* arg)
+    {
+        auto& s = *static_cast<State*>(arg);
+        for (double x = 0.5;; x *= 2.0)
+        {
+            s.sum += x;
+            s.child->switchTo(*s.main);
+        }
+    }, &state);
+    state.main  = &main;
+    state.child = &child;
+
+    double local = 1.25;
+    for (int i = 0; i < 3; ++i)
+    {
+        main.switchTo(child);
+        local *= 2.0;
+    }
+    EXPECT_DOUBLE_EQ(state.sum, 0.5 + 1.0 + 2.0);
+    EXPECT_DOUBLE_EQ(local, 10.0);
+
+    pool.release(child.getStack());
+}
+
+TEST(JobFiberTest, WaitInsideJobSuspendsFiber)
+{
+    JobSystem jobs(JobSystem::Config{.workerCount = 1, .useFibers = true});
+    if (!jobs.isUsingFibers())
+        GTEST_SKIP() << "当前平台不支持纤程";
+
+    // 唯一的工作线程上，外层任务等待的子任务由外部线程稍后提交；
+    // 外层任务挂起期间工作线程继续执行其他任务，之后在同一线程恢复
+    JobCounter outer;
+    JobCounter inner;
+    std::atomic<bool> otherRan{false};
+    std::atomic<bool> resumed{false};
+    std::thread::id before;
+    std::thread::id after;
+
+    std::thread submitter([&]
+    {
+        jobs.run([&]
+        {
+            before = std::this_thread::get_id();
+            jobs.run([] {}, &inner);
+            jobs.wait(inner);
+            after = std::this_thread::get_id();
+            resumed = true;
+        }, &outer);
+        jobs.run([&] { otherRan = true; }, &outer);
+    });
+    submitter.join();
+
+    jobs.wait(outer);
+    EXPECT_TRUE(otherRan.load());
+    EXPECT_TRUE(resumed.load());
+    EXPECT_EQ(before, after);
+}
+
+TEST(JobFiberTest, ManyJobsWaitingConcurrently)
+{
+    JobSystem jobs(JobSystem::Config{.workerCount = 2, .useFibers = true, .fiberStackSize = 32 * 1024});
+
+    // 每个任务等待下一个任务完成，形成长链；使用纤程时不会在同一个栈上层层嵌套
+    constexpr int kDepth = 200;
+    std::atomic<int> finished{0};
+    std::vector<JobCounter> counters(kDepth);
+
+    struct Chain
+    {
+        static void Run(JobSystem& jobs, std::vector<JobCounter>& counters, std::atomic<int>& finished, int index)
+        {
+            if (index + 1 < static_cast<int>(counters.size()))
+            {
+                jobs.run([&jobs, &counters, &finished, index] { Run(jobs, counters, finished, index + 1); },
+                         &counters[index + 1]);
+                jobs.wait(counters[index + 1]);
+            }
+            finished.fetch_add(1);
+        }
+    };
+
+    jobs.run([&] { Chain::Run(jobs, counters, finished, 0); }, &counters[0]);
+    jobs.wait(counters[0]);
+    EXPECT_EQ(finished.load(), kDepth);
+}
+
+TEST(JobFiberTest, WorkerSleepsWhileFiberParked)
+{
+    JobSystem jobs(JobSystem::Config{.workerCount = 1, .useFibers = true});
+    if (!jobs.isUsingFibers())
+        GTEST_SKIP() << "当前平台不支持纤程";
+
+    // 外层任务在工作线程上等待由创建者线程执行的子任务；
+    // 挂起期间工作线程应当睡眠而不是空转，子任务完成时被唤醒并恢复纤程
+    JobCounter outer;
+    JobCounter inner;
+    std::atomic<bool> outerStarted{false};
+    std::atomic<bool> innerRunning{false};
+    std::atomic<bool> resumed{false};
+    std::clock_t cpu = 0;
+
+    jobs.run([&]
+    {
+        outerStarted = true;
+        while (!innerRunning.load())
+            std::this_thread::yield();
+        jobs.wait(inner);
+        resumed = true;
+    }, &outer);
+    while (!outerStarted.load())
+        std::this_thread::yield();
+
+    jobs.run([&]
+    {
+        innerRunning = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        const std::clock_t start = std::clock();
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        cpu = std::clock() - start;
+    }, &inner);
+    ASSERT_TRUE(jobs.runOne());
+
+    jobs.wait(outer);
+    EXPECT_TRUE(resumed.load());
+    EXPECT_LT(cpu, CLOCKS_PER_SEC / 10);
+}
+
+TEST(JobFiberTest, FibersCanBeDisabled)
+{
+    JobSystem jobs(JobSystem::Config{.workerCount = 2, .useFibers = false});
+    EXPECT_FALSE(jobs.isUsingFibers());
+
+    std::atomic<int> count{0};
+    JobCounter counter;
+    for (int i = 0; i < 16; ++i)
+    {
+        jobs.run([&]
+        {
+            JobCounter child;
+            jobs.run([&] { count.fetch_add(1); }, &child);
+            jobs.wait(child);
+        }, &counter);
+    }
+    jobs.wait(counter);
+    EXPECT_EQ(count.load(), 16);
+}
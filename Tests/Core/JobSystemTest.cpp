@@ -0,0 +1,226 @@
+/**
+ * @File JobSystemTest.cpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/9/27
+ * @Brief 工作窃取任务系统的单元测试
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "Core/Threading/Internal.hpp"
+#include "Core/Threading/JobSystem.hpp"
+#include "Core/Threading/WorkStealingDeque.hpp"
+#include "Core/Utils/Logger.hpp"
+
+using namespace xihe;
+
+TEST(WorkStealingDequeTest, OwnerIsLifoThiefIsFifo)
+{
+    WorkStealingDeque<int*> deque(2);
+    int values[4] = {0, 1, 2, 3};
+    for (auto& value : values)
+        deque.push(&value);
+
+    // 超出初始容量后自动扩容
+    EXPECT_GE(deque.capacity(), 4u);
+    EXPECT_EQ(deque.size(), 4u);
+
+    EXPECT_EQ(deque.steal(), &values[0]);
+    EXPECT_EQ(deque.pop(), &values[3]);
+    EXPECT_EQ(deque.pop(), &values[2]);
+    EXPECT_EQ(deque.steal(), &values[1]);
+    EXPECT_EQ(deque.pop(), nullptr);
+    EXPECT_EQ(deque.steal(), nullptr);
+    EXPECT_TRUE(deque.empty());
+}
+
+TEST(WorkStealingDequeTest, ConcurrentStealTakesEachItemOnce)
+{
+    constexpr int kItems   = 20000;
+    constexpr int kThieves = 3;
+
+    WorkStealingDeque<int*> deque(64);
+    std::vector<int> items(kItems);
+    std::vector<std::atomic<int>> taken(kItems);
+    std::atomic<bool> done{false};
+
+    auto take = [&](int* item)
+    {
+        taken[item - items.data()].fetch_add(1);
+    };
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < kThieves; ++t)
+    {
+        thieves.emplace_back([&]
+        {
+            while (!done.load())
+            {
+                if (auto* item = deque.steal())
+                    take(item);
+            }
+            while (auto* item = deque.steal())
+                take(item);
+        });
+    }
+
+    // 所有者交替压入与弹出，与窃取者竞争最后一个元素
+    for (int i = 0; i < kItems; ++i)
+    {
+        deque.push(&items[i]);
+        if (i % 3 == 0)
+        {
+            if (auto* item = deque.pop())
+                take(item);
+        }
+    }
+    while (auto* item = deque.pop())
+        take(item);
+
+    done = true;
+    for (auto& thief : thieves)
+        thief.join();
+
+    for (int i = 0; i < kItems; ++i)
+        EXPECT_EQ(taken[i].load(), 1) << i;
+}
+
+TEST(JobSystemTest, RunsAllJobsAndWaits)
+{
+    JobSystem jobs(JobSystem::Config{.workerCount = 3});
+    EXPECT_EQ(jobs.getWorkerCount(), 3u);
+    EXPECT_TRUE(jobs.isOwnThread());
+
+    std::atomic<int> sum{0};
+    JobCounter counter;
+    for (int i = 1; i <= 1000; ++i)
+        jobs.run([&sum, i] { sum.fetch_add(i); }, &counter);
+
+    jobs.wait(counter);
+    EXPECT_TRUE(counter.isDone());
+    EXPECT_EQ(sum.load(), 500500);
+}
+
+TEST(JobSystemTest, DefaultSizeLeavesOneCoreForOwner)
+{
+    JobSystem jobs;
+    EXPECT_EQ(jobs.getWorkerCount(), HardwareConcurrency() - 1);
+}
+
+TEST(JobSystemTest, OwnerExecutesJobsWithoutWorkers)
+{
+    JobSystem jobs(JobSystem::Config{.workerCount = 0, .queueCapacity = 4});
+    std::vector<int> order;
+
+    JobCounter counter;
+    for (int i = 0; i < 16; ++i)
+        jobs.run([&order, i] { order.push_back(i); }, &counter);
+
+    // 没有工作线程时任务只在等待中由当前线程执行，自己的队列后进先出
+    EXPECT_EQ(jobs.getWorkerCount(), 0u);
+    EXPECT_TRUE(order.empty());
+
+    jobs.wait(counter);
+    ASSERT_EQ(order.size(), 16u);
+    EXPECT_EQ(order.front(), 15);
+    EXPECT_EQ(order.back(), 0);
+}
+
+TEST(JobSystemTest, NestedJobsAndWaitInsideJob)
+{
+    JobSystem jobs(JobSystem::Config{.workerCount = 4});
+
+    // 任务内提交子任务并等待，等待的工作线程继续执行其他任务而不会死锁
+    std::atomic<int> leaves{0};
+    JobCounter root;
+    for (int i = 0; i < 8; ++i)
+    {
+        jobs.run([&]
+        {
+            JobCounter children;
+            for (int j = 0; j < 64; ++j)
+                jobs.run([&] { leaves.fetch_add(1); }, &children);
+            jobs.wait(children);
+        }, &root);
+    }
+
+    jobs.wait(root);
+    EXPECT_EQ(leaves.load(), 8 * 64);
+}
+
+TEST(JobSystemTest, SubmitFromForeignThreads)
+{
+    JobSystem jobs(JobSystem::Config{.workerCount = 2});
+
+    std::atomic<int> count{0};
+    JobCounter counter;
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 4; ++t)
+    {
+        producers.emplace_back([&]
+        {
+            EXPECT_FALSE(jobs.isOwnThread());
+            for (int i = 0; i < 250; ++i)
+                jobs.run([&] { count.fetch_add(1); }, &counter);
+        });
+    }
+    for (auto& producer : producers)
+        producer.join();
+
+    jobs.wait(counter);
+    EXPECT_EQ(count.load(), 1000);
+}
+
+TEST(JobSystemTest, JobsSpreadAcrossWorkers)
+{
+    JobSystem jobs(JobSystem::Config{.workerCount = 3});
+
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    JobCounter counter;
+    for (int i = 0; i < 64; ++i)
+    {
+        jobs.run([&]
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            std::lock_guard lock(mutex);
+            threads.insert(std::this_thread::get_id());
+        }, &counter);
+    }
+    jobs.wait(counter);
+
+    // 包括等待中的当前线程在内，至少有两个线程执行过任务
+    EXPECT_GE(threads.size(), 2u);
+}
+
+TEST(JobSystemTest, ExceptionDoesNotBreakCounter)
+{
+    // 异常被记录到日志
+    Logger::GetInstance().startup();
+    JobSystem jobs(JobSystem::Config{.workerCount = 1});
+
+    JobCounter counter;
+    jobs.run([] { throw std::runtime_error("job failed"); }, &counter);
+    jobs.run([] {}, &counter);
+    jobs.wait(counter);
+    EXPECT_TRUE(counter.isDone());
+    Logger::GetInstance().shutdown();
+}
+
+TEST(JobSystemTest, DestructorFinishesPendingJobs)
+{
+    std::atomic<int> count{0};
+    {
+        JobSystem jobs(JobSystem::Config{.workerCount = 2});
+        for (int i = 0; i < 500; ++i)
+            jobs.run([&] { count.fetch_add(1); });
+    }
+    EXPECT_EQ(count.load(), 500);
+}
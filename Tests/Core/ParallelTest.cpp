@@ -0,0 +1,150 @@
+/**
+ * @File ParallelTest.cpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/9/29
+ * @Brief 数据并行原语的单元测试
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "Core/Threading/Parallel.hpp"
+
+using namespace xihe;
+
+namespace {
+std::vector<f32> RandomFloats(Size count, u32 seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<f32> dist(-1000.0f, 1000.0f);
+    std::vector<f32> values(count);
+    for (auto& value : values)
+        value = dist(rng);
+    return values;
+}
+
+f32 ParallelSum(JobSystem& jobs, const std::vector<f32>& values)
+{
+    return ParallelReduce(jobs, 0, values.size(), 0.0f,
+                          [&](Size first, Size last, f32 sum)
+                          {
+                              for (Size i = first; i < last; ++i)
+                                  sum += values[i];
+                              return sum;
+                          },
+                          std::plus<>{});
+}
+} // namespace
+
+TEST(ParallelTest, ForVisitsEveryIndexOnce)
+{
+    JobSystem jobs(JobSystem::Config{.workerCount = 3});
+
+    constexpr Size kCount = 100'003;
+    std::vector<std::atomic<int>> visits(kCount);
+    ParallelFor(jobs, 0, kCount, [&](Size i) { visits[i].fetch_add(1, std::memory_order_relaxed); });
+    EXPECT_TRUE(std::ranges::all_of(visits, [](const auto& v) { return v.load() == 1; }));
+
+    // 空区间与小于粒度的区间
+    ParallelFor(jobs, 5, 5, [](Size) { FAIL(); });
+    std::atomic<Size> ranged{0};
+    ParallelForRange(jobs, 10, 17, [&](Size first, Size last) { ranged.fetch_add(last - first); }, 64);
+    EXPECT_EQ(ranged.load(), 7u);
+}
+
+TEST(ParallelTest, ReduceIsDeterministicAcrossWorkerCounts)
+{
+    const auto values = RandomFloats(1'000'000, 7);
+
+    // 浮点加法不满足结合律，分块固定时结果逐位相同
+    JobSystem serial(JobSystem::Config{.workerCount = 0});
+    const f32 expected = ParallelSum(serial, values);
+    for (Size workers : {1u, 3u, 7u})
+    {
+        JobSystem jobs(JobSystem::Config{.workerCount = workers});
+        for (int round = 0; round < 5; ++round)
+            EXPECT_EQ(ParallelSum(jobs, values), expected);
+    }
+
+    // 整数结果与串行一致
+    JobSystem jobs(JobSystem::Config{.workerCount = 3});
+    const u64 total = ParallelReduce(jobs, 0, 100'000, u64{0},
+                                     [](Size first, Size last, u64 sum)
+                                     {
+                                         for (Size i = first; i < last; ++i)
+                                             sum += i;
+                                         return sum;
+                                     },
+                                     std::plus<>{});
+    EXPECT_EQ(total, 99'999ull * 100'000 / 2);
+}
+
+TEST(ParallelTest, ScanMatchesInclusiveScan)
+{
+    JobSystem jobs(JobSystem::Config{.workerCount = 3});
+
+    std::vector<u64> input(50'001);
+    std::iota(input.begin(), input.end(), 1);
+
+    std::vector<u64> expected(input.size());
+    std::inclusive_scan(input.begin(), input.end(), expected.begin());
+
+    std::vector<u64> output(input.size());
+    ParallelScan<u64>(jobs, input, output);
+    EXPECT_EQ(output, expected);
+
+    // 原地扫描，且不同粒度结果相同
+    ParallelScan<u64>(jobs, input, input, std::plus<>{}, 17);
+    EXPECT_EQ(input, expected);
+
+    // 浮点扫描的结果与线程数无关
+    const auto floats = RandomFloats(200'000, 11);
+    std::vector<f32> serialOut(floats.size());
+    std::vector<f32> parallelOut(floats.size());
+    JobSystem serial(JobSystem::Config{.workerCount = 0});
+    ParallelScan<f32>(serial, floats, serialOut);
+    ParallelScan<f32>(jobs, floats, parallelOut);
+    EXPECT_EQ(serialOut, parallelOut);
+}
+
+TEST(ParallelTest, SortMatchesStdSort)
+{
+    JobSystem jobs(JobSystem::Config{.workerCount = 3});
+
+    std::mt19937 rng(3);
+    std::vector<int> values(300'000);
+    for (auto& value : values)
+        value = static_cast<int>(rng() % 1000); // 大量重复元素
+
+    auto expected = values;
+    std::ranges::sort(expected);
+    ParallelSort(jobs, values.begin(), values.end());
+    EXPECT_EQ(values, expected);
+
+    // 自定义比较与已排序输入
+    ParallelSort(jobs, values.begin(), values.end(), std::greater<>{});
+    EXPECT_TRUE(std::ranges::is_sorted(values, std::greater<>{}));
+    ParallelSort(jobs, values.begin(), values.end(), std::greater<>{}, 64);
+    EXPECT_TRUE(std::ranges::is_sorted(values, std::greater<>{}));
+}
+
+TEST(ParallelTest, CallerExceptionWaitsForChildren)
+{
+    JobSystem jobs(JobSystem::Config{.workerCount = 2});
+
+    std::atomic<int> visited{0};
+    EXPECT_THROW(ParallelFor(jobs, 0, 10'000, [&](Size i)
+    {
+        if (i == 0)
+            throw std::runtime_error("first chunk failed");
+        visited.fetch_add(1);
+    }, 100), std::runtime_error);
+
+    // 异常抛出时已拆出的子任务执行完毕，不会访问已销毁的栈对象
+    EXPECT_GT(visited.load(), 0);
+}
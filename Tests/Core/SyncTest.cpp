@@ -0,0 +1,174 @@
+/**
+ * @File SyncTest.cpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/10/3
+ * @Brief 同步原语的单元测试
+ */
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Core/Base/Concepts.hpp"
+#include "Core/Threading/Sync.hpp"
+
+using namespace xihe;
+
+template <typename Lock>
+class LockTest : public ::testing::Test
+{
+};
+
+using LockTypes = ::testing::Types<SpinLock, TicketLock, AdaptiveMutex>;
+TYPED_TEST_SUITE(LockTest, LockTypes);
+
+TYPED_TEST(LockTest, TryLockFailsWhileHeld)
+{
+    TypeParam lock;
+    ASSERT_TRUE(lock.try_lock());
+    std::thread([&] { EXPECT_FALSE(lock.try_lock()); }).join();
+    lock.unlock();
+    EXPECT_TRUE(lock.try_lock());
+    lock.unlock();
+}
+
+TYPED_TEST(LockTest, ProvidesMutualExclusion)
+{
+    constexpr int kThreads    = 4;
+    constexpr int kIterations = 20'000;
+
+    TypeParam lock;
+    // 非原子的读改写，锁失效时会丢失更新
+    u64 counter = 0;
+    int inside  = 0;
+    std::atomic<bool> overlapped{false};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t)
+    {
+        threads.emplace_back([&]
+        {
+            for (int i = 0; i < kIterations; ++i)
+            {
+                std::lock_guard guard(lock);
+                if (++inside != 1)
+                    overlapped = true;
+                ++counter;
+                --inside;
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_FALSE(overlapped.load());
+    EXPECT_EQ(counter, u64{kThreads} * kIterations);
+}
+
+TEST(SeqLockTest, ReadersNeverSeeTornWrites)
+{
+    struct Pose
+    {
+        i64 x;
+        i64 y;
+        i64 z;
+        i64 checksum;
+    };
+
+    SeqLock<Pose> pose(Pose{0, 0, 0, 0});
+    std::atomic<bool> stop{false};
+    std::atomic<int> torn{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r)
+    {
+        readers.emplace_back([&]
+        {
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                const auto p = pose.load();
+                if (p.x + p.y + p.z != p.checksum)
+                    torn.fetch_add(1);
+            }
+        });
+    }
+
+    // 两个写者并发写入
+    std::vector<std::thread> writers;
+    for (int w = 0; w < 2; ++w)
+    {
+        writers.emplace_back([&, w]
+        {
+            for (i64 i = 1; i <= 20'000; ++i)
+                pose.store(Pose{i, i * 3 + w, -i, i + i * 3 + w - i});
+        });
+    }
+    for (auto& writer : writers)
+        writer.join();
+    stop = true;
+    for (auto& reader : readers)
+        reader.join();
+
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_EQ(pose.getVersion(), 1u + 40'000u);
+    EXPECT_EQ(pose.load().x, 20'000);
+}
+
+TEST(LatchTest, ReleasesWaitersWhenCountReachesZero)
+{
+    Latch ready(3);
+    EXPECT_FALSE(ready.tryWait());
+
+    std::atomic<int> arrived{0};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 3; ++i)
+    {
+        threads.emplace_back([&]
+        {
+            arrived.fetch_add(1);
+            ready.arriveAndWait();
+            // 所有线程都到达后才会返回
+            EXPECT_EQ(arrived.load(), 3);
+        });
+    }
+    ready.wait();
+    EXPECT_TRUE(ready.tryWait());
+    for (auto& thread : threads)
+        thread.join();
+}
+
+TEST(BarrierTest, SynchronizesRepeatedPhases)
+{
+    constexpr int kThreads = 4;
+    constexpr int kPhases  = 200;
+
+    Barrier barrier(kThreads);
+    std::array<std::atomic<int>, kPhases> counts{};
+    std::atomic<bool> mismatch{false};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t)
+    {
+        threads.emplace_back([&]
+        {
+            for (int phase = 0; phase < kPhases; ++phase)
+            {
+                counts[phase].fetch_add(1);
+                if (barrier.arriveAndWait() != As<u32>(phase))
+                    mismatch = true;
+                // 屏障之后本轮的计数已经完整
+                if (counts[phase].load() != kThreads)
+                    mismatch = true;
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_FALSE(mismatch.load());
+    EXPECT_EQ(barrier.getGeneration(), As<u32>(kPhases));
+}
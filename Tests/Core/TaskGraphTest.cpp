@@ -0,0 +1,153 @@
+/**
+ * @File TaskGraphTest.cpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/9/28
+ * @Brief 任务图的单元测试
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "Core/Base/Error.hpp"
+#include "Core/Threading/JobSystem.hpp"
+#include "Core/Threading/TaskGraph.hpp"
+
+using namespace xihe;
+
+namespace {
+// 记录节点完成顺序
+struct Trace
+{
+    std::mutex mutex;
+    std::vector<TaskGraph::NodeId> order;
+
+    auto record(TaskGraph::NodeId id)
+    {
+        return [this, id]
+        {
+            std::lock_guard lock(mutex);
+            order.push_back(id);
+        };
+    }
+
+    Size positionOf(TaskGraph::NodeId id) const
+    {
+        return std::ranges::find(order, id) - order.begin();
+    }
+};
+} // namespace
+
+TEST(TaskGraphTest, ResourceDependenciesFollowDeclarationOrder)
+{
+    constexpr auto kTransforms = TaskGraph::MakeResource("Transforms");
+    constexpr auto kBounds     = TaskGraph::MakeResource("Bounds");
+
+    TaskGraph graph;
+    const auto animate = graph.addNode({.name = "Animate", .writes = {kTransforms}});
+    const auto physics = graph.addNode({.name = "Physics", .reads = {kTransforms}});
+    const auto culling = graph.addNode({.name = "Culling", .reads = {kTransforms}, .writes = {kBounds}});
+    const auto rewrite = graph.addNode({.name = "Rewrite", .writes = {kTransforms}});
+    graph.compile();
+
+    // 读依赖上一个写，写依赖上一个写及其后的所有读
+    EXPECT_EQ(graph.getSuccessors(animate).size(), 3u);
+    EXPECT_EQ(graph.getSuccessors(physics), std::vector<TaskGraph::NodeId>{rewrite});
+    EXPECT_EQ(graph.getSuccessors(culling), std::vector<TaskGraph::NodeId>{rewrite});
+    EXPECT_TRUE(graph.getSuccessors(rewrite).empty());
+    EXPECT_EQ(graph.getTopologicalOrder().front(), animate);
+    EXPECT_EQ(graph.getTopologicalOrder().back(), rewrite);
+}
+
+TEST(TaskGraphTest, RunRespectsDependenciesRepeatedly)
+{
+    JobSystem jobs(JobSystem::Config{.workerCount = 3});
+    TaskGraph graph;
+    Trace trace;
+
+    // 菱形：a -> (b, c) -> d，外加与之无关的 e
+    const auto a = graph.addNode("a", trace.record(0));
+    const auto b = graph.addNode("b", trace.record(1));
+    const auto c = graph.addNode("c", trace.record(2));
+    const auto d = graph.addNode("d", trace.record(3));
+    graph.addNode("e", trace.record(4));
+    graph.addEdge(a, b);
+    graph.addEdge(a, c);
+    graph.addEdge(b, d);
+    graph.addEdge(c, d);
+
+    for (int frame = 0; frame < 50; ++frame)
+    {
+        trace.order.clear();
+        graph.run(jobs);
+        ASSERT_EQ(trace.order.size(), 5u);
+        EXPECT_LT(trace.positionOf(a), trace.positionOf(b));
+        EXPECT_LT(trace.positionOf(a), trace.positionOf(c));
+        EXPECT_LT(trace.positionOf(b), trace.positionOf(d));
+        EXPECT_LT(trace.positionOf(c), trace.positionOf(d));
+    }
+    EXPECT_TRUE(graph.isCompiled());
+}
+
+TEST(TaskGraphTest, CriticalPathRunsFirst)
+{
+    // 没有工作线程时执行顺序确定
+    JobSystem jobs(JobSystem::Config{.workerCount = 0});
+    TaskGraph graph;
+    Trace trace;
+
+    graph.addNode({.name = "Short", .func = trace.record(0), .cost = 2});
+    const auto head      = graph.addNode({.name = "Head", .func = trace.record(1), .cost = 1});
+    const auto tail      = graph.addNode({.name = "Tail", .func = trace.record(2), .cost = 10});
+    graph.addEdge(head, tail);
+    graph.compile();
+
+    EXPECT_EQ(graph.getCriticalPathCost(), 11u);
+
+    graph.run(jobs);
+    EXPECT_EQ(trace.order, (std::vector<TaskGraph::NodeId>{1, 2, 0}));
+}
+
+TEST(TaskGraphTest, WideGraphUsesWorkers)
+{
+    JobSystem jobs(JobSystem::Config{.workerCount = 3});
+    TaskGraph graph;
+
+    // 扇出后汇合
+    std::atomic<int> count{0};
+    std::atomic<int> seenBySink{-1};
+    const auto source = graph.addNode("Source", {});
+    const auto sink   = graph.addNode("Sink", [&] { seenBySink = count.load(); });
+    for (int i = 0; i < 256; ++i)
+    {
+        const auto node = graph.addNode("Leaf", [&] { count.fetch_add(1); });
+        graph.addEdge(source, node);
+        graph.addEdge(node, sink);
+    }
+
+    graph.run(jobs);
+    EXPECT_EQ(count.load(), 256);
+    EXPECT_EQ(seenBySink.load(), 256);
+}
+
+TEST(TaskGraphTest, CycleAndInvalidEdgesThrow)
+{
+    TaskGraph graph;
+    const auto a = graph.addNode("a", {});
+    const auto b = graph.addNode("b", {});
+    graph.addEdge(a, b);
+    graph.addEdge(b, a);
+
+    EXPECT_THROW(graph.compile(), Exception);
+    EXPECT_FALSE(graph.isCompiled());
+    EXPECT_THROW(graph.addEdge(a, 42), Exception);
+    EXPECT_THROW(graph.addEdge(a, a), Exception);
+
+    graph.clear();
+    EXPECT_TRUE(graph.empty());
+    graph.compile();
+    EXPECT_EQ(graph.getCriticalPathCost(), 0u);
+}
@@ -0,0 +1,173 @@
+/**
+ * @File TaskTest.cpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/10/1
+ * @Brief 协程任务的单元测试
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Core/Threading/Task.hpp"
+
+using namespace xihe;
+
+namespace {
+Task<int> Value(int value)
+{
+    co_return value;
+}
+
+Task<int> AddAsync(JobSystem& jobs, int a, int b)
+{
+    co_await ScheduleOn(jobs);
+    const int x = co_await Value(a);
+    const int y = co_await Value(b);
+    co_return x + y;
+}
+
+Task<std::string> Concat(JobSystem& jobs, std::string a, std::string b)
+{
+    co_await ScheduleOn(jobs);
+    co_return a + b;
+}
+
+Task<void> Fail(JobSystem& jobs)
+{
+    co_await ScheduleOn(jobs);
+    throw std::runtime_error("load failed");
+}
+} // namespace
+
+TEST(TaskTest, IsLazyAndChainsResults)
+{
+    JobSystem jobs(JobSystem::Config{.workerCount = 2});
+
+    bool started = false;
+    auto task    = [&]() -> Task<int>
+    {
+        started = true;
+        co_return co_await AddAsync(jobs, 20, 22);
+    }();
+
+    // 创建后不执行，直到被等待
+    EXPECT_FALSE(started);
+    EXPECT_FALSE(task.isReady());
+
+    EXPECT_EQ(SyncWait(jobs, task), 42);
+    EXPECT_TRUE(started);
+    EXPECT_TRUE(task.isReady());
+}
+
+TEST(TaskTest, ScheduleOnJobSystemRunsOnPoolThread)
+{
+    JobSystem jobs(JobSystem::Config{.workerCount = 2});
+
+    auto task = [&]() -> Task<bool>
+    {
+        co_await ScheduleOn(jobs);
+        co_return jobs.isOwnThread();
+    };
+    EXPECT_TRUE(SyncWait(jobs, task()));
+
+    // 没有工作线程时，SyncWait 所在线程执行提交的任务
+    JobSystem serial(JobSystem::Config{.workerCount = 0});
+    EXPECT_EQ(SyncWait(serial, AddAsync(serial, 1, 2)), 3);
+}
+
+TEST(TaskTest, ScheduleOnExecutorResumesInRunPending)
+{
+    JobSystem jobs(JobSystem::Config{.workerCount = 1});
+    ManualExecutor mainThread;
+
+    std::atomic<int> stage{0};
+    std::thread::id resumedOn;
+    StartDetached([&]() -> Task<void>
+    {
+        stage = 1;
+        co_await ScheduleOn(mainThread);
+        resumedOn = std::this_thread::get_id();
+        stage     = 2;
+    }());
+
+    EXPECT_EQ(stage.load(), 1);
+    EXPECT_EQ(mainThread.pendingCount(), 1u);
+    EXPECT_EQ(mainThread.runPending(), 1u);
+    EXPECT_EQ(stage.load(), 2);
+    EXPECT_EQ(resumedOn, std::this_thread::get_id());
+}
+
+TEST(TaskTest, WhenAllCollectsResultsInOrder)
+{
+    JobSystem jobs(JobSystem::Config{.workerCount = 3});
+
+    auto [sum, text, unit] = SyncWait(jobs, WhenAll(AddAsync(jobs, 1, 2), Concat(jobs, "Xi", "he"),
+                                                   [&]() -> Task<void> { co_await ScheduleOn(jobs); }()));
+    EXPECT_EQ(sum, 3);
+    EXPECT_EQ(text, "Xihe");
+    (void)unit;
+
+    std::vector<Task<int>> tasks;
+    for (int i = 0; i < 100; ++i)
+        tasks.push_back(AddAsync(jobs, i, i));
+    const auto results = SyncWait(jobs, WhenAll(std::move(tasks)));
+    ASSERT_EQ(results.size(), 100u);
+    for (int i = 0; i < 100; ++i)
+        EXPECT_EQ(results[i], 2 * i);
+
+    // 空集合立即完成
+    EXPECT_TRUE(SyncWait(jobs, WhenAll(std::vector<Task<int>>{})).empty());
+}
+
+TEST(TaskTest, ExceptionsPropagateThroughAwait)
+{
+    JobSystem jobs(JobSystem::Config{.workerCount = 2});
+
+    EXPECT_THROW(SyncWait(jobs, Fail(jobs)), std::runtime_error);
+
+    auto caught = [&]() -> Task<bool>
+    {
+        try
+        {
+            co_await Fail(jobs);
+        }
+        catch (const std::runtime_error&)
+        {
+            co_return true;
+        }
+        co_return false;
+    };
+    EXPECT_TRUE(SyncWait(jobs, caught()));
+
+    // WhenAll 等所有子任务结束后再抛出
+    std::atomic<bool> otherFinished{false};
+    auto other = [&]() -> Task<void>
+    {
+        co_await ScheduleOn(jobs);
+        otherFinished = true;
+    };
+    EXPECT_THROW(SyncWait(jobs, WhenAll(Fail(jobs), other())), std::runtime_error);
+    EXPECT_TRUE(otherFinished.load());
+}
+
+TEST(TaskTest, DeepSynchronousChainDoesNotOverflow)
+{
+    JobSystem jobs(JobSystem::Config{.workerCount = 0});
+
+    // 同步完成的任务通过对称转移恢复等待者，不会随深度增长占用栈
+    struct Chain
+    {
+        static Task<int> Run(int depth)
+        {
+            if (depth == 0)
+                co_return 0;
+            co_return 1 + co_await Run(depth - 1);
+        }
+    };
+    EXPECT_EQ(SyncWait(jobs, Chain::Run(10'000)), 10'000);
+}
@@ -0,0 +1,112 @@
+/**
+ * @File ThreadsTest.cpp
+ * @Author dfnzhc (https://github.com/dfnzhc)
+ * @Date 2025/10/2
+ * @Brief 线程名称、亲和性与优先级的单元测试
+ */
+
+#include <gtest/gtest.h>
+
+#include <future>
+#include <string>
+#include <thread>
+
+#include "Core/Events/EventBus.hpp"
+#include "Core/Platform/Events/PlatformEvents.hpp"
+#include "Core/Threading/JobSystem.hpp"
+#include "Core/Threading/Threads.hpp"
+#include "Core/Utils/Time/TimerQueue.hpp"
+
+#ifdef XIHE_ON_LINUX
+#  include <pthread.h>
+#  include <sched.h>
+#endif
+
+using namespace xihe;
+
+TEST(ThreadsTest, NamesAreVisibleByOsThreadId)
+{
+    std::promise<u64> idPromise;
+    std::promise<void> release;
+    std::thread worker([&]
+    {
+        SetCurrentThreadName("XiheTestWorker");
+        EXPECT_EQ(GetCurrentThreadName(), "XiheTestWorker");
+
+#ifdef XIHE_ON_LINUX
+        // 系统可见的名称截断为 15 个字符
+        char name[16] = {};
+        pthread_getname_np(pthread_self(), name, sizeof(name));
+        EXPECT_STREQ(name, "XiheTestWorker");
+#endif
+
+        idPromise.set_value(GetCurrentOsThreadId());
+        release.get_future().wait();
+    });
+
+    const u64 id = idPromise.get_future().get();
+    EXPECT_NE(id, GetCurrentOsThreadId());
+    EXPECT_EQ(GetThreadName(id), "XiheTestWorker");
+
+    release.set_value();
+    worker.join();
+
+    // 线程退出后移除登记
+    EXPECT_TRUE(GetThreadName(id).empty());
+}
+
+TEST(ThreadsTest, AppliesAffinityAndPriority)
+{
+    std::thread([]
+    {
+        EXPECT_TRUE(SetCurrentThreadAffinity(0));
+
+#ifdef XIHE_ON_LINUX
+        const int cpu = sched_getcpu();
+        ASSERT_GE(cpu, 0);
+        if (cpu < 64)
+        {
+            EXPECT_TRUE(SetCurrentThreadAffinity(u64{1} << cpu));
+            cpu_set_t set;
+            pthread_getaffinity_np(pthread_self(), sizeof(set), &set);
+            EXPECT_EQ(CPU_COUNT(&set), 1);
+            EXPECT_TRUE(CPU_ISSET(cpu, &set));
+        }
+
+        // 降低优先级不需要权限；在单独的线程上进行，避免影响其他测试
+        EXPECT_TRUE(ApplyThreadOptions({.name = "XiheLowPrio", .priority = ThreadPriority::Low}));
+#endif
+    }).join();
+}
+
+TEST(ThreadsTest, EngineThreadsAreNamed)
+{
+    {
+        JobSystem jobs(JobSystem::Config{.workerCount = 1, .workerThreads = {.name = "TestJob"}});
+        std::string name;
+        JobCounter counter;
+        // 提交后立即等待，任务可能由当前线程执行，因此循环直到在工作线程上执行
+        while (name.rfind("TestJob", 0) != 0)
+        {
+            jobs.run([&] { name = GetCurrentThreadName(); }, &counter);
+            jobs.wait(counter);
+        }
+        EXPECT_EQ(name, "TestJob-0");
+    }
+
+    {
+        EventBus bus;
+        std::promise<std::string> promise;
+        auto handle = bus.subscribeAsync<AppQuitEvent>([&](const AppQuitEvent&) { promise.set_value(GetCurrentThreadName()); });
+        bus.enqueue(std::make_shared<AppQuitEvent>());
+        EXPECT_EQ(promise.get_future().get(), "XiheEvent-0");
+        bus.unsubscribe(handle);
+    }
+
+    {
+        TimerQueue queue;
+        std::promise<std::string> promise;
+        queue.scheduleOnce(Clock::now(), [&] { promise.set_value(GetCurrentThreadName()); });
+        EXPECT_EQ(promise.get_future().get(), "XiheTimer");
+    }
+}
@@ -8,11 +8,19 @@
 #include <gtest/gtest.h>
 
 #include <Core/Utils/Time/Clock.hpp>
+#include <Core/Utils/Time/FastClock.hpp>
 #include <Core/Utils/Time/Stopwatch.hpp>
 #include <Core/Utils/Time/FrameTimer.hpp>
 #include <Core/Utils/Time/FpsCounter.hpp>
 #include <Core/Utils/Time/TimeStepper.hpp>
 #include <Core/Utils/Time/TimerQueue.hpp>
+#include <Core/Utils/Time/TimingWheel.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
 
 using namespace xihe;
 
@@ -26,6 +34,73 @@ TEST(StopwatchTest, BasicStartStop)
     EXPECT_GT(e, 0.0);
 }
 
+TEST(FastClockTest, TracksSteadyClock)
+{
+    // 与 Clock 使用同一时间点类型，结果可以直接比较
+    for (int i = 0; i < 5; ++i)
+    {
+        const auto before = Clock::now();
+        const auto fast   = FastClock::now();
+        const auto after  = Clock::now();
+        EXPECT_GT(fast, before - std::chrono::microseconds(50));
+        EXPECT_LT(fast, after + std::chrono::microseconds(50));
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+}
+
+TEST(FastClockTest, MeasuresElapsedTime)
+{
+    const auto start = FastClock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    const auto elapsed = std::chrono::duration_cast<MilliSeconds>(FastClock::now() - start).count();
+    EXPECT_GE(elapsed, 19.0);
+    EXPECT_LT(elapsed, 200.0);
+}
+
+TEST(FastClockTest, MonotonicAcrossRecalibration)
+{
+    auto last = FastClock::now();
+    for (int i = 0; i < 2000; ++i)
+    {
+        FastClock::Recalibrate();
+        const auto now = FastClock::now();
+        ASSERT_GE(now, last) << "iteration " << i;
+        last = now;
+    }
+}
+
+TEST(FastClockTest, ReadersNeverGoBackwardsWhileRecalibrating)
+{
+    // 各读线程的读数单调不减，校准线程持续切换换算参数
+    std::atomic<bool> stop{false};
+    std::atomic<int> backwards{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t)
+    {
+        readers.emplace_back([&] {
+            auto last = FastClock::now();
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                const auto now = FastClock::now();
+                if (now < last)
+                    backwards.fetch_add(1, std::memory_order_relaxed);
+                last = now;
+            }
+        });
+    }
+
+    for (int i = 0; i < 500; ++i)
+    {
+        FastClock::Recalibrate();
+        std::this_thread::yield();
+    }
+    stop.store(true, std::memory_order_relaxed);
+    for (auto& reader : readers)
+        reader.join();
+
+    EXPECT_EQ(backwards.load(), 0);
+}
+
 TEST(FrameTimerTest, TickIncreases)
 {
     FrameTimer ft;
@@ -79,3 +154,160 @@ TEST(TimerQueueTest, OnceAndEvery)
     EXPECT_GE(before, 3);
     EXPECT_EQ(before, after); // 取消后不再增长
 }
+
+TEST(TimerQueueTest, CancelRemovesImmediately)
+{
+    TimerQueue q;
+    std::atomic<int> fired{0};
+    std::vector<TimerHandle> handles;
+    for (int i = 0; i < 1000; ++i)
+        handles.push_back(q.scheduleOnce(Clock::now() + std::chrono::seconds(60), [&] { fired.fetch_add(1); }));
+    EXPECT_EQ(q.pendingCount(), 1000u);
+
+    for (const auto& h : handles)
+        EXPECT_TRUE(q.cancel(h));
+    EXPECT_EQ(q.pendingCount(), 0u);
+    EXPECT_FALSE(q.cancel(handles.front())); // 重复取消
+    EXPECT_EQ(fired.load(), 0);
+}
+
+TEST(TimerQueueTest, CoalescedTimersNeverFireEarly)
+{
+    TimerQueue q(TimerQueue::Config{.resolution = std::chrono::milliseconds(20)});
+    constexpr int kTimers = 16;
+    std::atomic<int> early{0};
+    std::atomic<int> fired{0};
+
+    const auto start = Clock::now();
+    for (int i = 0; i < kTimers; ++i)
+    {
+        const auto when = start + std::chrono::milliseconds(i * 3);
+        q.scheduleOnce(when, [&, when]
+        {
+            if (Clock::now() < when)
+                early.fetch_add(1);
+            fired.fetch_add(1);
+        });
+    }
+
+    // 一个周期定时器在自己的回调中取消自己
+    std::atomic<int> periodic{0};
+    TimerHandle self;
+    std::atomic<bool> ready{false};
+    self = q.scheduleEvery(Seconds{0.001}, [&]
+    {
+        while (!ready.load())
+            std::this_thread::yield();
+        if (periodic.fetch_add(1) == 2)
+            q.cancel(self);
+    });
+    ready = true;
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_EQ(fired.load(), kTimers);
+    EXPECT_EQ(early.load(), 0);
+    EXPECT_EQ(periodic.load(), 3);
+    EXPECT_EQ(q.pendingCount(), 0u);
+}
+
+TEST(TimingWheelTest, ExpiresAtExactTickAcrossLevels)
+{
+    TimingWheel<u64> wheel;
+    const std::vector<u64> ticks{0, 1, 63, 64, 65, 4095, 4096, 4097, 262'143, 300'000, 17'000'000, (1ull << 36) + 5};
+    for (const u64 tick : ticks)
+        wheel.schedule(tick, tick);
+
+    u64 previous = 0;
+    for (const u64 tick : ticks)
+    {
+        std::vector<u64> fired;
+        auto collect = [&](u64, u64& value) -> std::optional<u64>
+        {
+            fired.push_back(value);
+            return std::nullopt;
+        };
+
+        if (tick > previous)
+        {
+            wheel.advance(tick - 1, collect);
+            EXPECT_TRUE(fired.empty()) << tick;
+        }
+        EXPECT_EQ(wheel.nextTick(), tick);
+        wheel.advance(tick, collect);
+        EXPECT_EQ(fired, std::vector<u64>{tick});
+        previous = tick + 1;
+    }
+    EXPECT_TRUE(wheel.empty());
+    EXPECT_EQ(wheel.nextTick(), std::nullopt);
+}
+
+TEST(TimingWheelTest, CancelAndRescheduleKeepHandles)
+{
+    TimingWheel<int> wheel;
+    std::vector<TimingWheel<int>::Id> ids;
+    for (int i = 0; i < 10'000; ++i)
+        ids.push_back(wheel.schedule(static_cast<u64>(i % 5000) + 1, i));
+
+    for (Size i = 0; i < ids.size(); i += 2)
+        EXPECT_TRUE(wheel.cancel(ids[i]));
+    EXPECT_EQ(wheel.size(), 5'000u);
+    EXPECT_FALSE(wheel.cancel(ids[0]));
+    EXPECT_EQ(wheel.get(ids[0]), nullptr);
+
+    // 释放的节点被复用，旧句柄不会命中新定时器
+    const auto reused = wheel.schedule(10, -1);
+    EXPECT_FALSE(wheel.cancel(ids[0]));
+    EXPECT_TRUE(wheel.reschedule(reused, 20'000));
+    EXPECT_EQ(*wheel.get(reused), -1);
+
+    int fired = 0;
+    int rearmed = 0;
+    wheel.advance(10'000, [&](u64 id, int& value) -> std::optional<u64>
+    {
+        EXPECT_NE(id, reused);
+        EXPECT_EQ(value % 2, 1);
+        ++fired;
+        if (value == 1 && rearmed++ < 3)
+            return 9'000 + rearmed; // 保留句柄重新挂入
+        return std::nullopt;
+    });
+    EXPECT_EQ(fired, 5'003);
+    EXPECT_EQ(wheel.size(), 1u);
+
+    bool last = false;
+    wheel.advance(20'000, [&](u64 id, int&) -> std::optional<u64>
+    {
+        last = id == reused;
+        return std::nullopt;
+    });
+    EXPECT_TRUE(last);
+}
+
+TEST(TimingWheelTest, NextTickIsLowerBoundOfExpiry)
+{
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<u64> dist(0, 1'000'000);
+
+    TimingWheel<u64> wheel;
+    for (int i = 0; i < 2000; ++i)
+    {
+        const u64 tick = dist(rng);
+        wheel.schedule(tick, tick);
+    }
+
+    Size total = 0;
+    while (const auto next = wheel.nextTick())
+    {
+        // 下界之前没有到期，到达下界时可能只是下放
+        if (*next > wheel.currentTick())
+            EXPECT_EQ(wheel.advance(*next - 1, [](u64, u64&) -> std::optional<u64> { return std::nullopt; }), 0u);
+
+        const u64 now = *next;
+        total += wheel.advance(now, [&](u64, u64& tick) -> std::optional<u64>
+        {
+            EXPECT_EQ(tick, now);
+            return std::nullopt;
+        });
+    }
+    EXPECT_EQ(total, 2000u);
+}